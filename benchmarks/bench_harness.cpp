@@ -0,0 +1,116 @@
+#include "bench_harness.hpp"
+#include "nanotrader/core/depth_kernels.hpp"
+#include <cmath>
+#include <cstdio>
+
+namespace nanotrader {
+namespace bench {
+
+// BenchContext
+BenchContext::BenchContext(const BenchOptions& options)
+    : options_(options) {
+    clock_.calibrate();
+}
+
+bool BenchContext::selected(const std::string& name) const {
+    return options_.filter.empty() || name.find(options_.filter) != std::string::npos;
+}
+
+void BenchContext::print_header() const {
+    std::printf("depth kernels: %s\n", depth_kernels::isa());
+    std::printf("%-44s %10s %8s %8s %8s %8s %10s\n",
+                "benchmark (ns)", "ops", "mean", "p50", "p99", "p99.9", "max");
+}
+
+void BenchContext::report(const std::string& name, const telemetry::LatencyHistogram& histogram) const {
+    auto snapshot = std::make_unique<telemetry::HistogramSnapshot>();
+    histogram.snapshot(*snapshot);
+    
+    auto ns = [this](uint64_t cycles) {
+        return static_cast<unsigned long long>(clock_.cycles_to_ns(cycles));
+    };
+    std::printf("%-44s %10llu %8llu %8llu %8llu %8llu %10llu\n", name.c_str(),
+                static_cast<unsigned long long>(snapshot->count()),
+                ns(static_cast<uint64_t>(snapshot->mean())),
+                ns(snapshot->value_at_quantile(0.50)),
+                ns(snapshot->value_at_quantile(0.99)),
+                ns(snapshot->value_at_quantile(0.999)),
+                ns(snapshot->max()));
+    std::fflush(stdout);
+}
+
+// ZipfDistribution
+ZipfDistribution::ZipfDistribution(size_t n, double exponent)
+    : cdf_(std::max<size_t>(n, 1)) {
+    double total = 0.0;
+    for (size_t k = 0; k < cdf_.size(); ++k) {
+        total += 1.0 / std::pow(static_cast<double>(k + 1), exponent);
+        cdf_[k] = total;
+    }
+    for (double& value : cdf_) {
+        value /= total;
+    }
+}
+
+// OrderFlow
+OrderFlow::OrderFlow(Symbol symbol, const FlowConfig& config, uint64_t seed)
+    : symbol_(symbol)
+    , config_(config)
+    , rng_(seed)
+    , price_rank_(config.depth, config.price_exponent)
+    , recency_rank_(RECENCY_WINDOW, config.cancel_exponent) {
+}
+
+size_t OrderFlow::pick_live() {
+    size_t back = recency_rank_(rng_) % live_.size();
+    return live_.size() - 1 - back;
+}
+
+OrderRequest OrderFlow::make_add(bool crossing) {
+    Side side = (rng_() & 1) ? Side::Buy : Side::Sell;
+    int64_t ticks = static_cast<int64_t>(price_rank_(rng_)) + 1;
+    
+    // Passive orders rest behind the mid; crossing ones reach the same distance through it
+    int64_t offset = (crossing ? ticks : -ticks) * config_.tick_raw;
+    Price price{side == Side::Buy ? config_.mid_raw + offset : config_.mid_raw - offset};
+    Quantity quantity = 1 + rng_() % config_.max_quantity;
+    
+    OrderId id = next_id_++;
+    if (!crossing) {
+        live_.push_back(id);
+    }
+    return OrderRequest(OrderRequest::Type::Add,
+                        Order(id, symbol_, price, quantity, side, OrderType::Limit, 0));
+}
+
+OrderRequest OrderFlow::next() {
+    double u = std::uniform_real_distribution<double>(0.0, 1.0)(rng_);
+    
+    if (!live_.empty() && u < config_.cancel_rate) {
+        size_t index = pick_live();
+        OrderId id = live_[index];
+        live_.erase(live_.begin() + static_cast<std::ptrdiff_t>(index));  // Near the back
+        return OrderRequest(OrderRequest::Type::Cancel,
+                            Order(id, symbol_, Price{}, 0, Side::Buy, OrderType::Limit, 0));
+    }
+    
+    if (!live_.empty() && u < config_.cancel_rate + config_.modify_rate) {
+        OrderRequest request(OrderRequest::Type::Modify,
+                             Order(live_[pick_live()], symbol_, Price{}, 0, Side::Buy, OrderType::Limit, 0));
+        request.new_quantity = 1 + rng_() % config_.max_quantity;
+        return request;
+    }
+    
+    bool crossing = std::uniform_real_distribution<double>(0.0, 1.0)(rng_) < config_.cross_rate;
+    return make_add(crossing);
+}
+
+void OrderFlow::generate(size_t count, std::vector<OrderRequest>& out) {
+    out.reserve(out.size() + count);
+    for (size_t i = 0; i < count; ++i) {
+        out.push_back(next());
+    }
+}
+
+} // namespace bench
+} // namespace nanotrader
\ No newline at end of file
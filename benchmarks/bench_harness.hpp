@@ -0,0 +1,123 @@
+#pragma once
+
+#include "nanotrader/core/engine_runner.hpp"
+#include "nanotrader/core/matching_engine.hpp"
+#include "nanotrader/core/tsc_clock.hpp"
+#include "nanotrader/telemetry/latency_histogram.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace nanotrader {
+namespace bench {
+
+struct BenchOptions {
+    std::string filter;        // Run only benchmarks whose name contains this
+    size_t ops = 200000;       // Measured operations per benchmark
+    int cpus[2] = {0, 1};      // Cores for the two sides of a ping-pong, -1 = unpinned
+    uint64_t seed = 42;
+};
+
+// Per-operation timing into a log-linear histogram (telemetry::LatencyHistogram),
+// so percentiles cost nothing to keep however many operations run
+class BenchContext {
+private:
+    BenchOptions options_;
+    TscClock clock_;
+
+public:
+    explicit BenchContext(const BenchOptions& options);
+    
+    const BenchOptions& options() const noexcept { return options_; }
+    bool selected(const std::string& name) const;
+    
+    static std::unique_ptr<telemetry::LatencyHistogram> histogram() {
+        return std::make_unique<telemetry::LatencyHistogram>();
+    }
+    
+    void print_header() const;
+    void report(const std::string& name, const telemetry::LatencyHistogram& histogram) const;
+};
+
+// Times one call in TSC cycles; the signal fences keep the compiler from moving
+// the operation outside the two counter reads
+template<typename Func>
+inline void measure(telemetry::LatencyHistogram& histogram, Func&& op) {
+    uint64_t begin = TscClock::cycles();
+    std::atomic_signal_fence(std::memory_order_seq_cst);
+    op();
+    std::atomic_signal_fence(std::memory_order_seq_cst);
+    histogram.record(TscClock::cycles() - begin);
+}
+
+// Ranks [0, n) with P(k) proportional to 1 / (k + 1)^exponent, by inverse-CDF lookup
+class ZipfDistribution {
+private:
+    std::vector<double> cdf_;
+
+public:
+    ZipfDistribution(size_t n, double exponent);
+    
+    template<typename Rng>
+    size_t operator()(Rng& rng) const {
+        double u = std::uniform_real_distribution<double>(0.0, 1.0)(rng);
+        size_t rank = static_cast<size_t>(std::lower_bound(cdf_.begin(), cdf_.end(), u) - cdf_.begin());
+        return std::min(rank, cdf_.size() - 1);
+    }
+};
+
+struct FlowConfig {
+    size_t depth = 100;            // Ticks per side that passive orders land on
+    double price_exponent = 1.2;   // Zipf skew of passive distance from the touch
+    double cancel_rate = 0.40;     // Share of messages cancelling a resting order
+    double modify_rate = 0.10;     // Share of messages resizing a resting order
+    double cross_rate = 0.0;       // Share of adds priced through the opposite touch
+    double cancel_exponent = 1.0;  // Zipf skew over resting orders, most recent first
+    Quantity max_quantity = 500;
+    int64_t mid_raw = 100000000;   // 100.00
+    int64_t tick_raw = 10000;      // Matches BookConfig::tick_size
+};
+
+// Synthetic single-symbol order flow: passive prices cluster at the touch, and
+// cancels and modifies mostly hit the newest orders, as quoting flow does. The
+// flow tracks its own adds and cancels only; orders that a crossing add fills
+// can later be cancelled again, which the engine rejects like a late cancel.
+class OrderFlow {
+private:
+    Symbol symbol_;
+    FlowConfig config_;
+    std::mt19937_64 rng_;
+    ZipfDistribution price_rank_;
+    ZipfDistribution recency_rank_;
+    std::vector<OrderId> live_;  // Oldest first
+    OrderId next_id_{1};
+    
+    size_t pick_live();
+    OrderRequest make_add(bool crossing);
+
+public:
+    static constexpr size_t RECENCY_WINDOW = 4096;
+    
+    OrderFlow(Symbol symbol, const FlowConfig& config, uint64_t seed);
+    
+    OrderRequest next();
+    OrderRequest passive_add() { return make_add(false); }
+    
+    void generate(size_t count, std::vector<OrderRequest>& out);
+    size_t live_count() const noexcept { return live_.size(); }
+};
+
+// Suites, one per translation unit
+void run_timer_benchmarks(BenchContext& context);
+void run_order_book_benchmarks(BenchContext& context);
+void run_matching_benchmarks(BenchContext& context);
+void run_ring_benchmarks(BenchContext& context);
+void run_pool_benchmarks(BenchContext& context);
+
+} // namespace bench
+} // namespace nanotrader
\ No newline at end of file
@@ -0,0 +1,87 @@
+#include "bench_harness.hpp"
+
+namespace nanotrader {
+namespace bench {
+
+namespace {
+
+constexpr int64_t MID_RAW = 100000000;
+constexpr int64_t TICK_RAW = 10000;
+constexpr size_t ORDERS_PER_LEVEL = 4;
+constexpr Quantity LOT = 100;
+
+// One aggressive buy through exactly `levels` ask levels of ORDERS_PER_LEVEL
+// makers each, through MatchingEngine::apply(); the asks are rebuilt between
+// sweeps outside the timed region
+void run_sweep(BenchContext& context, size_t levels) {
+    std::string name = "engine/sweep/levels=" + std::to_string(levels);
+    if (!context.selected(name)) {
+        return;
+    }
+    
+    auto engine = std::make_unique<MatchingEngine>();
+    engine->register_symbol(1);
+    
+    OrderId next_id = 1;
+    auto histogram = BenchContext::histogram();
+    size_t sweeps = std::max<size_t>(context.options().ops / (levels * ORDERS_PER_LEVEL), 1000);
+    
+    for (size_t sweep = 0; sweep < sweeps; ++sweep) {
+        for (size_t level = 1; level <= levels; ++level) {
+            Price price{MID_RAW + static_cast<int64_t>(level) * TICK_RAW};
+            for (size_t i = 0; i < ORDERS_PER_LEVEL; ++i) {
+                engine->apply(OrderRequest(OrderRequest::Type::Add,
+                    Order(next_id++, 1, price, LOT, Side::Sell, OrderType::Limit, 0)));
+            }
+        }
+        
+        Price limit{MID_RAW + static_cast<int64_t>(levels) * TICK_RAW};
+        OrderRequest taker(OrderRequest::Type::Add,
+            Order(next_id++, 1, limit, levels * ORDERS_PER_LEVEL * LOT, Side::Buy, OrderType::Limit, 0));
+        measure(*histogram, [&] { engine->apply(taker); });
+    }
+    
+    context.report(name, *histogram);
+}
+
+// Mixed Zipf flow in which a share of the adds cross, timed per message
+void run_flow(BenchContext& context, double cross_rate) {
+    std::string name = "engine/flow/cross=" + std::to_string(static_cast<int>(cross_rate * 100)) + "%";
+    if (!context.selected(name)) {
+        return;
+    }
+    
+    auto engine = std::make_unique<MatchingEngine>();
+    engine->register_symbol(1);
+    
+    FlowConfig config;
+    config.cross_rate = cross_rate;
+    OrderFlow flow(1, config, context.options().seed);
+    for (size_t i = 0; i < config.depth * 8; ++i) {
+        engine->apply(flow.passive_add());
+    }
+    
+    std::vector<OrderRequest> requests;
+    flow.generate(context.options().ops, requests);
+    
+    auto histogram = BenchContext::histogram();
+    for (const OrderRequest& request : requests) {
+        measure(*histogram, [&] { engine->apply(request); });
+    }
+    
+    context.report(name, *histogram);
+}
+
+} // namespace
+
+void run_matching_benchmarks(BenchContext& context) {
+    for (size_t levels : {1, 4, 16}) {
+        run_sweep(context, levels);
+    }
+    for (double cross_rate : {0.05, 0.20}) {
+        run_flow(context, cross_rate);
+    }
+}
+
+} // namespace bench
+} // namespace nanotrader
\ No newline at end of file
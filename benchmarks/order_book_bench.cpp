@@ -0,0 +1,135 @@
+#include "bench_harness.hpp"
+#include "nanotrader/core/order_book.hpp"
+#include "nanotrader/memory/pool_allocator.hpp"
+#include <cstdio>
+
+namespace nanotrader {
+namespace bench {
+
+namespace {
+
+// Add/cancel/modify straight against one book, no matching: a steady Zipf flow
+// over a book seeded with depth * 8 resting orders, timed per operation type
+void run_book_flow(BenchContext& context, BookConfig::Backend backend, size_t depth) {
+    const char* backend_name = backend == BookConfig::Backend::Ladder ? "ladder" : "hash";
+    std::string prefix = std::string("order_book/") + backend_name + "/depth=" + std::to_string(depth);
+    if (!context.selected(prefix)) {
+        return;
+    }
+    
+    PoolAllocator<Order, SingleThreaded> orders(context.options().ops + depth * 16);
+    BookConfig config;
+    config.backend = backend;
+    OrderBook book(1, config);  // Leaves before the pool it points into
+    
+    FlowConfig flow_config;
+    flow_config.depth = depth;
+    flow_config.cancel_rate = 0.45;
+    flow_config.modify_rate = 0.10;
+    OrderFlow flow(1, flow_config, context.options().seed);
+    
+    for (size_t i = 0; i < depth * 8; ++i) {
+        book.add_order(orders.construct(flow.passive_add().order));
+    }
+    
+    std::vector<OrderRequest> requests;
+    flow.generate(context.options().ops, requests);
+    
+    auto add = BenchContext::histogram();
+    auto cancel = BenchContext::histogram();
+    auto modify = BenchContext::histogram();
+    
+    for (const OrderRequest& request : requests) {
+        switch (request.type) {
+            case OrderRequest::Type::Add: {
+                Order* order = orders.construct(request.order);
+                measure(*add, [&] { book.add_order(order); });
+                break;
+            }
+            case OrderRequest::Type::Cancel: {
+                Order* order = nullptr;
+                measure(*cancel, [&] {
+                    order = book.get_order(request.order.id);
+                    book.unlink_order(order);
+                });
+                orders.destroy(order);
+                break;
+            }
+            case OrderRequest::Type::Modify:
+                // Same priority rule as the engine: shrink in place, grow at the back
+                measure(*modify, [&] {
+                    Order* order = book.get_order(request.order.id);
+                    Quantity old_quantity = order->remaining_quantity;
+                    bool grows = request.new_quantity > old_quantity;
+                    if (grows) {
+                        book.unlink_order(order);
+                    }
+                    order->remaining_quantity = request.new_quantity;
+                    order->quantity = request.new_quantity;
+                    if (grows) {
+                        book.add_order(order);
+                    } else {
+                        book.update_order_quantity(order->id, old_quantity);
+                    }
+                });
+                break;
+            case OrderRequest::Type::Replace:
+                break;  // OrderFlow only generates quantity modifies
+        }
+    }
+    
+    context.report(prefix + "/add", *add);
+    context.report(prefix + "/cancel", *cancel);
+    context.report(prefix + "/modify", *modify);
+}
+
+// Allocation-free depth queries over a book seeded with depth * 8 resting orders
+void run_depth_queries(BenchContext& context, BookConfig::Backend backend, size_t depth) {
+    const char* backend_name = backend == BookConfig::Backend::Ladder ? "ladder" : "hash";
+    std::string prefix = std::string("order_book/") + backend_name + "/depth=" + std::to_string(depth);
+    if (!context.selected(prefix)) {
+        return;
+    }
+    
+    PoolAllocator<Order, SingleThreaded> orders(depth * 8);
+    BookConfig config;
+    config.backend = backend;
+    OrderBook book(1, config);
+    
+    FlowConfig flow_config;
+    flow_config.depth = depth;
+    OrderFlow flow(1, flow_config, context.options().seed);
+    for (size_t i = 0; i < depth * 8; ++i) {
+        book.add_order(orders.construct(flow.passive_add().order));
+    }
+    
+    std::vector<Quantity> cumulative(depth);
+    Price far_ask{flow_config.mid_raw + static_cast<int64_t>(depth) * flow_config.tick_raw};
+    auto prefix_sums = BenchContext::histogram();
+    auto available = BenchContext::histogram();
+    Quantity sink = 0;
+    for (size_t i = 0; i < context.options().ops / 10; ++i) {
+        measure(*prefix_sums, [&] { sink += book.get_cumulative_depth(Side::Buy, depth, cumulative.data()); });
+        measure(*available, [&] { sink += book.get_available_quantity(Side::Sell, far_ask); });
+    }
+    
+    context.report(prefix + "/depth_sum", *prefix_sums);
+    context.report(prefix + "/available", *available);
+    if (sink == 0) {
+        std::printf("(empty book)\n");
+    }
+}
+
+} // namespace
+
+void run_order_book_benchmarks(BenchContext& context) {
+    for (auto backend : {BookConfig::Backend::HashMap, BookConfig::Backend::Ladder}) {
+        for (size_t depth : {10, 100, 1000}) {
+            run_book_flow(context, backend, depth);
+            run_depth_queries(context, backend, depth);
+        }
+    }
+}
+
+} // namespace bench
+} // namespace nanotrader
\ No newline at end of file
@@ -0,0 +1,65 @@
+#include "bench_harness.hpp"
+#include "nanotrader/memory/pool_allocator.hpp"
+
+namespace nanotrader {
+namespace bench {
+
+namespace {
+
+constexpr size_t LIVE_ORDERS = 100000;
+
+struct MallocOrders {
+    Order* construct(const Order& order) { return new Order(order); }
+    void destroy(Order* order) { delete order; }
+};
+
+// Churn at a steady LIVE_ORDERS population: each step frees a random live order
+// and allocates a replacement, so free lists and heap bins are well shuffled
+template<typename Allocator>
+void run_churn(BenchContext& context, const std::string& name, Allocator& allocator) {
+    if (!context.selected(name)) {
+        return;
+    }
+    
+    std::mt19937_64 rng(context.options().seed);
+    Order prototype(1, 1, Price(100.0), 100, Side::Buy, OrderType::Limit, 0);
+    std::vector<Order*> live(LIVE_ORDERS);
+    for (Order*& order : live) {
+        order = allocator.construct(prototype);
+    }
+    
+    auto allocate = BenchContext::histogram();
+    auto free = BenchContext::histogram();
+    for (size_t i = 0; i < context.options().ops; ++i) {
+        Order*& slot = live[rng() % LIVE_ORDERS];
+        measure(*free, [&] { allocator.destroy(slot); });
+        measure(*allocate, [&] { slot = allocator.construct(prototype); });
+    }
+    
+    for (Order* order : live) {
+        allocator.destroy(order);
+    }
+    
+    context.report(name + "/allocate", *allocate);
+    context.report(name + "/free", *free);
+}
+
+} // namespace
+
+void run_pool_benchmarks(BenchContext& context) {
+    {
+        PoolAllocator<Order, SingleThreaded> pool(LIVE_ORDERS * 2);
+        run_churn(context, "alloc/pool_single_threaded", pool);
+    }
+    {
+        PoolAllocator<Order, MultiThreaded> pool(LIVE_ORDERS * 2);
+        run_churn(context, "alloc/pool_multi_threaded", pool);
+    }
+    {
+        MallocOrders heap;
+        run_churn(context, "alloc/malloc", heap);
+    }
+}
+
+} // namespace bench
+} // namespace nanotrader
\ No newline at end of file
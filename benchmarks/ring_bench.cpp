@@ -0,0 +1,81 @@
+#include "bench_harness.hpp"
+#include "nanotrader/memory/ring_buffer.hpp"
+#include <cstdio>
+#include <thread>
+
+namespace nanotrader {
+namespace bench {
+
+namespace {
+
+constexpr uint64_t STOP = ~uint64_t{0};
+constexpr size_t RING_SIZE = 1024;
+
+// Round trip of one message: the caller (pinned to the first core by main) pushes
+// into `ping`, an echo thread on the second core pops it and pushes it into
+// `pong`. Both sides spin, so each hop is one cache-line handoff between cores.
+template<typename PingRing, typename PongRing, typename Push>
+void ping_pong(BenchContext& context, const std::string& name, PingRing& ping, PongRing& pong, Push push) {
+    std::thread echo([&] {
+        pin_thread_to_cpu(context.options().cpus[1]);
+        uint64_t value;
+        for (;;) {
+            if (!ping.try_pop(value)) {
+                continue;
+            }
+            while (!pong.try_push(value)) {
+            }
+            if (value == STOP) {
+                return;
+            }
+        }
+    });
+    
+    auto histogram = BenchContext::histogram();
+    uint64_t value;
+    size_t warmup = context.options().ops / 10;
+    for (size_t i = 0; i < warmup + context.options().ops; ++i) {
+        uint64_t begin = TscClock::cycles();
+        while (!push(ping, i)) {
+        }
+        while (!pong.try_pop(value)) {
+        }
+        if (i >= warmup) {
+            histogram->record(TscClock::cycles() - begin);
+        }
+    }
+    
+    while (!push(ping, STOP)) {
+    }
+    while (!pong.try_pop(value) || value != STOP) {
+    }
+    echo.join();
+    
+    context.report(name, *histogram);
+}
+
+} // namespace
+
+void run_ring_benchmarks(BenchContext& context) {
+    if (std::thread::hardware_concurrency() < 2) {
+        std::printf("ring/*: skipped, ping-pong needs two cores\n");
+        return;
+    }
+    
+    if (context.selected("ring/spsc/round_trip")) {
+        auto ping = std::make_unique<SPSCRingBuffer<uint64_t, RING_SIZE>>();
+        auto pong = std::make_unique<SPSCRingBuffer<uint64_t, RING_SIZE>>();
+        ping_pong(context, "ring/spsc/round_trip", *ping, *pong,
+                  [](auto& ring, uint64_t value) { return ring.try_push(value); });
+    }
+    
+    if (context.selected("ring/mpsc/round_trip")) {
+        auto ping = std::make_unique<MPSCRingBuffer<uint64_t>>(RING_SIZE);
+        auto pong = std::make_unique<SPSCRingBuffer<uint64_t, RING_SIZE>>();
+        ping_pong(context, "ring/mpsc/round_trip", *ping, *pong,
+                  [](auto& ring, uint64_t value) { return ring.push(value); });
+    }
+}
+
+} // namespace bench
+} // namespace nanotrader
\ No newline at end of file
@@ -0,0 +1,19 @@
+#pragma once
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
+
+namespace nanotrader {
+
+// Spin-wait hint: frees pipeline resources for the sibling hyperthread and
+// avoids the memory-order flush when the awaited line finally changes
+inline void cpu_relax() noexcept {
+#if defined(__x86_64__) || defined(__i386__)
+    _mm_pause();
+#elif defined(__aarch64__)
+    asm volatile("yield");
+#endif
+}
+
+} // namespace nanotrader
\ No newline at end of file
@@ -0,0 +1,28 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace nanotrader {
+
+// Vector kernels behind the OrderBook depth queries. The instruction set is
+// picked at compile time (AVX-512F, AVX2, NEON, else scalar; configure with
+// -DNANOTRADER_ARCH=native to get the widest), so there is no dispatch on the
+// hot path. isa() reports which one a build got.
+// Inputs are level quantities, which are always below 2^63.
+namespace depth_kernels {
+
+// Name of the compiled-in variant, for logs and benchmark headers
+const char* isa() noexcept;
+
+// out[i] = carry + in[0] + ... + in[i]; returns out[n - 1] (carry if n == 0).
+// in and out may be the same array.
+uint64_t prefix_sum(const uint64_t* in, uint64_t* out, size_t n, uint64_t carry = 0) noexcept;
+
+// First index whose value is >= target in a non-decreasing array (a prefix sum),
+// n if there is none
+size_t first_at_least(const uint64_t* values, size_t n, uint64_t target) noexcept;
+
+} // namespace depth_kernels
+
+} // namespace nanotrader
\ No newline at end of file
@@ -0,0 +1,77 @@
+#pragma once
+
+#include "order_book.hpp"
+#include <cstddef>
+#include <cstdint>
+
+// Per-deployment engine sizing, fixed at build time. Each value can be overridden
+// with a definition of the same name (CMake cache variables NANOTRADER_*); every
+// translation unit must see the same values.
+#ifndef NANOTRADER_INPUT_RING_SIZE
+#define NANOTRADER_INPUT_RING_SIZE 8192
+#endif
+#ifndef NANOTRADER_OUTPUT_RING_SIZE
+#define NANOTRADER_OUTPUT_RING_SIZE 8192
+#endif
+#ifndef NANOTRADER_ORDER_POOL_SIZE
+#define NANOTRADER_ORDER_POOL_SIZE 1000000
+#endif
+#ifndef NANOTRADER_TRADE_SPILL_BLOCKS
+#define NANOTRADER_TRADE_SPILL_BLOCKS 256
+#endif
+
+namespace nanotrader {
+
+struct EngineConfig {
+    static constexpr size_t input_ring_size = NANOTRADER_INPUT_RING_SIZE;    // Slots, power of two
+    static constexpr size_t output_ring_size = NANOTRADER_OUTPUT_RING_SIZE;  // Slots, power of two
+    static constexpr size_t order_pool_size = NANOTRADER_ORDER_POOL_SIZE;    // Orders mapped up front
+    static constexpr size_t trade_spill_blocks = NANOTRADER_TRADE_SPILL_BLOCKS;
+    
+    static_assert(input_ring_size >= 2 && (input_ring_size & (input_ring_size - 1)) == 0,
+                  "NANOTRADER_INPUT_RING_SIZE must be a power of two");
+    static_assert(output_ring_size >= 2 && (output_ring_size & (output_ring_size - 1)) == 0,
+                  "NANOTRADER_OUTPUT_RING_SIZE must be a power of two");
+};
+
+// Book sizing per symbol class, as traits for book_config<Class>(); a class is any
+// type with the same static constexpr members. BookConfig{} presizes every book
+// like HotBook's hash tables (megabytes per book), a ThinBook costs tens of KiB.
+struct ThinBook {
+    static constexpr BookConfig::Backend backend = BookConfig::Backend::HashMap;
+    static constexpr int64_t tick_size = 10000;
+    static constexpr size_t ladder_width = 256;
+    static constexpr size_t max_ladder_width = 65536;
+    static constexpr size_t bitmap_width = 4096;
+    static constexpr size_t level_reserve = 64;
+    static constexpr size_t order_reserve = 1024;
+};
+
+struct HotBook {
+    static constexpr BookConfig::Backend backend = BookConfig::Backend::Ladder;
+    static constexpr int64_t tick_size = 10000;
+    static constexpr size_t ladder_width = 4096;
+    static constexpr size_t max_ladder_width = 262144;
+    static constexpr size_t bitmap_width = 65536;
+    static constexpr size_t level_reserve = 10000;
+    static constexpr size_t order_reserve = 100000;
+};
+
+template<typename SymbolClass>
+constexpr BookConfig book_config() noexcept {
+    static_assert(SymbolClass::tick_size > 0, "Tick size must be positive");
+    static_assert(SymbolClass::backend != BookConfig::Backend::Ladder || SymbolClass::ladder_width > 0,
+                  "A ladder book needs a width");
+    
+    BookConfig config;
+    config.backend = SymbolClass::backend;
+    config.tick_size = SymbolClass::tick_size;
+    config.ladder_width = SymbolClass::ladder_width;
+    config.max_ladder_width = SymbolClass::max_ladder_width;
+    config.bitmap_width = SymbolClass::bitmap_width;
+    config.level_reserve = SymbolClass::level_reserve;
+    config.order_reserve = SymbolClass::order_reserve;
+    return config;
+}
+
+} // namespace nanotrader
\ No newline at end of file
@@ -0,0 +1,86 @@
+#pragma once
+
+#include "matching_engine.hpp"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <thread>
+
+namespace nanotrader {
+
+// What the matching thread does after a poll finds nothing to process
+enum class IdleStrategy : uint8_t {
+    Spin,       // Pause instruction and poll again; lowest latency, burns the core
+    SpinYield,  // Spin for spin_iterations polls, then yield the core between polls
+    SpinPark    // Spin, then sleep on a futex until notify() or park_timeout
+};
+
+struct RunnerConfig {
+    int cpu = -1;                    // Core to pin the matching thread to, -1 = unpinned
+    int realtime_priority = 0;       // SCHED_FIFO priority (1-99), 0 = keep SCHED_OTHER
+    IdleStrategy idle = IdleStrategy::SpinYield;
+    uint32_t spin_iterations = 1000; // Empty polls before yielding or parking
+    std::chrono::microseconds park_timeout{1000};  // Upper bound on a missed wakeup
+    bool bind_memory = true;         // When pinned, move the engine onto the core's NUMA node
+};
+
+// Owns the matching thread of one MatchingEngine: pins it, optionally raises it
+// to SCHED_FIFO and migrates the engine's hot memory (rings, Order pool) to the
+// core's NUMA node, then loops over process_batch() until stop(). Placement is
+// best effort; the status getters report what took effect.
+class EngineRunner {
+private:
+    MatchingEngine& engine_;
+    RunnerConfig config_;
+    std::thread thread_;
+    
+    std::atomic<bool> ready_{false};
+    std::atomic<bool> pinned_{false};
+    std::atomic<bool> realtime_{false};
+    std::atomic<int> numa_node_{-1};
+    
+    // SpinPark handshake: the runner raises parked_ before its last empty check,
+    // a producer's notify() bumps wake_word_ and wakes it if it saw the flag
+    alignas(64) std::atomic<uint32_t> wake_word_{0};
+    std::atomic<bool> parked_{false};
+    
+    alignas(64) std::atomic<uint64_t> parks_{0};
+    
+    void run();
+    void setup_thread();
+    void idle(uint32_t empty_polls);
+    void park();
+
+public:
+    explicit EngineRunner(MatchingEngine& engine, const RunnerConfig& config = RunnerConfig{});
+    ~EngineRunner();
+    
+    // Starts the engine and its thread; returns once thread setup is done
+    bool start();
+    void stop();  // Stops the engine, drains accepted requests, joins
+    bool is_running() const;
+    
+    // For producers under SpinPark: call after submitting to wake a parked runner
+    // now instead of after park_timeout. One load when the runner is not parked.
+    void notify() noexcept {
+        std::atomic_thread_fence(std::memory_order_seq_cst);  // Order the ring push before the flag load
+        if (parked_.load(std::memory_order_relaxed)) {
+            wake();
+        }
+    }
+    void wake() noexcept;  // Unconditional: bumps the futex word and wakes the runner
+    
+    const RunnerConfig& get_config() const;
+    bool is_pinned() const;
+    bool is_realtime() const;
+    int get_numa_node() const;  // Node the engine memory was bound to, -1 if not bound
+    uint64_t get_park_count() const;
+    
+    EngineRunner(const EngineRunner&) = delete;
+    EngineRunner& operator=(const EngineRunner&) = delete;
+};
+
+// Pins the calling thread; false if cpu < 0 or the platform refuses
+bool pin_thread_to_cpu(int cpu);
+
+} // namespace nanotrader
\ No newline at end of file
@@ -0,0 +1,136 @@
+#pragma once
+
+#include "types.hpp"
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace nanotrader {
+
+// Two-level occupancy bitmap: one bit per tick, plus one summary bit per
+// 64-tick word. Nearest set bit above/below a position costs a couple of
+// ctz/clz instructions, with one extra summary word per 4096 ticks of gap.
+class LevelBitmap {
+private:
+    std::vector<uint64_t> words_;
+    std::vector<uint64_t> summary_;
+    size_t size_;
+
+public:
+    static constexpr size_t npos = static_cast<size_t>(-1);
+    
+    explicit LevelBitmap(size_t bits = 0) { resize(bits); }
+    
+    // Resizes and clears every bit
+    void resize(size_t bits) {
+        size_ = bits;
+        words_.assign((bits + 63) / 64, 0);
+        summary_.assign((words_.size() + 63) / 64, 0);
+    }
+    
+    void reset() noexcept {
+        std::fill(words_.begin(), words_.end(), 0);
+        std::fill(summary_.begin(), summary_.end(), 0);
+    }
+    
+    void set(size_t i) noexcept {
+        size_t w = i >> 6;
+        words_[w] |= uint64_t{1} << (i & 63);
+        summary_[w >> 6] |= uint64_t{1} << (w & 63);
+    }
+    
+    void clear(size_t i) noexcept {
+        size_t w = i >> 6;
+        words_[w] &= ~(uint64_t{1} << (i & 63));
+        if (words_[w] == 0) {
+            summary_[w >> 6] &= ~(uint64_t{1} << (w & 63));
+        }
+    }
+    
+    bool test(size_t i) const noexcept {
+        return (words_[i >> 6] >> (i & 63)) & 1;
+    }
+    
+    // Highest set bit at or below i, npos if none
+    size_t find_prev(size_t i) const noexcept {
+        if (size_ == 0) return npos;
+        if (i >= size_) i = size_ - 1;
+        
+        size_t w = i >> 6;
+        uint64_t bits = words_[w] & (~uint64_t{0} >> (63 - (i & 63)));
+        if (bits) {
+            return (w << 6) + 63 - std::countl_zero(bits);
+        }
+        
+        size_t s = w >> 6;
+        uint64_t sum = summary_[s] & ((uint64_t{1} << (w & 63)) - 1);
+        while (!sum) {
+            if (s == 0) return npos;
+            sum = summary_[--s];
+        }
+        
+        w = (s << 6) + 63 - std::countl_zero(sum);
+        return (w << 6) + 63 - std::countl_zero(words_[w]);
+    }
+    
+    // Lowest set bit at or above i, npos if none
+    size_t find_next(size_t i) const noexcept {
+        if (i >= size_) return npos;
+        
+        size_t w = i >> 6;
+        uint64_t bits = words_[w] & (~uint64_t{0} << (i & 63));
+        if (bits) {
+            return (w << 6) + std::countr_zero(bits);
+        }
+        
+        size_t s = w >> 6;
+        uint64_t sum = (w & 63) == 63 ? 0 : summary_[s] & (~uint64_t{0} << ((w & 63) + 1));
+        while (!sum) {
+            if (++s >= summary_.size()) return npos;
+            sum = summary_[s];
+        }
+        
+        w = (s << 6) + std::countr_zero(sum);
+        return (w << 6) + std::countr_zero(words_[w]);
+    }
+    
+    size_t highest() const noexcept { return find_prev(size_ ? size_ - 1 : 0); }
+    size_t lowest() const noexcept { return find_next(0); }
+    size_t size() const noexcept { return size_; }
+};
+
+// Occupancy of tick-aligned prices in a fixed window that anchors on the first
+// price it sees. Levels outside the window (or off-tick) are only counted, in
+// which case exact() is false and callers fall back to scanning the levels.
+class PriceBitmap {
+private:
+    LevelBitmap bits_;
+    int64_t tick_size_;
+    int64_t base_;
+    size_t width_;
+    size_t untracked_;
+    bool anchored_;
+    
+    bool index_of(Price price, size_t& index) const noexcept;
+
+public:
+    PriceBitmap(int64_t tick_size, size_t width);
+    
+    void mark(Price price);
+    void unmark(Price price) noexcept;
+    
+    // Drops all bits and re-centres the window; callers then mark() live levels again
+    void reanchor(Price center) noexcept;
+    
+    bool exact() const noexcept { return untracked_ == 0; }
+    
+    // Nearest occupied price at or below / at or above `from`
+    bool find_prev(Price from, Price& out) const noexcept;
+    bool find_next(Price from, Price& out) const noexcept;
+    
+    void clear() noexcept;
+};
+
+} // namespace nanotrader
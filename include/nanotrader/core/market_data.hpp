@@ -0,0 +1,151 @@
+#pragma once
+
+#include "symbol_table.hpp"
+#include "nanotrader/memory/ring_buffer.hpp"
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace nanotrader {
+
+// One entry of the level-delta feed. Every message carries the next sequence
+// number, so a consumer that sees a jump knows it missed something and waits for
+// fresh snapshots.
+struct MarketDataMessage {
+    enum class Type : uint8_t {
+        LevelUpdate,    // quantity is the level's new total; 0 = level gone
+        SnapshotBegin,  // Discard the symbol's depth; its levels follow
+        SnapshotLevel,
+        SnapshotEnd     // Symbol is complete as of this sequence
+    };
+    
+    uint64_t sequence{0};
+    Price price{};
+    Quantity quantity{0};
+    Symbol symbol{0};
+    Type type{Type::LevelUpdate};
+    Side side{Side::Buy};
+};
+
+// Level-delta publisher fed by OrderBook as PriceLevels change (the matching
+// thread is the only producer). Updates are staged, with back-to-back changes to
+// the same level folded into one message, and published to an SPSC channel with
+// one tail store per flush(), which the engine calls once per processed batch.
+// flush() also emits a snapshot of one book, round-robin, every snapshot_interval
+// updates (0 = never). When the consumer falls behind, messages are dropped rather
+// than stalling matching; their sequence numbers are skipped, and every book is
+// snapshotted again as the channel frees up. A book with more levels than the
+// whole channel holds is skipped and counted instead, so it can't stall the rest.
+class MarketDataPublisher {
+public:
+    static constexpr size_t CHANNEL_SIZE = 65536;
+    static constexpr size_t MAX_STAGED = 1024;
+    static constexpr size_t DEFAULT_SNAPSHOT_INTERVAL = 65536;
+
+private:
+    SPSCRingBuffer<MarketDataMessage, CHANNEL_SIZE> channel_;
+    std::array<MarketDataMessage, MAX_STAGED> staged_;
+    size_t staged_count_{0};
+    uint64_t next_sequence_{1};
+    
+    size_t snapshot_interval_;
+    size_t updates_since_snapshot_{0};
+    size_t next_snapshot_book_{0};   // Registration index of the next book to snapshot
+    size_t resync_remaining_{0};     // Books still owed a snapshot after a drop or request
+    bool resync_requested_{false};
+    
+    std::atomic<uint64_t> published_{0};
+    std::atomic<uint64_t> dropped_{0};
+    std::atomic<uint64_t> snapshots_{0};
+    std::atomic<uint64_t> oversized_{0};
+    
+    enum class SnapshotOutcome : uint8_t { Published, NoRoom, TooLarge };
+    SnapshotOutcome try_snapshot(const OrderBook& book);
+    
+    void stage(MarketDataMessage::Type type, Symbol symbol, Side side, Price price, Quantity quantity) noexcept {
+        if (staged_count_ == MAX_STAGED) {
+            publish_staged();
+        }
+        MarketDataMessage& message = staged_[staged_count_++];
+        message.sequence = next_sequence_++;
+        message.price = price;
+        message.quantity = quantity;
+        message.symbol = symbol;
+        message.type = type;
+        message.side = side;
+    }
+    
+    void publish_staged() noexcept;
+
+public:
+    explicit MarketDataPublisher(size_t snapshot_interval = DEFAULT_SNAPSHOT_INTERVAL);
+    
+    // Producer side (matching thread)
+    void on_level_change(Symbol symbol, Side side, Price price, Quantity total) noexcept {
+        if (staged_count_ > 0) {
+            MarketDataMessage& last = staged_[staged_count_ - 1];
+            if (last.type == MarketDataMessage::Type::LevelUpdate && last.symbol == symbol &&
+                last.side == side && last.price == price) {
+                last.quantity = total;
+                return;
+            }
+        }
+        stage(MarketDataMessage::Type::LevelUpdate, symbol, side, price, total);
+        ++updates_since_snapshot_;
+    }
+    
+    void flush(const SymbolTable& books);
+    
+    // Begin, every non-empty level, End; all or nothing. False if the channel
+    // doesn't have room for the whole book right now, or never will.
+    bool publish_snapshot(const OrderBook& book);
+    void request_resync();  // Snapshot every book again, one per flush()
+    
+    // Consumer side (one thread)
+    bool poll(MarketDataMessage& message);
+    
+    template<typename Func>
+    size_t poll_batch(Func&& func, size_t max_messages = MAX_STAGED) {
+        return channel_.try_pop_batch(std::forward<Func>(func), max_messages);
+    }
+    
+    uint64_t get_published_count() const;
+    uint64_t get_dropped_count() const;
+    uint64_t get_snapshot_count() const;
+    uint64_t get_oversized_count() const;  // Snapshots skipped: the book exceeds the channel
+    uint64_t get_last_sequence() const;  // Producer side only
+    
+    MarketDataPublisher(const MarketDataPublisher&) = delete;
+    MarketDataPublisher& operator=(const MarketDataPublisher&) = delete;
+};
+
+// Consumer-side depth rebuilt purely from the feed. A symbol is synced once a
+// complete snapshot has arrived with no sequence gap since; a gap unsyncs all.
+class MarketDepth {
+private:
+    struct Book {
+        std::map<int64_t, Quantity, std::greater<int64_t>> bids;
+        std::map<int64_t, Quantity> asks;
+        bool synced{false};
+        bool in_snapshot{false};
+    };
+    
+    std::unordered_map<Symbol, Book> books_;
+    uint64_t next_sequence_{0};  // 0 = nothing seen yet
+    uint64_t gaps_{0};
+
+public:
+    void apply(const MarketDataMessage& message);
+    
+    bool is_synced(Symbol symbol) const;
+    std::vector<std::pair<Price, Quantity>> get_levels(Symbol symbol, Side side, size_t depth) const;
+    uint64_t get_gap_count() const;
+};
+
+} // namespace nanotrader
\ No newline at end of file
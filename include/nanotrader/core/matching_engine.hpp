@@ -0,0 +1,235 @@
+#pragma once
+
+#include "engine_config.hpp"
+#include "order_book.hpp"
+#include "symbol_table.hpp"
+#include "trade_buffer.hpp"
+#include "tsc_clock.hpp"
+#include "nanotrader/memory/pool_allocator.hpp"
+#include "nanotrader/memory/ring_buffer.hpp"
+#include "nanotrader/telemetry/engine_metrics.hpp"
+#include <array>
+#include <atomic>
+#include <memory>
+#include <utility>
+
+namespace nanotrader {
+
+class Journal;
+class MarketDataPublisher;
+class TopOfBookFeed;
+class RiskStage;
+
+using AccountId = uint32_t;
+constexpr AccountId NO_ACCOUNT = ~AccountId{0};  // Unbound; no risk account table covers it
+
+// Modify and Replace amend a resting order in place (the same Order stays in use):
+// a size decrease keeps its queue position, a size increase or a new price sends
+// it to the back of its level, and a new price that crosses matches first.
+struct OrderRequest {
+    enum class Type : uint8_t { Add, Cancel, Modify, Replace };
+    
+    Type type{Type::Add};
+    AccountId account{0};   // Owner for risk checks; cancels and amends must come from the resting order's
+    uint64_t enqueue_cycles{0};  // TscClock::cycles() at submit, stamped only with profiling on
+    Order order{};          // Replace: order.price is the new price
+    Quantity new_quantity{0};  // Modify / Replace: open quantity afterwards, 0 cancels
+    
+    OrderRequest() noexcept = default;
+    OrderRequest(Type t, const Order& o) noexcept : type(t), order(o) {}
+};
+
+struct MatchResult {
+    enum class Status : uint8_t { Added, Matched, Cancelled, Modified, Rejected };
+    
+    Status status{Status::Rejected};
+    OrderId order_id{0};
+    TradeBuffer trades;
+    uint64_t ready_cycles{0};  // TscClock::cycles() when published, stamped only with profiling on
+    
+    MatchResult() = default;
+    MatchResult(Status s, OrderId id) : status(s), order_id(id) {}
+    MatchResult(Status s, OrderId id, TradeBuffer::Arena* arena) : status(s), order_id(id), trades(arena) {}
+};
+
+// What the matching thread does when a result has nowhere to go. A request is
+// only popped once its result is certain to be published, so none is ever lost.
+enum class BackpressurePolicy : uint8_t {
+    Throttle,  // Leave requests in the input ring until the output ring has room
+    Spin,      // Keep applying and wait for each free slot; needs a consumer on another thread
+    Spill      // Park results in an overflow ring, published ahead of newer ones; throttles once it is full too
+};
+
+class MatchingEngine {
+private:
+    static constexpr size_t INPUT_BUFFER_SIZE = EngineConfig::input_ring_size;
+    static constexpr size_t OUTPUT_BUFFER_SIZE = EngineConfig::output_ring_size;
+    static constexpr size_t TRADE_SPILL_BLOCKS = EngineConfig::trade_spill_blocks;
+
+public:
+    static constexpr size_t MAX_BATCH_SIZE = 256;
+    static constexpr size_t DEFAULT_BATCH_SIZE = 64;
+
+private:
+    
+    SymbolTable symbols_;              // Registered up front; unknown symbols are rejected
+    PoolAllocator<Order, SingleThreaded> order_allocator_;  // Matching thread only
+    TradeBuffer::Arena trade_arena_;   // Declared before anything holding MatchResults
+    TscClock clock_;                   // One reading per request, shared by all its trades; re-anchored per poll when due
+    SPSCRingBuffer<OrderRequest, INPUT_BUFFER_SIZE> input_buffer_;
+    SPSCRingBuffer<MatchResult, OUTPUT_BUFFER_SIZE> output_buffer_;
+    std::unique_ptr<SPSCRingBuffer<MatchResult, OUTPUT_BUFFER_SIZE>> overflow_;  // Spill only, matching thread only
+    BackpressurePolicy backpressure_{BackpressurePolicy::Throttle};
+    
+    std::atomic<bool> running_{false};
+    std::atomic<uint64_t> processed_orders_{0};
+    std::atomic<uint64_t> throttles_{0};
+    std::atomic<uint64_t> spin_waits_{0};
+    std::atomic<uint64_t> spills_{0};
+    Journal* journal_{nullptr};        // Write-ahead log of every accepted request, optional
+    MarketDataPublisher* market_data_{nullptr};  // Level-delta feed, optional
+    TopOfBookFeed* top_of_book_{nullptr};        // Seqlock top-N snapshots, optional
+    RiskStage* risk_{nullptr};                   // Pre-trade checks, optional
+    std::unique_ptr<telemetry::EngineMetrics> metrics_;  // Only allocated with profiling on
+    
+    // Staging for process_batch(): requests popped in one go, results published in one go
+    size_t batch_size_{DEFAULT_BATCH_SIZE};
+    std::array<OrderRequest, MAX_BATCH_SIZE> batch_requests_;
+    std::array<MatchResult, MAX_BATCH_SIZE> batch_results_;
+    std::array<uint16_t, MAX_BATCH_SIZE> batch_order_;
+    
+    void match_order(OrderBook* book, Order* incoming_order, TradeBuffer& trades, Timestamp match_time);
+    void match_buy_order(OrderBook* book, Order* buy_order, TradeBuffer& trades, Timestamp match_time);
+    void match_sell_order(OrderBook* book, Order* sell_order, TradeBuffer& trades, Timestamp match_time);
+    
+    // Risk check, then (if journal) the journal append for an admitted request, then the
+    // book, then (if journal) the result for the journal's results sidecar
+    MatchResult process_request(OrderBook* book, const OrderRequest& request, bool journal);
+    MatchResult execute_request(OrderBook* book, const OrderRequest& request);
+    MatchResult process_add_order(OrderBook* book, const OrderRequest& request);
+    MatchResult process_cancel_order(OrderBook* book, const OrderRequest& request);
+    MatchResult process_modify_order(OrderBook* book, const OrderRequest& request);  // Modify and Replace
+    void publish_book_snapshots();
+    void attach_book_feeds(OrderBook& book);
+    void flush_feeds();
+    size_t output_room() const;
+    void drain_overflow();
+    void publish_result(MatchResult&& result);
+    void publish_results(size_t count);
+    void record_metrics(const OrderRequest& request, MatchResult& result, uint64_t popped_cycles);
+    void record_pool_metrics();
+
+public:
+    MatchingEngine();
+    
+    // Must happen before orders for the symbol arrive (and before start()); returns
+    // nullptr if the symbol is outside the table or the table is full
+    OrderBook* register_symbol(Symbol symbol, const BookConfig& config = BookConfig{});
+    bool is_registered(Symbol symbol) const;
+    
+    // Every request popped from the input ring is appended before it is processed;
+    // with a risk stage attached, only those it admits, so replay() rebuilds the
+    // same books. Attach before start(); nullptr detaches. The engine does not own it.
+    void attach_journal(Journal* journal);
+    Journal* get_journal() const;
+    
+    // Every book reports its level changes to the publisher, which is flushed once
+    // per process_orders()/process_batch()/apply() call. Attaching publishes a
+    // snapshot of every book. Attach before start(); the engine does not own it.
+    void attach_market_data(MarketDataPublisher* publisher);
+    MarketDataPublisher* get_market_data() const;
+    
+    // Keeps a top-N snapshot of every book that other threads can read while the
+    // engine runs; refreshed at the same points as the market-data feed. Attach
+    // before start(); the engine does not own it.
+    void attach_top_of_book(TopOfBookFeed* feed);
+    TopOfBookFeed* get_top_of_book() const;
+    
+    // Every request for a registered symbol passes the risk stage before it
+    // reaches the book; a failed check returns Rejected. Attach before start()
+    // (and before recover(), to get its saved state back); the engine does not own it.
+    void attach_risk(RiskStage* risk);
+    RiskStage* get_risk() const;
+    
+    // Recovery entry points, for use while stopped. apply() runs one request through
+    // the matcher on the caller's thread, bypassing the rings and the journal;
+    // replay() does the same for a journaled request, which already passed the risk
+    // stage, so it is only recorded there; restore_order() rests an order in its
+    // (registered) book without matching.
+    MatchResult apply(const OrderRequest& request);
+    MatchResult replay(const OrderRequest& request);
+    bool restore_order(const Order& order);
+    
+    bool submit_order(const OrderRequest& request);
+    
+    // Producer-side zero-copy submit: fill(OrderRequest& slot) decodes straight into
+    // input-ring slots, returning false to stop. Same single-producer rule as submit_order().
+    template<typename Func>
+    size_t submit_in_place(size_t max_requests, Func&& fill) {
+        if constexpr (telemetry::ENABLED) {
+            // One stamp per call: a decoded burst is handed over together
+            uint64_t now = TscClock::cycles();
+            return input_buffer_.try_emplace_batch(max_requests, [&fill, now](OrderRequest& slot) {
+                if (!fill(slot)) {
+                    return false;
+                }
+                slot.enqueue_cycles = now;
+                return true;
+            });
+        } else {
+            return input_buffer_.try_emplace_batch(max_requests, std::forward<Func>(fill));
+        }
+    }
+    bool get_result(MatchResult& result);
+    bool has_pending_requests() const { return !input_buffer_.empty(); }
+    void process_orders();
+    
+    // Drains up to batch_size requests with one head store, handles them grouped by
+    // symbol (in submission order while a risk stage is attached), and publishes
+    // their results in submission order with one tail store.
+    // Returns the number of requests processed.
+    size_t process_batch();
+    void set_batch_size(size_t batch_size);
+    size_t get_batch_size() const;
+    
+    // Set while stopped; leaving Spill fails while results are still parked
+    bool set_backpressure_policy(BackpressurePolicy policy);
+    BackpressurePolicy get_backpressure_policy() const;
+    uint64_t get_throttle_count() const;   // Calls that left input queued for lack of output room
+    uint64_t get_spin_wait_count() const;  // Results that had to wait for an output slot
+    uint64_t get_spill_count() const;      // Results parked in the overflow ring
+    size_t get_spilled_results() const;    // Parked right now
+    
+    void start();
+    void stop();
+    bool is_running() const;
+    
+    uint64_t get_processed_orders() const;
+    OrderBook* get_order_book(Symbol symbol);
+    const OrderBook* get_order_book(Symbol symbol) const;
+    size_t get_order_book_count() const;
+    size_t get_total_orders() const;
+    size_t get_available_order_capacity() const;
+    const TscClock& get_clock() const;
+    
+    // Memory the matching thread touches on every request, as (address, bytes): the
+    // engine itself (rings, batch staging), the Order pool and the trade spill arena.
+    // For placement such as NUMA binding; call on the matching thread or while stopped.
+    template<typename Func>
+    void for_each_hot_region(Func&& func) const {
+        func(static_cast<const void*>(this), sizeof(*this));
+        order_allocator_.for_each_slab(func);
+        trade_arena_.for_each_slab(func);
+    }
+    
+    // Order-lifecycle latencies and counters, nullptr unless the build defines
+    // NANOTRADER_ENABLE_PROFILING. Safe to read from any thread while running.
+    const telemetry::EngineMetrics* get_metrics() const;
+    const SymbolTable& get_symbol_table() const;
+    void clear_all_books();  // Empties every book; registrations are kept
+    
+    MatchingEngine(const MatchingEngine&) = delete;
+    MatchingEngine& operator=(const MatchingEngine&) = delete;
+};
+
+} // namespace nanotrader
\ No newline at end of file
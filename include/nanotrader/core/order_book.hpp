@@ -0,0 +1,256 @@
+#pragma once
+
+#include "order.hpp"
+#include "price_level.hpp"
+#include "price_ladder.hpp"
+#include "level_bitmap.hpp"
+#include "order_index.hpp"
+#include <cstdint>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace nanotrader {
+
+class MarketDataPublisher;
+class TopOfBookFeed;
+
+// Per-book storage settings. HashMap keys levels by raw price and accepts any
+// price; Ladder stores levels in a dense tick-indexed array and rejects off-tick prices.
+struct BookConfig {
+    enum class Backend : uint8_t {
+        HashMap,
+        Ladder
+    };
+    
+    Backend backend = Backend::HashMap;
+    int64_t tick_size = 10000;   // In Price raw units (0.01)
+    size_t ladder_width = 4096;  // Initial band width in ticks, per side
+    size_t max_ladder_width = 262144;  // Widest the band may grow, per side; prices beyond it are rejected
+    size_t bitmap_width = 65536; // Occupancy window in ticks for the hash backend
+    size_t level_reserve = 10000;  // Hash backend levels presized per side
+    size_t order_reserve = 100000; // Orders the ID index is presized for
+};
+
+struct DepthSummary {
+    Quantity quantity{0};  // Over the levels visited
+    size_t levels{0};
+    Price vwap{};          // Quantity-weighted level price, zero on an empty side
+};
+
+class OrderBook {
+public:
+    using PriceLevelMap = std::unordered_map<int64_t, PriceLevel>;
+    using OrderMap = OrderIndex;
+
+private:
+    Symbol symbol_;
+    BookConfig config_;
+    bool use_ladder_;
+    
+    PriceLevelMap buy_levels_;   // Hash map by price
+    PriceLevelMap sell_levels_;  // Hash map by price
+    PriceLadder buy_ladder_;     // Dense levels when use_ladder_
+    PriceLadder sell_ladder_;
+    PriceBitmap buy_occupancy_;  // Non-empty hash levels, for best-price search
+    PriceBitmap sell_occupancy_;
+    OrderMap orders_;            // Open-addressing index, order ID -> queue node
+    QueueNodeSlabs nodes_;       // Hot halves of resting orders, linked by index
+    uint32_t free_node_{QueueNode::NIL};
+    
+    // Cached best bid/ask for O(1) access
+    Price best_bid_;
+    Price best_ask_;
+    bool has_best_bid_;
+    bool has_best_ask_;
+    
+    MarketDataPublisher* market_data_{nullptr};  // Told about every level total change
+    TopOfBookFeed* top_of_book_{nullptr};        // Marked dirty on every level total change
+    uint32_t top_of_book_slot_{0};
+    
+    void publish_level(Side side, Price price, const PriceLevel& level) noexcept;
+    PriceLevel* find_level(Side side, Price price) noexcept;
+    const PriceLevel* find_level(Side side, Price price) const noexcept;
+    PriceLevel* acquire_level(Side side, Price price) noexcept;  // nullptr if the level can't be placed
+    void mark_level_occupied(Side side, Price price);
+    void release_level(Side side, Price price) noexcept;
+    void rebuild_occupancy(PriceBitmap& occupancy, const PriceLevelMap& levels, Price center);
+    uint32_t acquire_node(Order* order) noexcept;  // NIL if the node pool can't grow
+    void release_node(uint32_t node) noexcept;
+    void detach_node(Side side, PriceLevel* level, uint32_t node) noexcept;  // Caller drops it from orders_
+    
+    void update_best_bid() noexcept;
+    void update_best_ask() noexcept;
+    void cleanup_empty_level(PriceLevelMap& levels, int64_t price_raw) noexcept;
+
+public:
+    explicit OrderBook(Symbol symbol) noexcept;
+    OrderBook(Symbol symbol, const BookConfig& config);
+    
+    bool add_order(Order* order) noexcept;
+    bool remove_order(OrderId order_id) noexcept;
+    void update_order_quantity(OrderId order_id, Quantity old_quantity) noexcept;  // After the caller set remaining_quantity
+    Order* get_order(OrderId order_id) const noexcept;
+    
+    // Level-based entry points for the matcher: it fills the front of the best
+    // level through its queue node alone, so no ID or price lookups are repeated
+    // and the maker's Order is not read.
+    PriceLevel* get_best_bid_level() noexcept;
+    PriceLevel* get_best_ask_level() noexcept;
+    const QueueNode& front(const PriceLevel& level) const noexcept { return nodes_[level.head]; }
+    
+    // Fills the front order of a non-empty level on the given side. Returns the
+    // Order once the fill completes it and it has left the book (the caller frees
+    // it; level is released if this empties it), nullptr while it keeps resting.
+    Order* fill_front(Side side, PriceLevel* level, Quantity quantity) noexcept;
+    bool unlink_order(Order* order) noexcept;
+    
+    Price get_best_bid() const noexcept;
+    Price get_best_ask() const noexcept;
+    bool has_best_bid() const noexcept;
+    bool has_best_ask() const noexcept;
+    
+    const PriceLevel* get_buy_level(Price price) const noexcept;
+    const PriceLevel* get_sell_level(Price price) const noexcept;
+    
+    Symbol get_symbol() const noexcept;
+    size_t get_order_count() const noexcept;
+    const BookConfig& get_config() const noexcept;
+    bool accepts_price(Side side, Price price) const noexcept;  // Whether add_order can rest an order at this price
+    
+    // nullptr detaches; the book does not own the publisher
+    void set_market_data(MarketDataPublisher* publisher) noexcept;
+    void set_top_of_book(TopOfBookFeed* feed, uint32_t slot) noexcept;
+    
+    std::vector<std::pair<Price, Quantity>> get_bid_levels(size_t depth) const;
+    std::vector<std::pair<Price, Quantity>> get_ask_levels(size_t depth) const;
+    
+    // Depth queries over the best levels, allocation-free like for_each_best_level;
+    // sums run through depth_kernels
+    static constexpr size_t DEPTH_BLOCK = 64;  // Levels staged per kernel call, at most
+    static constexpr size_t SCAN_BATCH = 16;   // Levels taken per map pass while the bitmap is inexact
+    
+    // out[i] = quantity over the best i + 1 levels; returns the levels written (<= depth)
+    size_t get_cumulative_depth(Side side, size_t depth, Quantity* out) const noexcept;
+    DepthSummary get_depth_summary(Side side, size_t depth) const noexcept;
+    
+    // Quantity resting on one side at limit or better (asks at or below it, bids at
+    // or above it). Counting stops at the first level that brings it to needed, so
+    // the result is >= needed exactly when an order for needed could fill.
+    Quantity get_available_quantity(Side side, Price limit, Quantity needed = UINT64_MAX) const noexcept;
+    
+    // Visits every non-empty level on one side, in no particular price order
+    template<typename Func>
+    void for_each_level(Side side, Func&& func) const {
+        if (use_ladder_) {
+            const PriceLadder& ladder = side == Side::Buy ? buy_ladder_ : sell_ladder_;
+            ladder.walk_up(0, [&func](const PriceLevel& level) {
+                func(level);
+                return true;
+            });
+            return;
+        }
+        
+        for (const auto& [price, level] : side == Side::Buy ? buy_levels_ : sell_levels_) {
+            if (!level.is_empty()) {
+                func(level);
+            }
+        }
+    }
+    
+    // Visits the orders resting at one level in time priority
+    template<typename Func>
+    void for_each_order(const PriceLevel& level, Func&& func) const {
+        for (uint32_t node = level.head; node != QueueNode::NIL; node = nodes_[node].next) {
+            func(static_cast<const Order&>(*nodes_[node].order));
+        }
+    }
+    
+    // Visits up to depth non-empty levels on one side as func(price, total),
+    // best price first, without allocating. func may return bool, false to stop
+    // early. With the hash backend's occupancy bitmap inexact, each pass over the
+    // level map takes the next SCAN_BATCH levels, so the cost is bounded by
+    // ceil(depth / SCAN_BATCH) passes.
+    template<typename Func>
+    void for_each_best_level(Side side, size_t depth, Func&& func) const {
+        bool buy = side == Side::Buy;
+        if (depth == 0 || !(buy ? has_best_bid_ : has_best_ask_)) {
+            return;
+        }
+        
+        auto call = [&func](Price level_price, Quantity quantity) {
+            if constexpr (std::is_same_v<std::invoke_result_t<Func&, Price, Quantity>, bool>) {
+                return func(level_price, quantity);
+            } else {
+                func(level_price, quantity);
+                return true;
+            }
+        };
+        
+        Price price = buy ? best_bid_ : best_ask_;
+        size_t visited = 0;
+        auto visit = [&](const PriceLevel& level) {
+            return call(level.price, level.total_quantity) && ++visited < depth;
+        };
+        
+        if (use_ladder_) {
+            const PriceLadder& ladder = buy ? buy_ladder_ : sell_ladder_;
+            if (buy) {
+                ladder.walk_down(ladder.index_of(price), visit);
+            } else {
+                ladder.walk_up(ladder.index_of(price), visit);
+            }
+            return;
+        }
+        
+        const PriceBitmap& occupancy = buy ? buy_occupancy_ : sell_occupancy_;
+        if (!occupancy.exact()) {
+            // Some levels are only in the map: pull them best-first in fixed-size batches
+            auto better = [buy](Price a, Price b) { return buy ? a > b : a < b; };
+            const PriceLevelMap& levels = buy ? buy_levels_ : sell_levels_;
+            const PriceLevel* batch[SCAN_BATCH];
+            Price bound{buy ? price.raw_value() + 1 : price.raw_value() - 1};  // Levels strictly better are done
+            for (;;) {
+                size_t count = 0;
+                for (const auto& [price_raw, level] : levels) {
+                    if (level.is_empty() || !better(bound, level.price) ||
+                        (count == SCAN_BATCH && !better(level.price, batch[SCAN_BATCH - 1]->price))) {
+                        continue;
+                    }
+                    size_t i = count < SCAN_BATCH ? count++ : SCAN_BATCH - 1;
+                    for (; i > 0 && better(level.price, batch[i - 1]->price); --i) {
+                        batch[i] = batch[i - 1];
+                    }
+                    batch[i] = &level;
+                }
+                for (size_t i = 0; i < count; ++i) {
+                    if (!visit(*batch[i])) {
+                        return;
+                    }
+                }
+                if (count < SCAN_BATCH) {
+                    return;
+                }
+                bound = batch[SCAN_BATCH - 1]->price;
+            }
+        }
+        
+        int64_t step = config_.tick_size > 0 ? config_.tick_size : 1;
+        for (;;) {
+            const PriceLevel* level = find_level(side, price);
+            if (!level || !visit(*level)) {
+                return;
+            }
+            bool found = buy ? occupancy.find_prev(Price{price.raw_value() - step}, price)
+                             : occupancy.find_next(Price{price.raw_value() + step}, price);
+            if (!found) {
+                return;
+            }
+        }
+    }
+    
+    void clear() noexcept;
+};
+
+} // namespace nanotrader
\ No newline at end of file
@@ -0,0 +1,69 @@
+#pragma once
+
+#include "order.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace nanotrader {
+
+// Open-addressing OrderId -> queue-node index table. Linear probing over a
+// power-of-two slot array (four 16-byte slots per cache line), backward-shift
+// deletion so there are no tombstones. An npos value marks an empty slot.
+class OrderIndex {
+public:
+    static constexpr uint32_t npos = UINT32_MAX;
+
+private:
+    struct Slot {
+        OrderId key;
+        uint32_t value;
+    };
+    
+    static constexpr size_t MIN_CAPACITY = 16;
+    
+    std::vector<Slot> slots_;
+    size_t mask_;
+    unsigned shift_;
+    size_t size_;
+    size_t grow_at_;
+    
+    size_t home(OrderId key) const noexcept {
+        // Fibonacci hashing: sequential IDs land far apart in the top bits
+        return static_cast<size_t>((key * 0x9E3779B97F4A7C15ull) >> shift_);
+    }
+    
+    void rehash(size_t new_capacity);
+    void erase_slot(size_t index) noexcept;
+
+public:
+    explicit OrderIndex(size_t expected = 0);
+    
+    uint32_t find(OrderId key) const noexcept {
+        for (size_t i = home(key);; i = (i + 1) & mask_) {
+            const Slot& slot = slots_[i];
+            if (slot.value == npos) return npos;
+            if (slot.key == key) return slot.value;
+        }
+    }
+    
+    bool contains(OrderId key) const noexcept { return find(key) != npos; }
+    
+    // Returns false (and leaves the table unchanged) if key is already present;
+    // value must not be npos. If growing throws, the table is also unchanged.
+    bool insert(OrderId key, uint32_t value);
+    
+    bool erase(OrderId key) noexcept;
+    
+    // Removes key and returns its value, npos if absent
+    uint32_t extract(OrderId key) noexcept;
+    
+    void reserve(size_t expected);
+    void clear() noexcept;
+    
+    size_t size() const noexcept { return size_; }
+    size_t capacity() const noexcept { return slots_.size(); }
+    bool empty() const noexcept { return size_ == 0; }
+};
+
+} // namespace nanotrader
\ No newline at end of file
@@ -0,0 +1,99 @@
+#pragma once
+
+#include "price_level.hpp"
+#include "level_bitmap.hpp"
+#include <cstdint>
+#include <vector>
+
+namespace nanotrader {
+
+// Dense, tick-indexed array of price levels for one side of a book.
+// Slot i holds the level at base + i * tick_size. The band re-centers (or
+// grows, up to max_width) when a price outside it arrives, so every live level
+// stays in the array; a price that would need a wider band is refused.
+// An occupancy bitmap alongside the slots lets walks skip empty ticks.
+class PriceLadder {
+private:
+    std::vector<PriceLevel> levels_;
+    LevelBitmap occupancy_;
+    int64_t tick_size_;
+    int64_t base_;
+    size_t max_width_;
+    bool anchored_;
+
+    // Lowest and highest of price_raw and every live level, and the ticks between them inclusive
+    size_t span_with(int64_t price_raw, int64_t& lo, int64_t& hi) const noexcept;
+    void rebuild(int64_t new_base, size_t new_width);
+    bool rebase_to_cover(int64_t price_raw) noexcept;
+
+public:
+    PriceLadder(int64_t tick_size, size_t width, size_t max_width);
+
+    bool on_tick(Price price) const noexcept {
+        return price.raw_value() % tick_size_ == 0;
+    }
+
+    bool in_band(Price price) const noexcept {
+        if (!anchored_) return false;
+        int64_t offset = price.raw_value() - base_;
+        return offset >= 0 && offset < static_cast<int64_t>(levels_.size()) * tick_size_;
+    }
+
+    size_t index_of(Price price) const noexcept {
+        return static_cast<size_t>((price.raw_value() - base_) / tick_size_);
+    }
+
+    Price price_at(size_t index) const noexcept {
+        return Price{base_ + static_cast<int64_t>(index) * tick_size_};
+    }
+
+    PriceLevel& at(size_t index) noexcept { return levels_[index]; }
+    const PriceLevel& at(size_t index) const noexcept { return levels_[index]; }
+
+    // Level slot for an in-band price, nullptr otherwise
+    PriceLevel* find(Price price) noexcept;
+    const PriceLevel* find(Price price) const noexcept;
+
+    // Whether get_or_create can place price: on-tick, and in the band or close
+    // enough to every live level that a band of max_width covers both
+    bool covers(Price price) const noexcept;
+    
+    // Level slot for price, moving the band if needed; nullptr if the ladder doesn't
+    // cover price or the larger band can't be allocated (the ladder is then unchanged)
+    PriceLevel* get_or_create(Price price) noexcept;
+
+    // Keep the occupancy bitmap in step when a slot gains its first order / loses its last
+    void mark_occupied(size_t index) noexcept { occupancy_.set(index); }
+    void mark_empty(size_t index) noexcept { occupancy_.clear(index); }
+
+    // Nearest non-empty slot at or below / at or above index, LevelBitmap::npos if none
+    size_t prev_occupied(size_t index) const noexcept { return occupancy_.find_prev(index); }
+    size_t next_occupied(size_t index) const noexcept { return occupancy_.find_next(index); }
+
+    // Walk non-empty levels starting at index, towards lower (descending) or higher prices.
+    // func(const PriceLevel&) returns false to stop.
+    template<typename Func>
+    void walk_down(size_t from, Func&& func) const {
+        for (size_t i = occupancy_.find_prev(from); i != LevelBitmap::npos;
+             i = i ? occupancy_.find_prev(i - 1) : LevelBitmap::npos) {
+            if (!func(levels_[i])) return;
+        }
+    }
+
+    template<typename Func>
+    void walk_up(size_t from, Func&& func) const {
+        for (size_t i = occupancy_.find_next(from); i != LevelBitmap::npos;
+             i = occupancy_.find_next(i + 1)) {
+            if (!func(levels_[i])) return;
+        }
+    }
+
+    int64_t tick_size() const noexcept { return tick_size_; }
+    size_t width() const noexcept { return levels_.size(); }
+    size_t max_width() const noexcept { return max_width_; }
+    Price base() const noexcept { return Price{base_}; }
+
+    void clear() noexcept;
+};
+
+} // namespace nanotrader
@@ -0,0 +1,71 @@
+#pragma once
+
+#include "order.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace nanotrader {
+
+// Hot half of a resting order: everything a fill reads or writes. Queue links are
+// indices into the owning book's node slabs, so two entries share a cache line;
+// the Order (the cold half: type, timestamps, original size) is only touched when
+// a fill leaves it partially filled or takes it off the book.
+struct QueueNode {
+    static constexpr uint32_t NIL = UINT32_MAX;
+
+    OrderId order_id;
+    Quantity remaining;  // Authoritative while resting, mirrored to order->remaining_quantity
+    Order* order;
+    uint32_t next;       // Towards the tail (later arrivals); free-list link once released
+    uint32_t prev;
+};
+
+static_assert(sizeof(QueueNode) == 32, "Two queue entries per cache line");
+
+// A book's queue nodes, in fixed-size slabs addressed as index >> SLAB_SHIFT.
+// Growing maps one more slab; nodes already handed out never move, so a large
+// book doesn't copy its whole node array on the matching thread.
+class QueueNodeSlabs {
+public:
+    static constexpr unsigned SLAB_SHIFT = 12;
+    static constexpr uint32_t SLAB_SIZE = uint32_t{1} << SLAB_SHIFT;  // 128 KB of nodes
+
+private:
+    std::vector<std::unique_ptr<QueueNode[]>> slabs_;
+    uint32_t size_{0};
+
+public:
+    QueueNode& operator[](uint32_t index) noexcept {
+        return slabs_[index >> SLAB_SHIFT][index & (SLAB_SIZE - 1)];
+    }
+    
+    const QueueNode& operator[](uint32_t index) const noexcept {
+        return slabs_[index >> SLAB_SHIFT][index & (SLAB_SIZE - 1)];
+    }
+    
+    // Appends a node and returns its index; throws bad_alloc with nothing changed
+    uint32_t emplace_back();
+    void reserve(size_t count);
+    void clear() noexcept { size_ = 0; }  // Slabs stay mapped for reuse
+    
+    uint32_t size() const noexcept { return size_; }
+};
+
+// FIFO queue of resting orders at a single price, linked through QueueNode indices
+struct PriceLevel {
+    Price price;
+    Quantity total_quantity;
+    uint32_t head;
+    uint32_t tail;
+
+    PriceLevel() noexcept;
+    explicit PriceLevel(Price p) noexcept;
+
+    void push_back(QueueNodeSlabs& nodes, uint32_t node) noexcept;
+    void unlink(QueueNodeSlabs& nodes, uint32_t node) noexcept;
+    bool is_empty() const noexcept;
+};
+
+} // namespace nanotrader
\ No newline at end of file
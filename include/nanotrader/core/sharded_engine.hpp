@@ -0,0 +1,65 @@
+#pragma once
+
+#include "engine_runner.hpp"
+#include "matching_engine.hpp"
+#include <atomic>
+#include <memory>
+#include <vector>
+
+namespace nanotrader {
+
+// Front-end over N independent MatchingEngines. Every symbol is routed to one
+// shard, so its book, Order pool and rings are only ever touched by that shard's
+// thread and throughput scales with cores. submit_order() and get_result() are
+// each meant for one thread (the gateway and the result consumer); results are
+// merged round-robin across shards and stay in submission order per symbol.
+class ShardedEngine {
+private:
+    struct Shard {
+        std::unique_ptr<MatchingEngine> engine;
+        std::unique_ptr<EngineRunner> runner;
+    };
+    
+    std::vector<Shard> shards_;
+    size_t next_result_shard_{0};
+    std::atomic<bool> running_{false};
+
+public:
+    // cpus[i] is the core shard i is pinned to; missing entries are left unpinned.
+    // Every shard's runner uses runner_config apart from its cpu.
+    explicit ShardedEngine(size_t shard_count, const std::vector<int>& cpus = {},
+                           const RunnerConfig& runner_config = RunnerConfig{});
+    ~ShardedEngine();
+    
+    // Deterministic for a given shard count, independent of submission history
+    size_t shard_for(Symbol symbol) const noexcept {
+        uint64_t hash = static_cast<uint32_t>(symbol * 0x9E3779B1u);
+        return static_cast<size_t>((hash * shards_.size()) >> 32);
+    }
+    
+    // Registers the symbol on its owning shard; call before start()
+    OrderBook* register_symbol(Symbol symbol, const BookConfig& config = BookConfig{});
+    
+    bool submit_order(const OrderRequest& request);
+    bool get_result(MatchResult& result);
+    
+    void start();
+    void stop();
+    bool is_running() const;
+    
+    size_t get_shard_count() const;
+    MatchingEngine& get_shard(size_t index);
+    const MatchingEngine& get_shard(size_t index) const;
+    EngineRunner& get_runner(size_t index);
+    
+    // Aggregates; book-level queries are only consistent while stopped
+    uint64_t get_processed_orders() const;
+    OrderBook* get_order_book(Symbol symbol);
+    size_t get_order_book_count() const;
+    size_t get_total_orders() const;
+    
+    ShardedEngine(const ShardedEngine&) = delete;
+    ShardedEngine& operator=(const ShardedEngine&) = delete;
+};
+
+} // namespace nanotrader
\ No newline at end of file
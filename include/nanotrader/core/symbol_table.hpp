@@ -0,0 +1,70 @@
+#pragma once
+
+#include "order_book.hpp"
+#include <cstddef>
+#include <vector>
+
+namespace nanotrader {
+
+// Dense Symbol -> OrderBook directory. Symbols are small integers registered up
+// front; lookup is a single indexed load and never creates a book. Books live
+// inline in a vector reserved for max_books entries, so pointers handed out stay
+// valid for the table's lifetime.
+class SymbolTable {
+private:
+    static constexpr size_t CACHE_LINE_SIZE = 64;
+    
+    struct alignas(CACHE_LINE_SIZE) Entry {
+        OrderBook book;
+        
+        Entry(Symbol symbol, const BookConfig& config) : book(symbol, config) {}
+    };
+    
+    std::vector<OrderBook*> slots_;  // Indexed by Symbol, nullptr = not registered
+    std::vector<Entry> books_;       // Registration order; never reallocates
+
+public:
+    static constexpr size_t DEFAULT_MAX_SYMBOL = 65535;
+    static constexpr size_t DEFAULT_MAX_BOOKS = 8192;
+    
+    explicit SymbolTable(size_t max_symbol = DEFAULT_MAX_SYMBOL, size_t max_books = DEFAULT_MAX_BOOKS);
+    
+    // Returns the symbol's book (the existing one if already registered), or
+    // nullptr if the symbol is out of range or the table is full
+    OrderBook* register_symbol(Symbol symbol, const BookConfig& config = BookConfig{});
+    
+    OrderBook* find(Symbol symbol) noexcept {
+        return symbol < slots_.size() ? slots_[symbol] : nullptr;
+    }
+    
+    const OrderBook* find(Symbol symbol) const noexcept {
+        return symbol < slots_.size() ? slots_[symbol] : nullptr;
+    }
+    
+    bool contains(Symbol symbol) const noexcept { return find(symbol) != nullptr; }
+    
+    size_t size() const noexcept { return books_.size(); }
+    size_t max_books() const noexcept { return books_.capacity(); }
+    Symbol max_symbol() const noexcept { return static_cast<Symbol>(slots_.size() - 1); }
+    const OrderBook& book_at(size_t index) const noexcept { return books_[index].book; }  // index < size()
+    
+    // Registered books in registration order
+    template<typename Func>
+    void for_each(Func&& func) const {
+        for (const Entry& entry : books_) {
+            func(entry.book);
+        }
+    }
+    
+    template<typename Func>
+    void for_each(Func&& func) {
+        for (Entry& entry : books_) {
+            func(entry.book);
+        }
+    }
+    
+    SymbolTable(const SymbolTable&) = delete;
+    SymbolTable& operator=(const SymbolTable&) = delete;
+};
+
+} // namespace nanotrader
\ No newline at end of file
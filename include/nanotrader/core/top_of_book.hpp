@@ -0,0 +1,106 @@
+#pragma once
+
+#include "symbol_table.hpp"
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace nanotrader {
+
+// Reader-side copy of one symbol's best levels, best price first
+struct TopOfBook {
+    static constexpr size_t DEPTH = 5;
+    
+    struct Level {
+        Price price{};
+        Quantity quantity{0};
+        
+        bool operator==(const Level&) const = default;
+    };
+    
+    Symbol symbol{0};
+    uint64_t version{0};     // Bumped by every published change
+    uint32_t bid_count{0};
+    uint32_t ask_count{0};
+    std::array<Level, DEPTH> bids{};
+    std::array<Level, DEPTH> asks{};
+    
+    bool has_bid() const noexcept { return bid_count > 0; }
+    bool has_ask() const noexcept { return ask_count > 0; }
+    Price best_bid() const noexcept { return bids[0].price; }
+    Price best_ask() const noexcept { return asks[0].price; }
+};
+
+// Conflated top-N depth per symbol, written by the matching thread and readable
+// from any number of other threads without locks. Each symbol has its own
+// cache-line-aligned seqlock slot, so readers of different symbols never share a
+// line and readers never write to one. Books mark themselves dirty on level
+// changes; flush(), which the engine calls once per processed batch, recomputes
+// the dirty books and rewrites a slot only if its top levels actually moved.
+class TopOfBookFeed {
+public:
+    static constexpr size_t DEPTH = TopOfBook::DEPTH;
+    static constexpr size_t DEFAULT_MAX_BOOKS = 1024;
+
+private:
+    static constexpr size_t CACHE_LINE_SIZE = 64;
+    static constexpr uint32_t NO_SLOT = 0;
+    
+    // Every field is an atomic accessed relaxed, ordered by the fences around seq
+    struct alignas(CACHE_LINE_SIZE) Slot {
+        std::atomic<uint64_t> seq{0};  // Odd while the writer is mid-update
+        std::atomic<uint32_t> bid_count{0};
+        std::atomic<uint32_t> ask_count{0};
+        std::array<std::atomic<int64_t>, DEPTH> bid_prices{};
+        std::array<std::atomic<uint64_t>, DEPTH> bid_quantities{};
+        std::array<std::atomic<int64_t>, DEPTH> ask_prices{};
+        std::array<std::atomic<uint64_t>, DEPTH> ask_quantities{};
+    };
+    
+    // Writer-private state, kept off the slots' cache lines
+    struct Shadow {
+        const OrderBook* book{nullptr};
+        TopOfBook top{};
+        bool queued{false};
+    };
+    
+    std::vector<Slot> slots_;
+    std::vector<std::atomic<uint32_t>> slot_of_;  // Indexed by Symbol: slot + 1, 0 = untracked
+    std::vector<Shadow> shadows_;
+    std::vector<uint32_t> dirty_;                 // Slots to recompute; never outgrows its reservation
+    std::atomic<size_t> slot_count_{0};
+    
+    void publish(uint32_t slot, const TopOfBook& top) noexcept;
+
+public:
+    explicit TopOfBookFeed(size_t max_books = DEFAULT_MAX_BOOKS,
+                           size_t max_symbol = SymbolTable::DEFAULT_MAX_SYMBOL);
+    
+    // Writer side: one thread, normally the single matching thread. add_book()
+    // returns the book's slot, or -1 if the symbol is out of range or the feed is full.
+    int32_t add_book(const OrderBook& book);
+    
+    void mark_dirty(uint32_t slot) noexcept {
+        Shadow& shadow = shadows_[slot];
+        if (!shadow.queued) {
+            shadow.queued = true;
+            dirty_.push_back(slot);
+        }
+    }
+    
+    void mark_all_dirty() noexcept;
+    void flush();
+    
+    // Reader side (any thread). False if the symbol isn't tracked.
+    bool read(Symbol symbol, TopOfBook& out) const noexcept;
+    uint64_t get_version(Symbol symbol) const noexcept;  // Cheap change check; 0 = untracked or never published
+    
+    size_t get_book_count() const noexcept;
+    
+    TopOfBookFeed(const TopOfBookFeed&) = delete;
+    TopOfBookFeed& operator=(const TopOfBookFeed&) = delete;
+};
+
+} // namespace nanotrader
\ No newline at end of file
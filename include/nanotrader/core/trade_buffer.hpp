@@ -0,0 +1,109 @@
+#pragma once
+
+#include "types.hpp"
+#include "nanotrader/memory/pool_allocator.hpp"
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace nanotrader {
+
+struct Trade {
+    OrderId maker_order_id{0};
+    OrderId taker_order_id{0};
+    Symbol symbol{0};
+    Price price{};
+    Quantity quantity{0};
+    Timestamp timestamp{0};
+    
+    Trade() noexcept = default;
+    Trade(OrderId maker, OrderId taker, Symbol sym, Price p, Quantity q, Timestamp ts) noexcept
+        : maker_order_id(maker), taker_order_id(taker), symbol(sym), price(p), quantity(q), timestamp(ts) {}
+};
+
+static_assert(std::is_trivially_copyable_v<Trade>, "Trade is copied with memcpy-style moves");
+
+// Trade list for one MatchResult without touching the heap on the normal path.
+// The first INLINE_CAPACITY trades live inside the object; a larger sweep moves
+// to a SpillBlock from a preallocated arena, and only a sweep beyond
+// SPILL_CAPACITY falls back to the heap. Blocks return to the arena on destruction,
+// so the arena must outlive every result that drew from it.
+class TradeBuffer {
+public:
+    static constexpr size_t INLINE_CAPACITY = 4;
+    static constexpr size_t SPILL_CAPACITY = 256;
+    
+    struct SpillBlock {
+        Trade trades[SPILL_CAPACITY];
+    };
+    
+    using Arena = PoolAllocator<SpillBlock>;
+
+private:
+    size_t size_{0};
+    size_t capacity_{INLINE_CAPACITY};
+    Arena* arena_{nullptr};
+    SpillBlock* block_{nullptr};
+    std::unique_ptr<Trade[]> heap_;
+    alignas(Trade) unsigned char inline_[INLINE_CAPACITY * sizeof(Trade)];
+    
+    Trade* inline_data() noexcept { return std::launder(reinterpret_cast<Trade*>(inline_)); }
+    const Trade* inline_data() const noexcept { return std::launder(reinterpret_cast<const Trade*>(inline_)); }
+    
+    void grow();
+    void release() noexcept;
+    void steal(TradeBuffer& other) noexcept;
+
+public:
+    TradeBuffer() noexcept = default;
+    explicit TradeBuffer(Arena* arena) noexcept : arena_(arena) {}
+    ~TradeBuffer() { release(); }
+    
+    TradeBuffer(TradeBuffer&& other) noexcept { steal(other); }
+    TradeBuffer& operator=(TradeBuffer&& other) noexcept {
+        if (this != &other) {
+            release();
+            steal(other);
+        }
+        return *this;
+    }
+    
+    // Copies would hide allocations; results are only ever moved
+    TradeBuffer(const TradeBuffer&) = delete;
+    TradeBuffer& operator=(const TradeBuffer&) = delete;
+    
+    template<typename... Args>
+    Trade& emplace_back(Args&&... args) {
+        if (size_ == capacity_) {
+            grow();
+        }
+        return *new (data() + size_++) Trade(std::forward<Args>(args)...);
+    }
+    
+    Trade* data() noexcept {
+        return heap_ ? heap_.get() : block_ ? block_->trades : inline_data();
+    }
+    const Trade* data() const noexcept {
+        return heap_ ? heap_.get() : block_ ? block_->trades : inline_data();
+    }
+    
+    Trade& operator[](size_t i) noexcept { return data()[i]; }
+    const Trade& operator[](size_t i) const noexcept { return data()[i]; }
+    
+    Trade* begin() noexcept { return data(); }
+    Trade* end() noexcept { return data() + size_; }
+    const Trade* begin() const noexcept { return data(); }
+    const Trade* end() const noexcept { return data() + size_; }
+    
+    size_t size() const noexcept { return size_; }
+    size_t capacity() const noexcept { return capacity_; }
+    bool empty() const noexcept { return size_ == 0; }
+    bool spilled() const noexcept { return block_ != nullptr || heap_ != nullptr; }
+    
+    // Keeps any spill storage; it is only returned on destruction or move-assignment
+    void clear() noexcept { size_ = 0; }
+};
+
+} // namespace nanotrader
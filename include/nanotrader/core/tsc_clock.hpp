@@ -0,0 +1,84 @@
+#pragma once
+
+#include "types.hpp"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+namespace nanotrader {
+
+// Cycle counter calibrated against now(), so converted values share the
+// Timestamp domain used everywhere else. Reading the counter is a single
+// rdtsc (x86) / cntvct_el0 (ARM64); conversion is one 128-bit multiply.
+// The owning thread calls reanchor_if_due() regularly so the short calibration's
+// rate error can't accumulate: each re-anchor snaps back onto now() and refines
+// the rate over the whole interval since the last one.
+class TscClock {
+private:
+    uint64_t base_cycles_{0};
+    Timestamp base_time_{0};
+    uint64_t reanchor_cycles_{~uint64_t{0}};  // Counter ticks between re-anchors; never until calibrated
+    std::chrono::milliseconds reanchor_interval_{1000};
+    
+    // Read by other threads (metrics export) through cycles_to_ns()
+    std::atomic<uint64_t> ns_per_cycle_q32_{uint64_t{1} << 32};  // ns per cycle, 32.32 fixed point
+    std::atomic<uint64_t> cycles_per_us_{1000};
+    
+    static constexpr uint64_t MAX_RATE_CHANGE_PPM = 10000;  // Larger jumps keep the old rate
+    
+    void reanchor(uint64_t cycle_count) noexcept;
+
+public:
+    TscClock() noexcept = default;
+    
+    static uint64_t cycles() noexcept {
+#if defined(__x86_64__) || defined(__i386__)
+        return __rdtsc();
+#elif defined(__aarch64__)
+        uint64_t value;
+        asm volatile("mrs %0, cntvct_el0" : "=r"(value));
+        return value;
+#else
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count());
+#endif
+    }
+    
+    // Measures the counter rate against now() over the given window (busy-waits)
+    void calibrate(std::chrono::microseconds window = std::chrono::microseconds(2000));
+    
+    // One compare until the interval has passed, then one now() call: re-anchors
+    // and refines the rate. Each re-anchor may step now() by the drift accumulated
+    // over one interval. Owning thread only; true if it re-anchored.
+    bool reanchor_if_due(uint64_t cycle_count = cycles()) noexcept {
+        if (cycle_count - base_cycles_ < reanchor_cycles_) {
+            return false;
+        }
+        reanchor(cycle_count);
+        return true;
+    }
+    
+    // Takes effect at the next calibrate() or re-anchor
+    void set_reanchor_interval(std::chrono::milliseconds interval) noexcept { reanchor_interval_ = interval; }
+    
+    Timestamp to_timestamp(uint64_t cycle_count) const noexcept {
+        uint64_t delta = cycle_count - base_cycles_;
+        return base_time_ + static_cast<Timestamp>(
+            (static_cast<unsigned __int128>(delta) * ns_per_cycle_q32_.load(std::memory_order_relaxed)) >> 32);
+    }
+    
+    uint64_t cycles_to_ns(uint64_t cycle_delta) const noexcept {
+        return static_cast<uint64_t>(
+            (static_cast<unsigned __int128>(cycle_delta) * ns_per_cycle_q32_.load(std::memory_order_relaxed)) >> 32);
+    }
+    
+    Timestamp now() const noexcept { return to_timestamp(cycles()); }
+    
+    uint64_t cycles_per_us() const noexcept { return cycles_per_us_.load(std::memory_order_relaxed); }
+};
+
+} // namespace nanotrader
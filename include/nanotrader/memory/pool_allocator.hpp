@@ -1,32 +1,71 @@
 #pragma once
 
+#include "tagged_ptr.hpp"
 #include <memory>
 #include <atomic>
+#include <mutex>
 #include <vector>
 #include <cstdlib>
+#include <type_traits>
 
 namespace nanotrader {
 
-template<typename T>
+// Threading policies for PoolAllocator
+struct MultiThreaded {};   // Lock-free tagged CAS free list, any thread may allocate/deallocate
+struct SingleThreaded {};  // Plain pointer free list, owned by exactly one thread
+
+struct PoolOptions {
+    bool use_hugepages = true;   // MAP_HUGETLB, then THP madvise, then regular pages
+    bool prefault = false;       // MAP_POPULATE each slab when it is mapped
+    bool lock_memory = false;    // mlock each slab so it is never paged out
+    bool growable = true;        // Map a new slab instead of returning nullptr
+    size_t growth_size = 0;      // Objects per extra slab, 0 = initial pool size
+    size_t max_capacity = 0;     // Upper bound on objects across slabs, 0 = unbounded
+};
+
+template<typename T, typename ThreadingPolicy = MultiThreaded>
 class PoolAllocator {
 private:
     static constexpr size_t ALIGNMENT = 64;
     static constexpr size_t HUGEPAGE_SIZE = 2 * 1024 * 1024; // 2MB
+    static constexpr bool SINGLE_THREADED = std::is_same_v<ThreadingPolicy, SingleThreaded>;
     
     struct alignas(ALIGNMENT) FreeNode {
         FreeNode* next;
     };
     
-    std::atomic<FreeNode*> free_list_;
-    std::vector<void*> allocated_chunks_;
+    struct Chunk {
+        void* ptr;
+        size_t size;
+    };
+    
+    // The shared head carries a version tag: a node popped and pushed back by another
+    // thread between our load and CAS changes the tag, so a stale next is never installed
+    using FreeListHead = std::conditional_t<SINGLE_THREADED, FreeNode*, std::atomic<TaggedPtr<FreeNode>>>;
+    
+    FreeListHead free_list_;
+    std::vector<Chunk> allocated_chunks_;
+    PoolOptions options_;
     size_t pool_size_;
+    size_t obj_size_;
     size_t chunk_size_;
     
+    // Maintained on every allocate/deallocate so capacity queries never walk the list
+    std::atomic<size_t> available_{0};
+    std::atomic<size_t> capacity_{0};
+    bool huge_pages_{false};
+    std::mutex growth_mutex_;  // Slow path only: serialises slab mapping
+    
     void* allocate_chunk(size_t size);
+    void free_chunk(const Chunk& chunk);
+    bool add_slab(size_t objects);
+    bool grow();
     void setup_free_list(void* chunk, size_t chunk_size, size_t obj_size);
+    T* pop_free() noexcept;
+    void push_free(FreeNode* first, FreeNode* last) noexcept;
 
 public:
-    explicit PoolAllocator(size_t pool_size = 1000000);
+    explicit PoolAllocator(size_t pool_size = 1000000, const PoolOptions& options = PoolOptions{});
     ~PoolAllocator();
     
     T* allocate();
@@ -50,6 +89,16 @@ public:
     
     size_t available_count() const;
     size_t capacity() const;
+    size_t slab_count() const;
+    
+    // Mapped slabs as (address, bytes); from the allocating thread or while it is idle
+    template<typename Func>
+    void for_each_slab(Func&& func) const {
+        for (const Chunk& chunk : allocated_chunks_) {
+            func(chunk.ptr, chunk.size);
+        }
+    }
+    bool using_hugepages() const;
     
     PoolAllocator(const PoolAllocator&) = delete;
     PoolAllocator& operator=(const PoolAllocator&) = delete;
@@ -1,37 +1,143 @@
 #pragma once
 
 #include "pool_allocator.hpp"
+#include <algorithm>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/mman.h>
+#endif
 
 namespace nanotrader {
 
-template<typename T>
-void* PoolAllocator<T>::allocate_chunk(size_t size) {
+template<typename T, typename ThreadingPolicy>
+void* PoolAllocator<T, ThreadingPolicy>::allocate_chunk(size_t size) {
+#if defined(__unix__) || defined(__APPLE__)
+    int flags = MAP_PRIVATE | MAP_ANONYMOUS;
+#ifdef MAP_POPULATE
+    if (options_.prefault) {
+        flags |= MAP_POPULATE;
+    }
+#endif
+    
+    void* ptr = MAP_FAILED;
+#ifdef MAP_HUGETLB
+    if (options_.use_hugepages) {
+        // Explicit hugepages need a reserved pool (vm.nr_hugepages); fall through if empty
+        ptr = mmap(nullptr, size, PROT_READ | PROT_WRITE, flags | MAP_HUGETLB, -1, 0);
+        huge_pages_ = huge_pages_ || ptr != MAP_FAILED;
+    }
+#endif
+    
+    if (ptr == MAP_FAILED) {
+        ptr = mmap(nullptr, size, PROT_READ | PROT_WRITE, flags, -1, 0);
+        if (ptr == MAP_FAILED) {
+            return nullptr;
+        }
+#ifdef MADV_HUGEPAGE
+        if (options_.use_hugepages) {
+            madvise(ptr, size, MADV_HUGEPAGE);  // Transparent hugepages, best effort
+        }
+#endif
+    }
+    
+    if (options_.lock_memory) {
+        mlock(ptr, size);  // Best effort: RLIMIT_MEMLOCK may refuse
+    }
+    
+    return ptr;
+#else
     // Simplified allocation for compatibility
     void* ptr = std::malloc(size);
     return ptr;
+#endif
 }
 
-template<typename T>
-void PoolAllocator<T>::setup_free_list(void* chunk, size_t chunk_size, size_t obj_size) {
+template<typename T, typename ThreadingPolicy>
+void PoolAllocator<T, ThreadingPolicy>::free_chunk(const Chunk& chunk) {
+#if defined(__unix__) || defined(__APPLE__)
+    munmap(chunk.ptr, chunk.size);
+#else
+    std::free(chunk.ptr);
+#endif
+}
+
+template<typename T, typename ThreadingPolicy>
+void PoolAllocator<T, ThreadingPolicy>::setup_free_list(void* chunk, size_t chunk_size, size_t obj_size) {
     char* ptr = static_cast<char*>(chunk);
     char* end = ptr + chunk_size;
     
-    FreeNode* current = free_list_.load();
+    // Link the slab locally, then splice it onto the shared list in one step
+    FreeNode* first = nullptr;
+    FreeNode* last = nullptr;
+    size_t count = 0;
     
     while (ptr + obj_size <= end) {
         FreeNode* node = reinterpret_cast<FreeNode*>(ptr);
-        node->next = current;
-        current = node;
+        node->next = first;
+        first = node;
+        if (!last) {
+            last = node;
+        }
         ptr += obj_size;
+        ++count;
+    }
+    
+    if (first) {
+        capacity_.fetch_add(count, std::memory_order_relaxed);
+        push_free(first, last);
+        available_.fetch_add(count, std::memory_order_relaxed);
+    }
+}
+
+template<typename T, typename ThreadingPolicy>
+bool PoolAllocator<T, ThreadingPolicy>::add_slab(size_t objects) {
+    size_t bytes = objects * obj_size_;
+    size_t aligned_chunk_size = (bytes + HUGEPAGE_SIZE - 1) & ~(HUGEPAGE_SIZE - 1);
+    
+    void* chunk = allocate_chunk(aligned_chunk_size);
+    if (!chunk) {
+        return false;
     }
+    allocated_chunks_.push_back(Chunk{chunk, aligned_chunk_size});
     
-    free_list_.store(current);
+    setup_free_list(chunk, aligned_chunk_size, obj_size_);
+    return true;
 }
 
-template<typename T>
-PoolAllocator<T>::PoolAllocator(size_t pool_size) 
-    : free_list_(nullptr)
+template<typename T, typename ThreadingPolicy>
+bool PoolAllocator<T, ThreadingPolicy>::grow() {
+    if (!options_.growable) {
+        return false;
+    }
+    
+    std::unique_lock<std::mutex> lock(growth_mutex_, std::defer_lock);
+    if constexpr (!SINGLE_THREADED) {
+        lock.lock();
+        // Another thread may have grown (or objects came back) while we waited
+        if (available_.load(std::memory_order_relaxed) > 0) {
+            return true;
+        }
+    }
+    
+    size_t objects = options_.growth_size ? options_.growth_size : pool_size_;
+    if (options_.max_capacity) {
+        size_t current = capacity_.load(std::memory_order_relaxed);
+        if (current >= options_.max_capacity) {
+            return false;
+        }
+        objects = std::min(objects, options_.max_capacity - current);
+    }
+    
+    // Existing slabs never move, so outstanding objects stay valid
+    return add_slab(std::max<size_t>(objects, 1));
+}
+
+template<typename T, typename ThreadingPolicy>
+PoolAllocator<T, ThreadingPolicy>::PoolAllocator(size_t pool_size, const PoolOptions& options) 
+    : free_list_()
+    , options_(options)
     , pool_size_(pool_size)
+    , obj_size_(0)
     , chunk_size_(0) {
     
     static_assert(sizeof(T) >= sizeof(FreeNode*), 
@@ -39,66 +145,107 @@ PoolAllocator<T>::PoolAllocator(size_t pool_size)
     
     size_t obj_size = std::max(sizeof(T), sizeof(FreeNode));
     obj_size = (obj_size + ALIGNMENT - 1) & ~(ALIGNMENT - 1);
+    obj_size_ = obj_size;
     
     chunk_size_ = pool_size_ * obj_size;
     
-    size_t aligned_chunk_size = (chunk_size_ + HUGEPAGE_SIZE - 1) & ~(HUGEPAGE_SIZE - 1);
-    
-    void* chunk = allocate_chunk(aligned_chunk_size);
-    if (!chunk) {
+    if (pool_size_ > 0 && !add_slab(pool_size_)) {
         return; // Failed to allocate, pool will be empty
     }
-    allocated_chunks_.push_back(chunk);
-    
-    setup_free_list(chunk, aligned_chunk_size, obj_size);
 }
 
-template<typename T>
-PoolAllocator<T>::~PoolAllocator() {
-    for (void* chunk : allocated_chunks_) {
-        std::free(chunk);
+template<typename T, typename ThreadingPolicy>
+PoolAllocator<T, ThreadingPolicy>::~PoolAllocator() {
+    for (const Chunk& chunk : allocated_chunks_) {
+        free_chunk(chunk);
     }
 }
 
-template<typename T>
-T* PoolAllocator<T>::allocate() {
-    FreeNode* node = free_list_.load();
-    while (node) {
-        if (free_list_.compare_exchange_weak(node, node->next)) {
+template<typename T, typename ThreadingPolicy>
+T* PoolAllocator<T, ThreadingPolicy>::pop_free() noexcept {
+    if constexpr (SINGLE_THREADED) {
+        FreeNode* node = free_list_;
+        if (node) {
+            free_list_ = node->next;
+            available_.store(available_.load(std::memory_order_relaxed) - 1, std::memory_order_relaxed);
             return reinterpret_cast<T*>(node);
         }
+    } else {
+        TaggedPtr<FreeNode> head = free_list_.load(std::memory_order_acquire);
+        while (FreeNode* node = head.ptr()) {
+            // node->next may be stale if node was taken concurrently; the tag catches it
+            if (free_list_.compare_exchange_weak(head, head.with(node->next), 
+                                                 std::memory_order_acquire, 
+                                                 std::memory_order_acquire)) {
+                available_.fetch_sub(1, std::memory_order_relaxed);
+                return reinterpret_cast<T*>(node);
+            }
+        }
     }
-    
-    // Pool exhausted, could expand here or return nullptr
     return nullptr;
 }
 
-template<typename T>
-void PoolAllocator<T>::deallocate(T* ptr) {
+template<typename T, typename ThreadingPolicy>
+void PoolAllocator<T, ThreadingPolicy>::push_free(FreeNode* first, FreeNode* last) noexcept {
+    if constexpr (SINGLE_THREADED) {
+        last->next = free_list_;
+        free_list_ = first;
+    } else {
+        TaggedPtr<FreeNode> head = free_list_.load(std::memory_order_relaxed);
+        do {
+            last->next = head.ptr();
+        } while (!free_list_.compare_exchange_weak(head, head.with(first), 
+                                                   std::memory_order_release, 
+                                                   std::memory_order_relaxed));
+    }
+}
+
+template<typename T, typename ThreadingPolicy>
+T* PoolAllocator<T, ThreadingPolicy>::allocate() {
+    T* ptr = pop_free();
+    if (ptr) {
+        return ptr;
+    }
+    
+    // Pool exhausted: map another slab unless growth is disabled or capped
+    if (!grow()) {
+        return nullptr;
+    }
+    return pop_free();
+}
+
+template<typename T, typename ThreadingPolicy>
+void PoolAllocator<T, ThreadingPolicy>::deallocate(T* ptr) {
     if (!ptr) return;
     
     FreeNode* node = reinterpret_cast<FreeNode*>(ptr);
-    FreeNode* head = free_list_.load();
+    push_free(node, node);
     
-    do {
-        node->next = head;
-    } while (!free_list_.compare_exchange_weak(head, node));
+    if constexpr (SINGLE_THREADED) {
+        available_.store(available_.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    } else {
+        available_.fetch_add(1, std::memory_order_relaxed);
+    }
 }
 
-template<typename T>
-size_t PoolAllocator<T>::available_count() const {
-    size_t count = 0;
-    FreeNode* node = free_list_.load();
-    while (node) {
-        ++count;
-        node = node->next;
-    }
-    return count;
+template<typename T, typename ThreadingPolicy>
+size_t PoolAllocator<T, ThreadingPolicy>::available_count() const {
+    return available_.load(std::memory_order_relaxed);
+}
+
+template<typename T, typename ThreadingPolicy>
+size_t PoolAllocator<T, ThreadingPolicy>::capacity() const {
+    return capacity_.load(std::memory_order_relaxed);
+}
+
+template<typename T, typename ThreadingPolicy>
+size_t PoolAllocator<T, ThreadingPolicy>::slab_count() const {
+    return allocated_chunks_.size();
 }
 
-template<typename T>
-size_t PoolAllocator<T>::capacity() const {
-    return pool_size_;
+template<typename T, typename ThreadingPolicy>
+bool PoolAllocator<T, ThreadingPolicy>::using_hugepages() const {
+    return huge_pages_;
 }
 
 } // namespace nanotrader
\ No newline at end of file
@@ -1,5 +1,7 @@
 #pragma once
 
+#include "pool_allocator.hpp"
+#include <algorithm>
 #include <atomic>
 #include <cstddef>
 #include <memory>
@@ -7,6 +9,9 @@
 
 namespace nanotrader {
 
+// Single-producer, single-consumer ring. It holds indices only, no pointers, so
+// with a trivially copyable T and lock-free atomics it can be constructed in
+// memory shared between processes (see network/shm_gateway.hpp).
 template<typename T, size_t Size>
 class SPSCRingBuffer {
 private:
@@ -14,12 +19,12 @@ private:
     static constexpr size_t MASK = Size - 1;
     static constexpr size_t CACHE_LINE_SIZE = 64;
     
+    // Each side's cached copy of the other's index sits on its own line
     alignas(CACHE_LINE_SIZE) std::atomic<size_t> head_{0};
+    size_t cached_tail_{0};  // Consumer only
     alignas(CACHE_LINE_SIZE) std::atomic<size_t> tail_{0};
+    size_t cached_head_{0};  // Producer only
     alignas(CACHE_LINE_SIZE) T buffer_[Size];
-    
-    size_t cached_head_{0};
-    size_t cached_tail_{0};
 
 public:
     SPSCRingBuffer() = default;
@@ -67,14 +72,16 @@ public:
     size_t try_pop_batch(Func&& func, size_t max_items = Size) {
         const size_t current_head = head_.load(std::memory_order_relaxed);
         
-        if (current_head == cached_tail_) {
+        // Refresh when the cached tail can't cover the request, as try_push_batch does for the head
+        size_t available = (cached_tail_ - current_head) & MASK;
+        if (available < max_items) {
             cached_tail_ = tail_.load(std::memory_order_acquire);
-            if (current_head == cached_tail_) {
+            available = (cached_tail_ - current_head) & MASK;
+            if (available == 0) {
                 return 0;
             }
         }
         
-        size_t available = (cached_tail_ - current_head) & MASK;
         size_t to_pop = std::min(available, max_items);
         
         for (size_t i = 0; i < to_pop; ++i) {
@@ -91,6 +98,53 @@ public:
         return to_pop;
     }
     
+    // Moves up to count items from first into the ring, publishing them with a single tail store
+    template<typename InputIt>
+    size_t try_push_batch(InputIt first, size_t count) {
+        const size_t current_tail = tail_.load(std::memory_order_relaxed);
+        
+        size_t free_slots = (cached_head_ - current_tail - 1) & MASK;
+        if (free_slots < count) {
+            cached_head_ = head_.load(std::memory_order_acquire);
+            free_slots = (cached_head_ - current_tail - 1) & MASK;
+        }
+        
+        size_t to_push = std::min(free_slots, count);
+        
+        for (size_t i = 0; i < to_push; ++i, ++first) {
+            new (&buffer_[(current_tail + i) & MASK]) T(std::move(*first));
+        }
+        
+        tail_.store((current_tail + to_push) & MASK, std::memory_order_release);
+        
+        return to_push;
+    }
+    
+    // Zero-copy producer path: fill(T& slot) writes each item straight into the ring
+    // and returns false to stop early; everything filled is published with one tail store
+    template<typename Func>
+    size_t try_emplace_batch(size_t max_items, Func&& fill) {
+        const size_t current_tail = tail_.load(std::memory_order_relaxed);
+        
+        size_t free_slots = (cached_head_ - current_tail - 1) & MASK;
+        if (free_slots < max_items) {
+            cached_head_ = head_.load(std::memory_order_acquire);
+            free_slots = (cached_head_ - current_tail - 1) & MASK;
+        }
+        
+        size_t limit = std::min(free_slots, max_items);
+        size_t filled = 0;
+        while (filled < limit && fill(buffer_[(current_tail + filled) & MASK])) {
+            ++filled;
+        }
+        
+        if (filled > 0) {
+            tail_.store((current_tail + filled) & MASK, std::memory_order_release);
+        }
+        
+        return filled;
+    }
+    
     bool empty() const {
         return head_.load(std::memory_order_acquire) == 
                tail_.load(std::memory_order_acquire);
@@ -116,10 +170,15 @@ public:
     SPSCRingBuffer& operator=(const SPSCRingBuffer&) = delete;
 };
 
+// Multi-producer, single-consumer queue (Vyukov intrusive list). Nodes come from
+// a preallocated, growable PoolAllocator with an ABA-safe free list: producers
+// allocate, the consumer recycles the retired stub, and the global allocator is
+// only touched if the pool has to map another slab.
 template<typename T>
 class MPSCRingBuffer {
 private:
     static constexpr size_t CACHE_LINE_SIZE = 64;
+    static constexpr size_t DEFAULT_NODE_CAPACITY = 65536;
     
     struct alignas(CACHE_LINE_SIZE) Node {
         std::atomic<Node*> next{nullptr};
@@ -131,73 +190,66 @@ private:
         Node(Args&&... args) : data(std::forward<Args>(args)...) {}
     };
     
+    PoolAllocator<Node, MultiThreaded> node_pool_;  // Declared first: outlives the list
+    
     alignas(CACHE_LINE_SIZE) std::atomic<Node*> head_{nullptr};
     alignas(CACHE_LINE_SIZE) std::atomic<Node*> tail_{nullptr};
-    
-    Node* stub_;
 
 public:
-    MPSCRingBuffer() {
-        stub_ = new Node();
-        head_.store(stub_);
-        tail_.store(stub_);
+    explicit MPSCRingBuffer(size_t node_capacity = DEFAULT_NODE_CAPACITY, 
+                            const PoolOptions& options = PoolOptions{})
+        : node_pool_(node_capacity + 1, options) {  // +1 for the stub
+        Node* stub = node_pool_.construct();
+        head_.store(stub);
+        tail_.store(stub);
     }
     
     ~MPSCRingBuffer() {
         while (Node* node = head_.load()) {
             head_.store(node->next);
-            delete node;
+            node_pool_.destroy(node);
         }
     }
     
+    // Returns false only if the node pool is capped and exhausted
     template<typename... Args>
-    void push(Args&&... args) {
-        Node* node = new Node(std::forward<Args>(args)...);
-        Node* prev_tail = tail_.exchange(node);
-        prev_tail->next.store(node);
+    bool push(Args&&... args) {
+        Node* node = node_pool_.construct(std::forward<Args>(args)...);
+        if (!node) {
+            return false;
+        }
+        
+        Node* prev_tail = tail_.exchange(node, std::memory_order_acq_rel);
+        prev_tail->next.store(node, std::memory_order_release);
+        return true;
     }
     
     bool try_pop(T& item) {
-        Node* head = head_.load();
-        Node* next = head->next.load();
+        Node* head = head_.load(std::memory_order_relaxed);
+        Node* next = head->next.load(std::memory_order_acquire);
         
         if (next == nullptr) {
             return false;
         }
         
         item = std::move(next->data);
-        head_.store(next);
-        delete head;
+        head_.store(next, std::memory_order_relaxed);
+        node_pool_.destroy(head);  // next becomes the stub; old stub goes back to producers
         
         return true;
     }
     
     bool empty() const {
-        Node* head = head_.load();
-        return head->next.load() == nullptr;
+        Node* head = head_.load(std::memory_order_relaxed);
+        return head->next.load(std::memory_order_acquire) == nullptr;
+    }
+    
+    size_t available_nodes() const {
+        return node_pool_.available_count();
     }
     
     MPSCRingBuffer(const MPSCRingBuffer&) = delete;
     MPSCRingBuffer& operator=(const MPSCRingBuffer&) = delete;
 };
 
-} // namespace nanotraderstatic constexpr bool ENABLE_PREFETCH = true;
-bool try_pop(T& item) noexcept;
-void debug_print() const { printf("Head=%zu Tail=%zu\n", head_.load(), tail_.load()); }
-// Refactor tail advancement logic with comment
-void reset() { head_.store(0); tail_.store(0); }
-bool nearly_full() const { return size() >= capacity() - 1; }
-// Group atomic loads into local vars for clarity
-// Replace redundant std::move with move_if_noexcept
-// Add detailed comments to batch pop loop
-static constexpr bool ENABLE_PREFETCH = true;
-// Add early return to empty() for readability
-// Document MPSC destructor ownership behavior
-// Use CACHE_LINE_SIZE macro consistently
-// Inline trivial accessors for better inlining
-// Simplify Node constructor using delegating ctor
-// Refactor loop index calculation in batch pop
-// Clarify full() condition logic
-// Add noexcept to push method in MPSC
-// TODO: Implement memory recycling for unused nodes.
-// Format spacing and align comment styles
+} // namespace nanotrader
\ No newline at end of file
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <cstdint>
+
+namespace nanotrader {
+
+// Pointer plus a 16-bit version counter packed into one 64-bit word, so a
+// single-word CAS on a lock-free stack head fails if the head was popped and
+// pushed back in between (ABA). Relies on user-space addresses fitting in
+// 48 bits, which holds on x86-64 and ARM64.
+template<typename T>
+class TaggedPtr {
+private:
+    static constexpr int TAG_SHIFT = 48;
+    static constexpr uint64_t PTR_MASK = (uint64_t{1} << TAG_SHIFT) - 1;
+    
+    uint64_t bits_;
+
+public:
+    constexpr TaggedPtr() noexcept : bits_(0) {}
+    TaggedPtr(T* ptr, uint16_t tag) noexcept 
+        : bits_((reinterpret_cast<uint64_t>(ptr) & PTR_MASK) | (uint64_t{tag} << TAG_SHIFT)) {}
+    
+    T* ptr() const noexcept { return reinterpret_cast<T*>(bits_ & PTR_MASK); }
+    uint16_t tag() const noexcept { return static_cast<uint16_t>(bits_ >> TAG_SHIFT); }
+    
+    // Same slot, new pointer, bumped version
+    TaggedPtr with(T* ptr) const noexcept { return TaggedPtr(ptr, static_cast<uint16_t>(tag() + 1)); }
+    
+    bool operator==(const TaggedPtr& other) const noexcept { return bits_ == other.bits_; }
+    bool operator!=(const TaggedPtr& other) const noexcept { return bits_ != other.bits_; }
+};
+
+} // namespace nanotrader
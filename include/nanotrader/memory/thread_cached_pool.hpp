@@ -0,0 +1,179 @@
+#pragma once
+
+#include <algorithm>
+#include "tagged_ptr.hpp"
+#include <atomic>
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+#include <utility>
+#include <vector>
+
+namespace nanotrader {
+
+// Object pool with per-thread caches in front of a shared, lock-free depot.
+// The depot is a stack of batches (intrusive chains of up to BatchSize free
+// objects), so a cache refills or flushes a whole batch with a single CAS and
+// the common allocate/deallocate path touches only thread-local pointers.
+// Each thread that allocates creates its own Cache; a Cache is not thread-safe.
+template<typename T, size_t BatchSize = 64>
+class ThreadCachedPool {
+private:
+    static constexpr size_t ALIGNMENT = 64;
+    
+    struct alignas(ALIGNMENT) FreeNode {
+        FreeNode* next;        // Next object in this batch
+        FreeNode* next_batch;  // Next batch in the depot (batch head only)
+        size_t batch_size;     // Objects in this batch (batch head only)
+    };
+    
+    alignas(ALIGNMENT) std::atomic<TaggedPtr<FreeNode>> depot_{TaggedPtr<FreeNode>()};
+    std::vector<void*> allocated_chunks_;
+    size_t pool_size_;
+    
+    void push_batch(FreeNode* head, size_t count) noexcept {
+        head->batch_size = count;
+        TaggedPtr<FreeNode> top = depot_.load(std::memory_order_relaxed);
+        do {
+            head->next_batch = top.ptr();
+        } while (!depot_.compare_exchange_weak(top, top.with(head), 
+                                              std::memory_order_release, 
+                                              std::memory_order_relaxed));
+    }
+    
+    // Tagged head: a batch popped and re-pushed by another thread between our
+    // load and CAS changes the tag, so a stale next_batch is never installed
+    FreeNode* pop_batch() noexcept {
+        TaggedPtr<FreeNode> top = depot_.load(std::memory_order_acquire);
+        while (top.ptr() && !depot_.compare_exchange_weak(top, top.with(top.ptr()->next_batch), 
+                                                         std::memory_order_acquire, 
+                                                         std::memory_order_acquire)) {
+        }
+        return top.ptr();
+    }
+
+public:
+    class Cache {
+    private:
+        ThreadCachedPool* pool_;
+        FreeNode* loaded_{nullptr};    // Allocation source
+        size_t loaded_count_{0};
+        FreeNode* previous_{nullptr};  // Spare batch absorbing frees
+        size_t previous_count_{0};
+    
+    public:
+        explicit Cache(ThreadCachedPool& pool) noexcept : pool_(&pool) {}
+        
+        ~Cache() { flush(); }
+        
+        T* allocate() noexcept {
+            if (loaded_count_ == 0) {
+                if (previous_count_ > 0) {
+                    std::swap(loaded_, previous_);
+                    std::swap(loaded_count_, previous_count_);
+                } else {
+                    loaded_ = pool_->pop_batch();
+                    if (!loaded_) {
+                        return nullptr;
+                    }
+                    loaded_count_ = loaded_->batch_size;
+                }
+            }
+            
+            FreeNode* node = loaded_;
+            loaded_ = node->next;
+            --loaded_count_;
+            return reinterpret_cast<T*>(node);
+        }
+        
+        void deallocate(T* ptr) noexcept {
+            if (!ptr) return;
+            
+            if (loaded_count_ == BatchSize) {
+                if (previous_count_ > 0) {
+                    pool_->push_batch(previous_, previous_count_);
+                }
+                previous_ = loaded_;
+                previous_count_ = loaded_count_;
+                loaded_ = nullptr;
+                loaded_count_ = 0;
+            }
+            
+            FreeNode* node = reinterpret_cast<FreeNode*>(ptr);
+            node->next = loaded_;
+            loaded_ = node;
+            ++loaded_count_;
+        }
+        
+        template<typename... Args>
+        T* construct(Args&&... args) {
+            T* ptr = allocate();
+            if (ptr) {
+                new (ptr) T(std::forward<Args>(args)...);
+            }
+            return ptr;
+        }
+        
+        void destroy(T* ptr) {
+            if (ptr) {
+                ptr->~T();
+                deallocate(ptr);
+            }
+        }
+        
+        // Returns every cached object to the shared depot
+        void flush() noexcept {
+            if (loaded_count_ > 0) {
+                pool_->push_batch(loaded_, loaded_count_);
+            }
+            if (previous_count_ > 0) {
+                pool_->push_batch(previous_, previous_count_);
+            }
+            loaded_ = previous_ = nullptr;
+            loaded_count_ = previous_count_ = 0;
+        }
+        
+        size_t cached_count() const noexcept { return loaded_count_ + previous_count_; }
+        
+        Cache(const Cache&) = delete;
+        Cache& operator=(const Cache&) = delete;
+    };
+    
+    explicit ThreadCachedPool(size_t pool_size = 1000000) : pool_size_(pool_size) {
+        size_t obj_size = std::max(sizeof(T), sizeof(FreeNode));
+        obj_size = (obj_size + ALIGNMENT - 1) & ~(ALIGNMENT - 1);
+        
+        void* chunk = std::aligned_alloc(ALIGNMENT, std::max<size_t>(pool_size_ * obj_size, ALIGNMENT));
+        if (!chunk) {
+            return;
+        }
+        allocated_chunks_.push_back(chunk);
+        
+        // Carve the chunk into depot batches
+        char* ptr = static_cast<char*>(chunk);
+        for (size_t done = 0; done < pool_size_;) {
+            size_t count = std::min(BatchSize, pool_size_ - done);
+            FreeNode* head = reinterpret_cast<FreeNode*>(ptr + done * obj_size);
+            for (size_t i = 0; i < count; ++i) {
+                FreeNode* node = reinterpret_cast<FreeNode*>(ptr + (done + i) * obj_size);
+                node->next = (i + 1 < count) 
+                    ? reinterpret_cast<FreeNode*>(ptr + (done + i + 1) * obj_size) : nullptr;
+            }
+            push_batch(head, count);
+            done += count;
+        }
+    }
+    
+    ~ThreadCachedPool() {
+        for (void* chunk : allocated_chunks_) {
+            std::free(chunk);
+        }
+    }
+    
+    size_t capacity() const noexcept { return pool_size_; }
+    
+    ThreadCachedPool(const ThreadCachedPool&) = delete;
+    ThreadCachedPool& operator=(const ThreadCachedPool&) = delete;
+};
+
+} // namespace nanotrader
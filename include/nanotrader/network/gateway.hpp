@@ -0,0 +1,84 @@
+#pragma once
+
+#include "nanotrader/core/matching_engine.hpp"
+#include "gateway_transport.hpp"
+#include "socket_transport.hpp"
+#include "wire_protocol.hpp"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <thread>
+
+namespace nanotrader {
+
+// Order-entry gateway feeding one MatchingEngine. The transport moves bytes: by
+// default epoll_wait(0)/recvmmsg(MSG_DONTWAIT) sockets, or io_uring with multishot
+// recv into registered buffers (GatewayConfig::backend), or any GatewayTransport
+// passed in, e.g. an AF_XDP or DPDK queue. The gateway decodes each message straight
+// from the transport's buffer into an input-ring slot. poll() never blocks; when the
+// ring is full, unread bytes stay with the transport and are retried on the next
+// poll, so nothing is dropped. The gateway is the engine's only producer.
+// New orders are stamped with the account bound to the sender's address
+// (GatewayConfig::peer_accounts), whatever account the message names.
+class Gateway : private ReceiveHandler {
+private:
+    MatchingEngine& engine_;
+    GatewayConfig config_;
+    std::unique_ptr<GatewayTransport> transport_;
+    std::vector<PeerAccount> peer_accounts_;  // Sorted by address
+    
+    // State of the poll() in progress, for on_receive()
+    size_t budget_{0};
+    size_t submitted_{0};
+    Timestamp received_{0};
+    
+    std::thread worker_;
+    std::atomic<bool> running_{false};
+    
+    std::atomic<uint64_t> messages_{0};
+    std::atomic<uint64_t> invalid_messages_{0};
+    std::atomic<uint64_t> protocol_errors_{0};
+    std::atomic<uint64_t> ring_full_{0};
+    
+    // Decodes whole messages from data into ring slots; stops at a partial message,
+    // broken framing (malformed) or a full ring (ring_full)
+    size_t submit_from(const char* data, size_t size, size_t budget, Timestamp received, AccountId account,
+                       size_t& consumed, bool& malformed, bool& ring_full);
+    AccountId account_for(uint32_t peer) const noexcept;
+    ReceiveResult on_receive(const char* data, size_t size, bool whole_messages, uint32_t peer) override;
+
+public:
+    static constexpr size_t MAX_DATAGRAM_BATCH = SocketTransport::MAX_DATAGRAM_BATCH;
+    
+    Gateway(MatchingEngine& engine, GatewayConfig config);  // Transport from config.backend
+    Gateway(MatchingEngine& engine, GatewayConfig config, std::unique_ptr<GatewayTransport> transport);
+    ~Gateway();
+    
+    // Binds (and listens for TCP); false on any socket error, on non-Linux builds, or
+    // when the io_uring backend isn't supported by the running kernel
+    bool open();
+    void close();
+    bool is_open() const;
+    uint16_t local_port() const;
+    const char* backend_name() const;
+    
+    // One non-blocking iteration; returns the number of requests submitted
+    size_t poll();
+    
+    // Busy-polls poll() on an owned thread until stop()
+    void start();
+    void stop();
+    
+    uint64_t get_message_count() const;
+    uint64_t get_invalid_message_count() const;  // Well framed, rejected at decode
+    uint64_t get_protocol_error_count() const;   // Broken framing; TCP client dropped
+    uint64_t get_ring_full_count() const;        // Polls that stopped on a full input ring
+    uint64_t get_read_count() const;             // Receive calls/completions that returned data
+    size_t get_connection_count() const;
+    
+    Gateway(const Gateway&) = delete;
+    Gateway& operator=(const Gateway&) = delete;
+};
+
+} // namespace nanotrader
\ No newline at end of file
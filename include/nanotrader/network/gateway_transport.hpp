@@ -0,0 +1,92 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace nanotrader {
+
+// A client address and the account (AccountId) its orders trade for
+struct PeerAccount {
+    uint32_t address;  // IPv4, host byte order
+    uint32_t account;
+};
+
+struct GatewayConfig {
+    enum class Transport : uint8_t {
+        Tcp,  // Framed stream per client
+        Udp   // Whole messages per datagram
+    };
+    
+    enum class Backend : uint8_t {
+        Socket,  // Edge-triggered epoll (TCP) / recvmmsg (UDP)
+        IoUring  // Multishot accept/recv into a registered buffer ring, optional SQPOLL
+    };
+    
+    Transport transport = Transport::Tcp;
+    Backend backend = Backend::Socket;
+    std::string bind_address = "0.0.0.0";
+    uint16_t port = 9000;                  // 0 = ephemeral, see local_port()
+    size_t max_connections = 64;
+    size_t receive_buffer_size = 1 << 16;  // Per TCP connection
+    size_t datagram_batch = 32;            // Datagrams per recvmmsg
+    size_t max_datagram_size = 2048;
+    size_t max_requests_per_poll = 1024;   // Bounds one poll() so every client gets a turn
+    int socket_busy_poll_us = 0;           // SO_BUSY_POLL when > 0
+    
+    // Orders trade for the account bound to the client's address here, never the
+    // one on the wire; other clients (and any the transport can't place) get
+    // unknown_peer_account, by default one that account limits reject
+    std::vector<PeerAccount> peer_accounts;
+    uint32_t unknown_peer_account = ~uint32_t{0};  // NO_ACCOUNT
+    
+    // io_uring backend
+    uint32_t uring_entries = 256;          // Submission queue; the completion queue gets 4x
+    uint32_t uring_buffer_count = 256;     // Provided buffers, rounded up to a power of two
+    uint32_t uring_buffer_size = 16384;    // Per buffer; at least max_datagram_size
+    bool uring_sqpoll = false;             // Kernel thread polls the SQ: no io_uring_enter per submit
+    uint32_t uring_sqpoll_idle_ms = 100;   // SQPOLL thread sleeps after this long idle
+    int uring_sqpoll_cpu = -1;             // Pin the SQPOLL thread when >= 0
+};
+
+// What a transport hands received bytes to, with the IPv4 address (host order)
+// they came from, or 0 if the transport can't tell. consumed is how much of data
+// the handler used; a stream transport presents the rest again, ahead of newer bytes.
+// stop ends the current poll (budget spent or input ring full) and leaves the
+// rest for the next one; drop closes a stream whose framing can't be recovered.
+struct ReceiveResult {
+    size_t consumed{0};
+    bool stop{false};
+    bool drop{false};
+};
+
+class ReceiveHandler {
+public:
+    // whole_messages: data is one datagram, so leftovers are not carried over
+    virtual ReceiveResult on_receive(const char* data, size_t size, bool whole_messages, uint32_t peer) = 0;
+
+protected:
+    ~ReceiveHandler() = default;
+};
+
+// Receive side of the gateway. Implementations own their sockets (or queues, for
+// kernel-bypass backends such as AF_XDP or DPDK) and deliver bytes to the handler
+// from poll(), which must never block. Everything but the counters is called from
+// the polling thread only.
+class GatewayTransport {
+public:
+    virtual ~GatewayTransport() = default;
+    
+    virtual bool open(const GatewayConfig& config) = 0;
+    virtual void close() = 0;
+    virtual bool is_open() const = 0;
+    virtual uint16_t local_port() const = 0;
+    virtual void poll(ReceiveHandler& handler) = 0;
+    
+    virtual const char* name() const = 0;
+    virtual size_t connection_count() const = 0;
+    virtual uint64_t read_count() const = 0;  // Receive calls or completions that returned data
+};
+
+} // namespace nanotrader
\ No newline at end of file
@@ -0,0 +1,114 @@
+#pragma once
+
+#include "gateway_transport.hpp"
+#include <atomic>
+#include <memory>
+#include <vector>
+
+struct io_uring_sqe;
+struct io_uring_cqe;
+struct io_uring_buf_ring;
+
+namespace nanotrader {
+
+// io_uring backend, driven through the raw syscalls (no liburing). One multishot
+// accept plus one multishot recv per connection (or one multishot recvmsg for
+// the UDP socket, so every datagram comes with its sender) stay armed, and the
+// kernel picks receive buffers from a registered buffer ring, so steady-state
+// polling is just reading the completion queue: no syscall per packet, and
+// messages are decoded straight out of the kernel-filled buffer. Only a message
+// split across buffers, or bytes left behind when the handler stops, are copied
+// (into a per-connection stash). With uring_sqpoll the occasional re-arm is
+// picked up by the kernel's SQ thread as well.
+class IoUringTransport final : public GatewayTransport {
+private:
+    struct RecvMsg;
+    
+    struct Connection {
+        int fd{-1};
+        uint32_t peer{0};         // Client address, host order; UDP: sender of the datagram being read
+        uint32_t generation{0};   // In the recv tag, so completions for a reused slot are ignored
+        bool armed{false};        // A multishot recv is outstanding
+        bool backlogged{false};   // Stash holds bytes the handler stopped on
+        std::vector<char> stash;  // Presented ahead of the next buffer
+    };
+    
+    GatewayConfig config_;
+    bool datagram_{false};
+    int ring_fd_{-1};
+    int socket_fd_{-1};
+    uint16_t local_port_{0};
+    bool sqpoll_{false};
+    
+    // Mapped submission/completion rings
+    void* sq_ring_{nullptr};
+    size_t sq_ring_size_{0};
+    void* cq_ring_{nullptr};
+    size_t cq_ring_size_{0};
+    io_uring_sqe* sqes_{nullptr};
+    size_t sqes_size_{0};
+    uint32_t* sq_head_{nullptr};
+    uint32_t* sq_tail_{nullptr};
+    uint32_t* sq_flags_{nullptr};
+    uint32_t* sq_array_{nullptr};
+    uint32_t sq_mask_{0};
+    uint32_t sq_entries_{0};
+    uint32_t sq_local_tail_{0}; // Filled entries; published to the kernel by submit()
+    uint32_t sq_pending_{0};    // Filled since the last submit()
+    uint32_t* cq_head_{nullptr};
+    uint32_t* cq_tail_{nullptr};
+    io_uring_cqe* cqes_{nullptr};
+    uint32_t cq_mask_{0};
+    
+    // Provided buffers: buffer_count_ slices of one slab, handed out by the kernel
+    io_uring_buf_ring* buf_ring_{nullptr};
+    size_t buf_ring_size_{0};
+    char* buffers_{nullptr};
+    size_t buffers_size_{0};
+    uint32_t buffer_count_{0};
+    uint32_t buffer_size_{0};
+    uint16_t buf_tail_{0};      // Published to the kernel once per poll
+    std::unique_ptr<RecvMsg> recv_msg_;  // UDP only
+    
+    std::vector<Connection> connections_;  // TCP: fixed slots; UDP: the socket alone
+    std::atomic<size_t> connection_count_{0};
+    bool accept_armed_{false};
+    bool rearm_{false};         // Some multishot request ended and needs resubmitting
+    bool backlog_{false};       // Some connection is backlogged
+    
+    std::atomic<uint64_t> reads_{0};
+    
+    bool setup_ring();
+    bool setup_buffers();
+    io_uring_sqe* next_sqe();
+    void submit();
+    void arm_accept();
+    void arm_recv(uint32_t slot);
+    void rearm();
+    void recycle(uint16_t buffer_id);
+    bool complete(const io_uring_cqe& cqe, ReceiveHandler& handler);  // true: handler stopped
+    void accept_client(int fd);
+    bool deliver(Connection& connection, const char* data, size_t size, ReceiveHandler& handler);
+    void close_connection(Connection& connection);
+
+public:
+    IoUringTransport();
+    ~IoUringTransport() override;
+    
+    // False if the kernel lacks io_uring, provided buffer rings or multishot recv (< 6.0)
+    bool open(const GatewayConfig& config) override;
+    void close() override;
+    bool is_open() const override;
+    uint16_t local_port() const override;
+    void poll(ReceiveHandler& handler) override;
+    
+    const char* name() const override;
+    size_t connection_count() const override;
+    uint64_t read_count() const override;
+    bool using_sqpoll() const;
+    
+    IoUringTransport(const IoUringTransport&) = delete;
+    IoUringTransport& operator=(const IoUringTransport&) = delete;
+};
+
+} // namespace nanotrader
\ No newline at end of file
@@ -0,0 +1,231 @@
+#pragma once
+
+#include "nanotrader/core/matching_engine.hpp"
+#include "nanotrader/memory/ring_buffer.hpp"
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace nanotrader {
+
+// Layout of the order-entry segment shared by ShmGateway and its ShmClients: a
+// versioned header followed by a fixed number of lanes. Each lane is one client's
+// SPSC request ring into the engine and SPSC report ring back. Only ring indices
+// and fixed-size records live in it, never pointers, so every process may map
+// it at a different address; the header describes the layout so a client built
+// against a different one refuses to attach. Any process that can map the segment
+// can write to every lane, so its permissions are what keep clients apart.
+namespace shm {
+
+constexpr uint64_t MAGIC = 0x454e414c4d53544eull;  // "NTSMLANE"
+constexpr uint32_t VERSION = 2;
+constexpr size_t REQUEST_SLOTS = 1024;  // Per lane, power of two
+constexpr size_t REPORT_SLOTS = 4096;   // Per lane, power of two; results plus their trades
+constexpr size_t MAX_LANES = 1024;
+
+// One request per cache line, decoupled from Order's in-memory layout
+struct alignas(64) Request {
+    OrderId order_id;
+    int64_t price;           // Raw units
+    Quantity quantity;
+    Quantity new_quantity;   // Modify / Replace
+    Symbol symbol;           // No account: the host applies the lane's
+    uint8_t request_type;    // OrderRequest::Type
+    uint8_t side;
+    uint8_t order_type;
+    
+    static Request from_request(const OrderRequest& request) noexcept;
+    // False if a field is out of range; the host skips the request
+    bool to_request(OrderRequest& out, Timestamp received, AccountId account) const noexcept;
+};
+
+// Report ring entries: each result is one Result record followed by trade_count
+// Trade records, published in order
+struct alignas(64) Report {
+    enum class Kind : uint8_t { Result, Trade };
+    
+    Kind kind{Kind::Result};
+    MatchResult::Status status{MatchResult::Status::Rejected};  // Result
+    uint32_t trade_count{0};   // Result: Trade records that follow
+    OrderId order_id{0};       // Result
+    Trade trade{};             // Trade
+};
+
+static_assert(sizeof(Request) == 64 && sizeof(Report) == 64, "One record per cache line");
+static_assert(std::is_trivially_copyable_v<Request> && std::is_trivially_copyable_v<Report>,
+              "Records cross the process boundary as bytes");
+static_assert(std::atomic<size_t>::is_always_lock_free && std::atomic<uint32_t>::is_always_lock_free,
+              "Shared rings need address-free atomics");
+
+enum LaneState : uint32_t {
+    Free = 0,     // Claimable by a client
+    Claimed = 1,  // Owned by one client
+    Closing = 2   // Released by its client; the host resets it once nothing is in flight
+};
+
+struct Lane {
+    alignas(64) std::atomic<uint32_t> state{Free};
+    std::atomic<uint32_t> owner_pid{0};    // Checked by the host for clients that exit without releasing
+    SPSCRingBuffer<Request, REQUEST_SLOTS> requests;  // Client produces, host consumes
+    SPSCRingBuffer<Report, REPORT_SLOTS> reports;     // Host produces, client consumes
+};
+
+struct alignas(64) SegmentHeader {
+    uint64_t magic;
+    uint32_t version;
+    uint32_t lane_count;
+    uint32_t request_slots;
+    uint32_t report_slots;
+    uint32_t lane_size;           // sizeof(Lane), catching record or ring layout drift
+    uint32_t host_pid;
+    uint64_t lane_offset;         // From the start of the segment
+    std::atomic<uint32_t> ready;  // Set last, once every lane is built
+};
+
+constexpr size_t segment_size(size_t lane_count) noexcept {
+    return sizeof(SegmentHeader) + lane_count * sizeof(Lane);
+}
+
+} // namespace shm
+
+struct ShmConfig {
+    std::string name = "/nanotrader";    // shm_open name
+    size_t lanes = 16;                   // Client processes served at once, at most shm::MAX_LANES
+    unsigned permissions = 0600;         // Of the segment; clients need read-write
+    size_t max_requests_per_poll = 1024;
+    size_t max_requests_per_lane = 64;   // Per poll, so one busy client can't starve the rest
+    size_t max_in_flight_per_lane = 256; // Rounded up to a power of two; results held back per lane at most
+    size_t liveness_check_polls = 4096;  // Polls between checks that every lane's owner is still running
+    std::vector<AccountId> lane_accounts; // Account each lane's orders trade for; NO_ACCOUNT past the end
+};
+
+// Cross-process order entry: creates the segment and moves requests from the
+// lanes, visited round-robin, into the engine's input ring, and each result back
+// to the lane its request came from. Like Gateway it must be the engine's only
+// producer, and it is also the only consumer of its results. A result its lane
+// has no report room for is held on the host, in order, until the client reads;
+// a lane only takes requests while it has fewer than max_in_flight_per_lane
+// results owed, so every one has a place to wait and a client that stops reading
+// stalls itself, not the others. A lane whose owner process has exited without
+// releasing it is reclaimed like a released one.
+//
+// poll() never blocks. Run it on the matching thread next to process_batch() for
+// the fewest handoffs, or on its own thread with start().
+class ShmGateway {
+private:
+    MatchingEngine& engine_;
+    ShmConfig config_;
+    void* segment_{nullptr};
+    size_t segment_size_{0};
+    shm::Lane* lanes_{nullptr};
+    
+    // Lane of every request in the engine, in submission order (= result order)
+    std::vector<uint16_t> routes_;
+    size_t route_head_{0};
+    size_t route_tail_{0};
+    std::vector<uint32_t> in_flight_;  // Per lane, held results included
+    size_t next_lane_{0};
+    uint64_t polls_{0};
+    
+    // Results waiting for report room, a ring of max_in_flight_per_lane per lane
+    struct Backlog {
+        size_t head{0};
+        size_t tail{0};
+        size_t next{0};  // Records of the head result already pushed
+    };
+    std::vector<MatchResult> held_;
+    std::vector<Backlog> backlogs_;
+    size_t held_mask_{0};
+    size_t held_lanes_{0};  // Lanes with a non-empty backlog
+    std::array<shm::Report, 64> staging_;
+    
+    std::thread worker_;
+    std::atomic<bool> running_{false};
+    
+    std::atomic<uint64_t> requests_{0};
+    std::atomic<uint64_t> results_{0};
+    std::atomic<uint64_t> invalid_requests_{0};
+    std::atomic<uint64_t> discarded_results_{0};
+    std::atomic<uint64_t> report_stalls_{0};
+    std::atomic<uint64_t> abandoned_lanes_{0};
+    
+    void deliver();
+    bool push_records(shm::Lane& lane, const MatchResult& result, size_t& next);
+    void flush_backlog(size_t lane);
+    size_t admit(size_t lane, size_t budget, Timestamp received);
+    void recycle(size_t lane);
+    void reclaim_abandoned();
+
+public:
+    ShmGateway(MatchingEngine& engine, ShmConfig config);
+    ~ShmGateway();
+    
+    // Creates the segment, replacing any stale one under the name (clients still
+    // mapping that one must reconnect); false on any error or on non-Linux builds
+    bool open();
+    void close();  // Unmaps and unlinks the segment
+    bool is_open() const;
+    const std::string& name() const;
+    
+    // One non-blocking iteration: results out, then requests in. Returns the
+    // number of requests submitted.
+    size_t poll();
+    
+    // Busy-polls poll() on an owned thread until stop()
+    void start();
+    void stop();
+    
+    size_t get_client_count() const;
+    uint64_t get_request_count() const;
+    uint64_t get_result_count() const;            // Delivered to a lane in full
+    uint64_t get_invalid_request_count() const;   // Out-of-range fields, skipped
+    uint64_t get_discarded_result_count() const;  // Their client disconnected first
+    uint64_t get_report_stall_count() const;      // Results held back for lack of report room
+    uint64_t get_abandoned_lane_count() const;    // Reclaimed from clients that exited while connected
+    
+    ShmGateway(const ShmGateway&) = delete;
+    ShmGateway& operator=(const ShmGateway&) = delete;
+};
+
+// One client process's lane. Everything runs on the caller's thread and never
+// blocks; results come back in submission order, each with all its trades.
+class ShmClient {
+private:
+    void* segment_{nullptr};
+    size_t segment_size_{0};
+    shm::Lane* lane_{nullptr};
+    size_t lane_index_{0};
+    
+    // Result whose trades are still arriving
+    MatchResult partial_;
+    uint32_t partial_trades_{0};
+    bool has_partial_{false};
+
+public:
+    ShmClient() = default;
+    ~ShmClient();
+    
+    static constexpr size_t ANY_LANE = ~size_t{0};
+    
+    // Maps the named segment, checks its header and claims the given lane (its
+    // account is the host's ShmConfig::lane_accounts entry), or the first free one;
+    // false if there is no such segment, its layout differs from this build's, or
+    // the lane is taken (every lane, for ANY_LANE)
+    bool connect(const std::string& name, size_t lane = ANY_LANE);
+    void disconnect();  // Hands the lane back; results still owed are discarded
+    bool is_connected() const;
+    size_t lane_index() const;
+    
+    bool submit(const OrderRequest& request);  // False while the request ring is full
+    bool get_result(MatchResult& result);
+    
+    ShmClient(const ShmClient&) = delete;
+    ShmClient& operator=(const ShmClient&) = delete;
+};
+
+} // namespace nanotrader
\ No newline at end of file
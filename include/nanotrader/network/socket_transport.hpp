@@ -0,0 +1,73 @@
+#pragma once
+
+#include "gateway_transport.hpp"
+#include <atomic>
+#include <vector>
+
+namespace nanotrader {
+
+// Binds (and for TCP, listens) a non-blocking socket per config; returns the fd or
+// -1, filling local_port. Shared by the socket-based backends.
+int open_gateway_socket(const GatewayConfig& config, uint16_t& local_port);
+void tune_gateway_connection(int fd, const GatewayConfig& config);  // TCP_NODELAY, SO_BUSY_POLL
+
+// Readiness-based backend: epoll_wait(0) plus recv() per connection for TCP,
+// recvmmsg(MSG_DONTWAIT) batches for UDP. Bytes are copied once, into a
+// per-connection buffer (or datagram slot), and decoded from there.
+class SocketTransport final : public GatewayTransport {
+private:
+    struct Connection {
+        int fd{-1};
+        uint32_t peer{0};  // Client address, host order
+        std::vector<char> buffer;
+        size_t begin{0};
+        size_t end{0};
+        bool readable{false};  // Edge-triggered: set by epoll, cleared at EAGAIN
+    };
+    
+    GatewayConfig config_;
+    int listen_fd_{-1};
+    int epoll_fd_{-1};
+    uint16_t local_port_{0};
+    
+    std::vector<Connection> connections_;  // Fixed slots; the epoll tag is the slot index
+    std::atomic<size_t> connection_count_{0};
+    size_t next_connection_{0};            // Round-robin start so no client is starved
+    
+    // UDP: received datagrams not yet fully delivered (handler stopped)
+    std::vector<std::vector<char>> datagrams_;
+    std::vector<size_t> datagram_sizes_;
+    std::vector<uint32_t> datagram_peers_;
+    size_t datagram_next_{0};
+    size_t datagram_count_{0};
+    size_t datagram_offset_{0};
+    
+    std::atomic<uint64_t> reads_{0};
+    
+    void poll_tcp(ReceiveHandler& handler);
+    void poll_udp(ReceiveHandler& handler);
+    void accept_clients();
+    bool service(Connection& connection, ReceiveHandler& handler);  // true: handler stopped
+    void close_connection(Connection& connection);
+
+public:
+    static constexpr size_t MAX_DATAGRAM_BATCH = 64;
+    
+    SocketTransport() = default;
+    ~SocketTransport() override;
+    
+    bool open(const GatewayConfig& config) override;
+    void close() override;
+    bool is_open() const override;
+    uint16_t local_port() const override;
+    void poll(ReceiveHandler& handler) override;
+    
+    const char* name() const override;
+    size_t connection_count() const override;
+    uint64_t read_count() const override;
+    
+    SocketTransport(const SocketTransport&) = delete;
+    SocketTransport& operator=(const SocketTransport&) = delete;
+};
+
+} // namespace nanotrader
\ No newline at end of file
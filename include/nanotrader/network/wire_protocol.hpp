@@ -0,0 +1,211 @@
+#pragma once
+
+#include "nanotrader/core/matching_engine.hpp"
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace nanotrader {
+namespace wire {
+
+// Fixed-layout binary order-entry protocol (OUCH-style). Fields are little-endian
+// and unpadded; every message starts with a 3-byte header (uint16 length covering
+// the whole message, then a type byte). Decoding reads fields straight out of the
+// receive buffer into the caller's OrderRequest, typically an input-ring slot.
+static_assert(std::endian::native == std::endian::little, "Wire fields are read in host order");
+
+enum class MessageType : char {
+    EnterOrder = 'O',
+    CancelOrder = 'X',
+    ModifyOrder = 'U',
+    ReplaceOrder = 'R'
+};
+
+constexpr size_t HEADER_SIZE = 3;
+constexpr size_t LENGTH = 0;
+constexpr size_t TYPE = 2;
+
+namespace enter {
+    constexpr size_t ORDER_ID = 3;
+    constexpr size_t SYMBOL = 11;
+    constexpr size_t PRICE = 15;      // Price raw units (1e-6)
+    constexpr size_t QUANTITY = 23;
+    constexpr size_t SIDE = 31;       // 'B' or 'S'
+    constexpr size_t ORDER_TYPE = 32; // 'L'imit, 'M'arket, 'I'OC, 'F'OK
+    constexpr size_t ACCOUNT = 33;    // Decoded, but Gateway trades for the sender's bound account
+    constexpr size_t SIZE = 37;
+}
+
+namespace cancel {
+    constexpr size_t ORDER_ID = 3;
+    constexpr size_t SYMBOL = 11;
+    constexpr size_t SIZE = 15;
+}
+
+namespace modify {
+    constexpr size_t ORDER_ID = 3;
+    constexpr size_t SYMBOL = 11;
+    constexpr size_t NEW_QUANTITY = 15;
+    constexpr size_t SIZE = 23;
+}
+
+namespace replace {
+    constexpr size_t ORDER_ID = 3;
+    constexpr size_t SYMBOL = 11;
+    constexpr size_t NEW_PRICE = 15;     // Price raw units (1e-6)
+    constexpr size_t NEW_QUANTITY = 23;
+    constexpr size_t SIZE = 31;
+}
+
+constexpr size_t MAX_MESSAGE_SIZE = 1024;  // Longer lengths mean the stream is corrupt
+
+enum class DecodeStatus : uint8_t {
+    Ok,          // out filled, consumed bytes used
+    Incomplete,  // Need more bytes
+    Invalid,     // Well framed but unusable (unknown type, bad field): skip consumed bytes
+    Malformed    // Framing is broken; the stream cannot be resynchronised
+};
+
+template<typename T>
+inline T load(const char* ptr) noexcept {
+    T value;
+    std::memcpy(&value, ptr, sizeof(T));
+    return value;
+}
+
+template<typename T>
+inline void store(char* ptr, T value) noexcept {
+    std::memcpy(ptr, &value, sizeof(T));
+}
+
+inline bool decode_side(char code, Side& side) noexcept {
+    switch (code) {
+        case 'B': side = Side::Buy; return true;
+        case 'S': side = Side::Sell; return true;
+        default: return false;
+    }
+}
+
+inline bool decode_order_type(char code, OrderType& type) noexcept {
+    switch (code) {
+        case 'L': type = OrderType::Limit; return true;
+        case 'M': type = OrderType::Market; return true;
+        case 'I': type = OrderType::IOC; return true;
+        case 'F': type = OrderType::FOK; return true;
+        default: return false;
+    }
+}
+
+inline DecodeStatus decode(const char* data, size_t size, OrderRequest& out, size_t& consumed, 
+                           Timestamp received) noexcept {
+    if (size < HEADER_SIZE) {
+        return DecodeStatus::Incomplete;
+    }
+    
+    size_t length = load<uint16_t>(data + LENGTH);
+    if (length < HEADER_SIZE || length > MAX_MESSAGE_SIZE) {
+        return DecodeStatus::Malformed;
+    }
+    if (size < length) {
+        return DecodeStatus::Incomplete;
+    }
+    consumed = length;
+    
+    switch (static_cast<MessageType>(data[TYPE])) {
+        case MessageType::EnterOrder: {
+            Side side;
+            OrderType type;
+            if (length != enter::SIZE) return DecodeStatus::Malformed;
+            if (!decode_side(data[enter::SIDE], side) || 
+                !decode_order_type(data[enter::ORDER_TYPE], type)) {
+                return DecodeStatus::Invalid;
+            }
+            out.type = OrderRequest::Type::Add;
+            out.account = load<uint32_t>(data + enter::ACCOUNT);
+            out.order = Order(load<uint64_t>(data + enter::ORDER_ID), load<uint32_t>(data + enter::SYMBOL), 
+                              Price(load<int64_t>(data + enter::PRICE)), load<uint64_t>(data + enter::QUANTITY), 
+                              side, type, received);
+            out.new_quantity = 0;
+            return DecodeStatus::Ok;
+        }
+        case MessageType::CancelOrder:
+            if (length != cancel::SIZE) return DecodeStatus::Malformed;
+            out.type = OrderRequest::Type::Cancel;
+            out.account = 0;
+            out.order = Order();
+            out.order.id = load<uint64_t>(data + cancel::ORDER_ID);
+            out.order.symbol = load<uint32_t>(data + cancel::SYMBOL);
+            out.order.timestamp = received;
+            out.new_quantity = 0;
+            return DecodeStatus::Ok;
+        case MessageType::ModifyOrder:
+            if (length != modify::SIZE) return DecodeStatus::Malformed;
+            out.type = OrderRequest::Type::Modify;
+            out.account = 0;
+            out.order = Order();
+            out.order.id = load<uint64_t>(data + modify::ORDER_ID);
+            out.order.symbol = load<uint32_t>(data + modify::SYMBOL);
+            out.order.timestamp = received;
+            out.new_quantity = load<uint64_t>(data + modify::NEW_QUANTITY);
+            return DecodeStatus::Ok;
+        case MessageType::ReplaceOrder:
+            if (length != replace::SIZE) return DecodeStatus::Malformed;
+            out.type = OrderRequest::Type::Replace;
+            out.account = 0;
+            out.order = Order();
+            out.order.id = load<uint64_t>(data + replace::ORDER_ID);
+            out.order.symbol = load<uint32_t>(data + replace::SYMBOL);
+            out.order.price = Price(load<int64_t>(data + replace::NEW_PRICE));
+            out.order.timestamp = received;
+            out.new_quantity = load<uint64_t>(data + replace::NEW_QUANTITY);
+            return DecodeStatus::Ok;
+    }
+    return DecodeStatus::Invalid;
+}
+
+// Client side / tests: writes one message and returns its size (out needs enter::SIZE bytes)
+inline size_t encode(const OrderRequest& request, char* out) noexcept {
+    static constexpr char SIDE_CODES[] = {'B', 'S'};
+    static constexpr char TYPE_CODES[] = {'L', 'M', 'I', 'F'};
+    
+    const Order& order = request.order;
+    switch (request.type) {
+        case OrderRequest::Type::Add:
+            store<uint16_t>(out + LENGTH, static_cast<uint16_t>(enter::SIZE));
+            out[TYPE] = static_cast<char>(MessageType::EnterOrder);
+            store<uint64_t>(out + enter::ORDER_ID, order.id);
+            store<uint32_t>(out + enter::SYMBOL, order.symbol);
+            store<int64_t>(out + enter::PRICE, order.price.raw_value());
+            store<uint64_t>(out + enter::QUANTITY, order.quantity);
+            out[enter::SIDE] = SIDE_CODES[static_cast<size_t>(order.side)];
+            out[enter::ORDER_TYPE] = TYPE_CODES[static_cast<size_t>(order.type)];
+            store<uint32_t>(out + enter::ACCOUNT, request.account);
+            return enter::SIZE;
+        case OrderRequest::Type::Cancel:
+            store<uint16_t>(out + LENGTH, static_cast<uint16_t>(cancel::SIZE));
+            out[TYPE] = static_cast<char>(MessageType::CancelOrder);
+            store<uint64_t>(out + cancel::ORDER_ID, order.id);
+            store<uint32_t>(out + cancel::SYMBOL, order.symbol);
+            return cancel::SIZE;
+        case OrderRequest::Type::Modify:
+            store<uint16_t>(out + LENGTH, static_cast<uint16_t>(modify::SIZE));
+            out[TYPE] = static_cast<char>(MessageType::ModifyOrder);
+            store<uint64_t>(out + modify::ORDER_ID, order.id);
+            store<uint32_t>(out + modify::SYMBOL, order.symbol);
+            store<uint64_t>(out + modify::NEW_QUANTITY, request.new_quantity);
+            return modify::SIZE;
+        case OrderRequest::Type::Replace:
+            store<uint16_t>(out + LENGTH, static_cast<uint16_t>(replace::SIZE));
+            out[TYPE] = static_cast<char>(MessageType::ReplaceOrder);
+            store<uint64_t>(out + replace::ORDER_ID, order.id);
+            store<uint32_t>(out + replace::SYMBOL, order.symbol);
+            store<int64_t>(out + replace::NEW_PRICE, order.price.raw_value());
+            store<uint64_t>(out + replace::NEW_QUANTITY, request.new_quantity);
+            return replace::SIZE;
+    }
+    return 0;
+}
+
+} // namespace wire
+} // namespace nanotrader
\ No newline at end of file
@@ -0,0 +1,209 @@
+#pragma once
+
+#include "nanotrader/core/matching_engine.hpp"
+#include "nanotrader/memory/ring_buffer.hpp"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace nanotrader {
+
+// On-disk form of one accepted OrderRequest. Fixed 64 bytes, host byte order,
+// FNV-1a checksum over everything before it so a torn tail is detected on read.
+struct JournalRecord {
+    uint64_t sequence;
+    uint64_t order_id;
+    int64_t price;
+    uint64_t quantity;
+    uint64_t new_quantity;
+    uint64_t timestamp;
+    uint32_t symbol;
+    uint8_t request_type;
+    uint8_t side;
+    uint8_t order_type;
+    uint8_t reserved0;
+    uint32_t account;
+    uint32_t checksum;
+    
+    static JournalRecord from_request(const OrderRequest& request, uint64_t sequence) noexcept;
+    OrderRequest to_request() const noexcept;
+    
+    uint32_t compute_checksum() const noexcept;
+    bool valid() const noexcept { return checksum == compute_checksum(); }
+};
+
+static_assert(sizeof(JournalRecord) == 64, "JournalRecord layout is part of the file format");
+
+// Written once at offset 0; padded to a record so records stay 64-byte aligned
+struct JournalHeader {
+    static constexpr char MAGIC[8] = {'N', 'T', 'J', 'R', 'N', 'L', '\0', '\0'};
+    static constexpr uint32_t VERSION = 1;
+    
+    char magic[8];
+    uint32_t version;
+    uint32_t record_size;
+    uint8_t reserved[48];
+};
+
+static_assert(sizeof(JournalHeader) == sizeof(JournalRecord), "Header occupies one record slot");
+
+// Results sidecar: what the live engine emitted for each journaled request, so a
+// replay can be checked against production rather than against another replay.
+// A ResultDigestHeader, then ResultDigests in sequence order; a crash may leave
+// the tail a few results behind the journal.
+struct ResultDigest {
+    uint64_t sequence;
+    uint64_t digest;  // result_digest() of the MatchResult
+};
+
+struct ResultDigestHeader {
+    static constexpr char MAGIC[8] = {'N', 'T', 'R', 'S', 'L', 'T', '\0', '\0'};
+    static constexpr uint32_t VERSION = 1;
+    
+    char magic[8];
+    uint32_t version;
+    uint32_t record_size;
+};
+
+static_assert(sizeof(ResultDigest) == 16 && sizeof(ResultDigestHeader) == 16, "Sidecar layout is part of the file format");
+
+// FNV-style fingerprint of status, order ID and every trade's IDs, price and quantity.
+// Trade timestamps are wall-clock and left out, so a faithful replay digests the same.
+uint64_t result_digest(const MatchResult& result) noexcept;
+
+// Reads a whole results sidecar; false if it isn't one. A torn final entry is dropped.
+bool read_result_digests(const std::string& path, std::vector<ResultDigest>& digests);
+
+struct JournalConfig {
+    enum class Durability : uint8_t {
+        Buffered,     // write() only: survives a process crash, not a power loss
+        GroupCommit,  // fdatasync once group_commit_bytes or group_commit_interval is reached
+        EveryBatch    // fdatasync after every drained batch
+    };
+    
+    std::string path;
+    Durability durability = Durability::GroupCommit;
+    size_t group_commit_bytes = 1 << 20;
+    std::chrono::microseconds group_commit_interval{1000};
+    std::chrono::microseconds idle_sleep{50};  // I/O thread back-off when the ring is empty
+    size_t write_batch_records = 4096;         // Records per write() call, at most
+    uint64_t resume_after = 0;                 // Number new records past this too (RecoveryResult::last_sequence)
+    std::string results_path;                  // Results sidecar, written and synced with the journal; empty = off
+};
+
+// Append-only write-ahead journal of accepted OrderRequests. The matching thread
+// only pushes into an SPSC ring (no syscalls); a dedicated I/O thread drains it,
+// writes whole batches and group-commits according to the durability policy.
+// append()/append_batch()/append_result() must come from one thread.
+class Journal {
+public:
+    static constexpr size_t RING_SIZE = 65536;
+
+private:
+    static constexpr size_t PUSH_CHUNK = 64;
+    
+    JournalConfig config_;
+    int fd_{-1};
+    
+    std::unique_ptr<SPSCRingBuffer<JournalRecord, RING_SIZE>> ring_;  // 4 MB: kept off the owner's stack
+    std::unique_ptr<SPSCRingBuffer<ResultDigest, RING_SIZE>> results_;  // Only with a results_path
+    int results_fd_{-1};
+    std::thread io_thread_;
+    std::atomic<bool> running_{false};
+    std::atomic<bool> failed_{false};
+    
+    uint64_t next_sequence_{1};                    // Matching thread only
+    uint64_t next_result_sequence_{1};             // Record the next append_result() belongs to
+    std::atomic<uint64_t> appended_sequence_{0};
+    std::atomic<uint64_t> written_sequence_{0};
+    std::atomic<uint64_t> durable_sequence_{0};
+    std::atomic<uint64_t> stalls_{0};              // Appends that found the ring full
+    std::atomic<uint64_t> syncs_{0};
+    
+    bool recover_tail();
+    bool open_results();
+    void run_io();
+    bool write_all(int fd, const void* data, size_t size);
+    bool sync();
+
+public:
+    explicit Journal(JournalConfig config);
+    ~Journal();
+    
+    // Opens or creates the file, truncates a torn tail, continues the sequence
+    // after the last valid record (or resume_after, if that is later) and starts
+    // the I/O thread
+    bool open();
+    void close();  // Drains the ring, syncs and joins the I/O thread
+    bool is_open() const;
+    bool healthy() const;  // False after any write or sync error
+    
+    // Spins (counting a stall) while the ring is full rather than dropping a record
+    uint64_t append(const OrderRequest& request) noexcept;
+    void append_batch(const OrderRequest* requests, size_t count) noexcept;
+    
+    // The outcome of the oldest appended record that has none yet; results come in
+    // append order. A no-op without a results_path.
+    void append_result(const MatchResult& result) noexcept;
+    
+    // Blocks until everything appended so far is durable under the policy
+    void flush();
+    
+    // Blocks until records through sequence are durable; false if the journal
+    // closes or fails first
+    bool wait_durable(uint64_t sequence);
+    
+    uint64_t appended_sequence() const;
+    uint64_t written_sequence() const;
+    uint64_t durable_sequence() const;
+    uint64_t stall_count() const;
+    uint64_t sync_count() const;
+    const JournalConfig& get_config() const;
+    
+    Journal(const Journal&) = delete;
+    Journal& operator=(const Journal&) = delete;
+};
+
+// Sequential reader for recovery and tools. Stops at the first record that is
+// short or fails its checksum; valid_bytes() is where a writer may resume.
+class JournalReader {
+private:
+    int fd_{-1};
+    bool header_ok_{false};
+    std::vector<JournalRecord> buffer_;
+    size_t buffered_{0};
+    size_t position_{0};
+    uint64_t records_read_{0};
+    uint64_t last_sequence_{0};  // Sequences must strictly increase
+    uint64_t valid_bytes_{0};
+    bool corrupt_{false};
+    
+    bool fill();
+
+public:
+    static constexpr size_t READ_BATCH_RECORDS = 4096;
+    
+    explicit JournalReader(const std::string& path);
+    ~JournalReader();
+    
+    bool is_open() const;  // File opened and header recognised
+    bool next(JournalRecord& record);
+    
+    // Binary-searches the fixed-size records so next() returns the first one with a
+    // sequence above the given one; skipped records count as read
+    bool seek_after(uint64_t sequence);
+    
+    uint64_t records_read() const;
+    uint64_t last_sequence() const;  // Of the last record read, or the one seek_after() left behind
+    uint64_t valid_bytes() const;
+    bool corrupt() const;  // A torn or bad record ended the read (not a clean EOF)
+    
+    JournalReader(const JournalReader&) = delete;
+    JournalReader& operator=(const JournalReader&) = delete;
+};
+
+} // namespace nanotrader
\ No newline at end of file
@@ -0,0 +1,128 @@
+#pragma once
+
+#include "nanotrader/core/matching_engine.hpp"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace nanotrader {
+
+class Journal;
+
+// Snapshot file: header, then per book a SnapshotBook followed by its resting
+// orders, each level's orders contiguous and in FIFO order, then risk_bytes of
+// the attached risk stage's state (RiskStage::save_state). No pointers or
+// offsets are stored, so the file is position-independent and can be used
+// straight from a read-only mapping.
+struct SnapshotHeader {
+    static constexpr char MAGIC[8] = {'N', 'T', 'S', 'N', 'A', 'P', '\0', '\0'};
+    static constexpr uint32_t VERSION = 4;
+    
+    char magic[8];
+    uint32_t version;
+    uint32_t book_count;
+    uint64_t order_count;
+    uint64_t journal_sequence;  // Last journal record reflected in the books
+    uint64_t payload_bytes;     // Everything after the header
+    uint64_t checksum;          // Over the payload
+    uint64_t risk_bytes;        // Trailing risk-stage state, 0 if none was attached
+    uint64_t reserved;
+};
+
+struct SnapshotBook {
+    uint32_t symbol;
+    uint8_t backend;
+    uint8_t reserved[3];
+    int64_t tick_size;
+    uint64_t ladder_width;
+    uint64_t max_ladder_width;
+    uint64_t bitmap_width;
+    uint64_t level_reserve;
+    uint64_t order_reserve;
+    uint64_t order_count;
+};
+
+struct SnapshotOrder {
+    uint64_t id;
+    int64_t price;
+    uint64_t quantity;
+    uint64_t remaining_quantity;
+    uint64_t timestamp;
+    uint8_t side;
+    uint8_t type;
+    uint8_t reserved[6];
+};
+
+static_assert(sizeof(SnapshotHeader) == 64, "Snapshot layout is part of the file format");
+static_assert(sizeof(SnapshotBook) == 64, "Snapshot layout is part of the file format");
+static_assert(sizeof(SnapshotOrder) == 48, "Snapshot layout is part of the file format");
+
+// Serialises engine state into memory. capture() must run where the books are
+// quiescent (on the matching thread between batches, or while stopped); the
+// much slower write() can then run on any thread.
+class SnapshotWriter {
+private:
+    std::vector<char> buffer_;
+    Journal* journal_{nullptr};  // Must be durable through journal_sequence before write()
+    
+    template<typename T>
+    void put(const T& value) {
+        const char* bytes = reinterpret_cast<const char*>(&value);
+        buffer_.insert(buffer_.end(), bytes, bytes + sizeof(T));
+    }
+
+public:
+    // journal_sequence defaults to the attached journal's last appended record;
+    // that journal must then outlive write()
+    void capture(const MatchingEngine& engine);
+    void capture(const MatchingEngine& engine, uint64_t journal_sequence);
+    
+    // Waits until the journal capture() read is durable through journal_sequence,
+    // so the file never runs ahead of the journal on disk, then writes path.tmp,
+    // fsyncs it and renames it over path
+    bool write(const std::string& path) const;
+    
+    const SnapshotHeader& header() const;
+    size_t size_bytes() const;
+};
+
+// Read-only mmap of a snapshot; validates the header and checksum on open
+class SnapshotReader {
+private:
+    void* mapping_{nullptr};
+    size_t size_{0};
+    bool valid_{false};
+
+public:
+    explicit SnapshotReader(const std::string& path);
+    ~SnapshotReader();
+    
+    bool is_open() const;
+    const SnapshotHeader& header() const;
+    
+    // Registers every book with its saved config and rests its orders in FIFO order,
+    // then loads the saved risk state into the engine's risk stage, if both exist
+    bool restore(MatchingEngine& engine) const;
+    
+    SnapshotReader(const SnapshotReader&) = delete;
+    SnapshotReader& operator=(const SnapshotReader&) = delete;
+};
+
+struct RecoveryResult {
+    bool ok{false};                // False if restoring failed or the journal ends before the snapshot
+    bool from_snapshot{false};
+    uint64_t snapshot_sequence{0};
+    uint64_t replayed{0};          // Journal records applied after the snapshot
+    uint64_t last_sequence{0};     // Last journal record reflected in the engine
+};
+
+// Restores the snapshot at snapshot_path (if present and valid), then replays
+// journal records after its sequence. Call after attaching the risk stage, if
+// any, and before attaching a journal and start(); open that journal with
+// resume_after = last_sequence.
+RecoveryResult recover(MatchingEngine& engine, const std::string& snapshot_path, 
+                       const std::string& journal_path);
+
+uint64_t snapshot_checksum(const char* data, size_t size) noexcept;
+
+} // namespace nanotrader
\ No newline at end of file
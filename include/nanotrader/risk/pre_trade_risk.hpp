@@ -0,0 +1,333 @@
+#pragma once
+
+#include "risk_stage.hpp"
+#include "risk_accounts.hpp"
+#include "nanotrader/core/symbol_table.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace nanotrader {
+
+struct RiskLimits {
+    Quantity max_order_quantity = std::numeric_limits<Quantity>::max();
+    double max_order_notional = std::numeric_limits<double>::max();  // price * quantity, in price units
+    int64_t price_band_bps = 1000;       // Around the last trade, else the mid / touch
+    int64_t fat_finger_bps = 200;        // How far a limit may reach through the opposite touch
+    Quantity max_market_quantity = std::numeric_limits<Quantity>::max();
+};
+
+// What one request asks for, as seen by the checks. Amends carry the resting
+// order's side; only adds and replaces bring a new price to check.
+struct RiskContext {
+    const OrderRequest& request;
+    const OrderBook& book;
+    Side side;
+    Price price;
+    Quantity quantity;        // Order size once the request applies
+    Quantity added;           // Exposure the request adds (0 for a shrinking modify)
+    bool priced;              // An add or replace with its own limit price
+    Price reference{};        // Band centre; only set if some check USES_REFERENCE
+    AccountState* account{nullptr};     // Only set if some check USES_ACCOUNTS
+    const RiskAccounts* accounts{nullptr};
+};
+
+// Check policies for PreTradeRisk. Each returns RiskReject::None to pass and
+// declares the shared state it reads, so state nobody reads is never maintained.
+struct MaxOrderSizeCheck {
+    static constexpr bool USES_REFERENCE = false;
+    static constexpr bool USES_ACCOUNTS = false;
+    
+    static RiskReject check(const RiskContext& ctx, const RiskLimits& limits) noexcept {
+        if (ctx.quantity > limits.max_order_quantity) {
+            return RiskReject::OrderQuantity;
+        }
+        
+        // Market orders are valued at the touch they will trade against
+        Price price = ctx.price;
+        if (ctx.request.order.is_market()) {
+            bool has_touch = ctx.side == Side::Buy ? ctx.book.has_best_ask() : ctx.book.has_best_bid();
+            price = !has_touch ? Price{} : ctx.side == Side::Buy ? ctx.book.get_best_ask() : ctx.book.get_best_bid();
+        }
+        if (price.to_double() * static_cast<double>(ctx.quantity) > limits.max_order_notional) {
+            return RiskReject::OrderNotional;
+        }
+        return RiskReject::None;
+    }
+};
+
+struct PriceBandCheck {
+    static constexpr bool USES_REFERENCE = true;
+    static constexpr bool USES_ACCOUNTS = false;
+    
+    static RiskReject check(const RiskContext& ctx, const RiskLimits& limits) noexcept {
+        int64_t reference = ctx.reference.raw_value();
+        if (!ctx.priced || reference <= 0) {
+            return RiskReject::None;
+        }
+        int64_t distance = ctx.price.raw_value() - reference;
+        if (distance < 0) {
+            distance = -distance;
+        }
+        return distance * 10000 > reference * limits.price_band_bps ? RiskReject::PriceBand : RiskReject::None;
+    }
+};
+
+struct FatFingerCheck {
+    static constexpr bool USES_REFERENCE = false;
+    static constexpr bool USES_ACCOUNTS = false;
+    
+    static RiskReject check(const RiskContext& ctx, const RiskLimits& limits) noexcept {
+        if (ctx.request.order.is_market()) {
+            return ctx.quantity > limits.max_market_quantity ? RiskReject::FatFinger : RiskReject::None;
+        }
+        if (!ctx.priced) {
+            return RiskReject::None;
+        }
+        
+        int64_t price = ctx.price.raw_value();
+        if (ctx.side == Side::Buy && ctx.book.has_best_ask()) {
+            int64_t ask = ctx.book.get_best_ask().raw_value();
+            return (price - ask) * 10000 > ask * limits.fat_finger_bps ? RiskReject::FatFinger : RiskReject::None;
+        }
+        if (ctx.side == Side::Sell && ctx.book.has_best_bid()) {
+            int64_t bid = ctx.book.get_best_bid().raw_value();
+            return (bid - price) * 10000 > bid * limits.fat_finger_bps ? RiskReject::FatFinger : RiskReject::None;
+        }
+        return RiskReject::None;
+    }
+};
+
+struct AccountLimitsCheck {
+    static constexpr bool USES_REFERENCE = false;
+    static constexpr bool USES_ACCOUNTS = true;
+    
+    static RiskReject check(const RiskContext& ctx, const RiskLimits&) noexcept {
+        const AccountState* state = ctx.account;
+        if (!state) {
+            return RiskReject::UnknownAccount;
+        }
+        
+        bool add = ctx.request.type == OrderRequest::Type::Add;
+        if (add && state->open_orders >= state->limits.max_open_orders) {
+            return RiskReject::OpenOrders;
+        }
+        if (add && ctx.accounts->full()) {
+            return RiskReject::OrderTableFull;
+        }
+        
+        // Worst case: every open order on this side fills, and so does this one
+        int64_t max_position = static_cast<int64_t>(
+            std::min<Quantity>(state->limits.max_position, std::numeric_limits<int64_t>::max()));
+        int64_t exposure = ctx.side == Side::Buy
+            ? state->position + static_cast<int64_t>(state->open_buy + ctx.added)
+            : static_cast<int64_t>(state->open_sell + ctx.added) - state->position;
+        return exposure > max_position ? RiskReject::Position : RiskReject::None;
+    }
+};
+
+// Risk stage assembled from check policies at compile time, run in the order
+// given. A check that isn't listed costs nothing; neither does the last-trade
+// table or the account bookkeeping when no listed check reads them:
+//
+//     PreTradeRisk<MaxOrderSizeCheck, FatFingerCheck> risk(limits);
+//     engine.attach_risk(&risk);
+//
+// Account and last-trade state starts empty. A snapshot captured with the stage
+// attached saves it, and recover() loads it into the stage attached then; orders
+// restored without it are not attributed to any account.
+template<typename... Checks>
+class PreTradeRisk final : public RiskStage {
+public:
+    static constexpr bool USES_REFERENCE = (Checks::USES_REFERENCE || ... || false);
+    static constexpr bool USES_ACCOUNTS = (Checks::USES_ACCOUNTS || ... || false);
+
+private:
+    RiskLimits limits_;
+    RiskAccounts accounts_;             // Empty unless USES_ACCOUNTS
+    std::vector<int64_t> last_trade_;   // Raw price by Symbol, 0 = no trade yet; empty unless USES_REFERENCE
+    
+    Price reference_price(const OrderBook& book) const noexcept {
+        Symbol symbol = book.get_symbol();
+        if (symbol < last_trade_.size() && last_trade_[symbol] > 0) {
+            return Price{last_trade_[symbol]};
+        }
+        if (book.has_best_bid() && book.has_best_ask()) {
+            return Price{(book.get_best_bid().raw_value() + book.get_best_ask().raw_value()) / 2};
+        }
+        return book.has_best_bid() ? book.get_best_bid() : book.has_best_ask() ? book.get_best_ask() : Price{};
+    }
+
+public:
+    explicit PreTradeRisk(const RiskLimits& limits = RiskLimits{},
+                          size_t max_accounts = RiskAccounts::DEFAULT_MAX_ACCOUNTS,
+                          size_t max_open_orders = RiskAccounts::DEFAULT_MAX_OPEN_ORDERS,
+                          size_t max_symbol = SymbolTable::DEFAULT_MAX_SYMBOL)
+        : limits_(limits)
+        , accounts_(USES_ACCOUNTS ? max_accounts : 0, USES_ACCOUNTS ? max_open_orders : 0)
+        , last_trade_(USES_REFERENCE ? max_symbol + 1 : 0, 0) {
+    }
+    
+    bool check(const OrderRequest& request, const OrderBook& book) noexcept override {
+        const Order& order = request.order;
+        AccountState* owner = nullptr;
+        if constexpr (USES_ACCOUNTS) {
+            // Only the account an order rests for may cancel or amend it
+            if (request.type != OrderRequest::Type::Add) {
+                owner = accounts_.find_owner(order.id);
+                if (owner && owner != accounts_.find(request.account)) {
+                    count_reject(RiskReject::NotOwner);
+                    return false;
+                }
+            }
+        }
+        
+        RiskContext ctx{request, book, order.side, order.price, order.quantity, order.quantity, !order.is_market()};
+        switch (request.type) {
+            case OrderRequest::Type::Add:
+                break;
+            case OrderRequest::Type::Cancel:
+                return true;
+            case OrderRequest::Type::Modify:
+            case OrderRequest::Type::Replace: {
+                const Order* resting = book.get_order(order.id);
+                if (!resting) {
+                    return true;  // The engine rejects it
+                }
+                bool replace = request.type == OrderRequest::Type::Replace;
+                ctx.side = resting->side;
+                ctx.price = replace ? order.price : resting->price;
+                ctx.quantity = request.new_quantity;
+                ctx.added = request.new_quantity > resting->remaining_quantity
+                    ? request.new_quantity - resting->remaining_quantity : 0;
+                ctx.priced = replace;
+                break;
+            }
+        }
+        
+        if constexpr (USES_REFERENCE) {
+            ctx.reference = reference_price(book);
+        }
+        if constexpr (USES_ACCOUNTS) {
+            ctx.account = owner ? owner : accounts_.find(request.account);
+            ctx.accounts = &accounts_;
+        }
+        
+        RiskReject reason = RiskReject::None;
+        (void)(((reason = Checks::check(ctx, limits_)) == RiskReject::None) && ...);
+        if (reason != RiskReject::None) {
+            count_reject(reason);
+            return false;
+        }
+        return true;
+    }
+    
+    void record(const OrderRequest& request, const MatchResult& result, const OrderBook& book) noexcept override {
+        if constexpr (USES_REFERENCE) {
+            Symbol symbol = book.get_symbol();
+            if (!result.trades.empty() && symbol < last_trade_.size()) {
+                last_trade_[symbol] = result.trades[result.trades.size() - 1].price.raw_value();
+            }
+        }
+        
+        if constexpr (USES_ACCOUNTS) {
+            const Order& order = request.order;
+            switch (request.type) {
+                case OrderRequest::Type::Add: {
+                    if (result.status == MatchResult::Status::Rejected) {
+                        return;  // Nothing traded (a failed FOK drops its trades) or rested
+                    }
+                    Quantity filled = 0;
+                    for (const Trade& trade : result.trades) {
+                        accounts_.fill_resting(trade.maker_order_id, trade.quantity);
+                        filled += trade.quantity;
+                    }
+                    accounts_.fill_incoming(request.account, order.side, filled);
+                    if (const Order* resting = book.get_order(order.id)) {
+                        accounts_.open(order.id, request.account, order.side, resting->remaining_quantity);
+                    }
+                    break;
+                }
+                case OrderRequest::Type::Cancel:
+                    if (result.status == MatchResult::Status::Cancelled) {
+                        accounts_.close(order.id);
+                    }
+                    break;
+                case OrderRequest::Type::Modify:
+                case OrderRequest::Type::Replace: {
+                    if (result.status == MatchResult::Status::Cancelled) {
+                        accounts_.close(order.id);
+                        break;
+                    }
+                    if (result.status == MatchResult::Status::Rejected) {
+                        break;
+                    }
+                    // Resized first, then whatever a crossing price traded comes off it like any fill
+                    accounts_.resize(order.id, request.new_quantity);
+                    Quantity filled = 0;
+                    for (const Trade& trade : result.trades) {
+                        accounts_.fill_resting(trade.maker_order_id, trade.quantity);
+                        filled += trade.quantity;
+                    }
+                    if (filled > 0) {
+                        accounts_.fill_resting(order.id, filled);
+                    }
+                    if (!book.get_order(order.id)) {
+                        accounts_.close(order.id);  // A remainder the book couldn't take back
+                    }
+                    break;
+                }
+            }
+        }
+    }
+    
+    void reset_open_orders() noexcept override {
+        accounts_.clear_open_orders();
+    }
+    
+    void save_state(std::vector<char>& out) const override {
+        if constexpr (USES_ACCOUNTS) {
+            accounts_.save(out);
+        }
+        if constexpr (USES_REFERENCE) {
+            put_state(out, static_cast<uint64_t>(last_trade_.size()));
+            for (int64_t price : last_trade_) {
+                put_state(out, price);
+            }
+        }
+    }
+    
+    bool load_state(const char* data, size_t size) noexcept override {
+        const char* end = data + size;
+        if constexpr (USES_ACCOUNTS) {
+            if (!accounts_.load(data, end)) {
+                return false;
+            }
+        }
+        if constexpr (USES_REFERENCE) {
+            uint64_t count = 0;
+            if (!take_state(data, end, count) || count > last_trade_.size()) {
+                return false;
+            }
+            std::fill(last_trade_.begin(), last_trade_.end(), 0);
+            for (uint64_t i = 0; i < count; ++i) {
+                if (!take_state(data, end, last_trade_[i])) {
+                    return false;
+                }
+            }
+        }
+        return data == end;
+    }
+    
+    const RiskLimits& get_limits() const noexcept { return limits_; }
+    void set_limits(const RiskLimits& limits) noexcept { limits_ = limits; }  // Matching thread, or while stopped
+    RiskAccounts& get_accounts() noexcept { return accounts_; }
+    const RiskAccounts& get_accounts() const noexcept { return accounts_; }
+    
+    PreTradeRisk(const PreTradeRisk&) = delete;
+    PreTradeRisk& operator=(const PreTradeRisk&) = delete;
+};
+
+} // namespace nanotrader
\ No newline at end of file
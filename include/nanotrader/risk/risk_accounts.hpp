@@ -0,0 +1,102 @@
+#pragma once
+
+#include "nanotrader/core/matching_engine.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace nanotrader {
+
+struct AccountLimits {
+    Quantity max_position = std::numeric_limits<Quantity>::max();  // Net, as if every open order filled
+    uint32_t max_open_orders = std::numeric_limits<uint32_t>::max();
+};
+
+struct AccountState {
+    int64_t position{0};     // Net filled quantity, long positive
+    Quantity open_buy{0};    // Resting quantity per side
+    Quantity open_sell{0};
+    uint32_t open_orders{0};
+    AccountLimits limits{};
+};
+
+// Flat per-account risk state, indexed by AccountId and allocated up front, plus
+// the resting orders that feed it. Orders live in a fixed open-addressing table
+// (linear probing, backward-shift deletion, like OrderIndex) that never grows;
+// the risk stage rejects new orders while it is full.
+class RiskAccounts {
+private:
+    struct OpenOrder {
+        OrderId id;
+        Quantity remaining;  // 0 = empty slot
+        AccountId account;
+        Side side;
+    };
+    
+    std::vector<AccountState> accounts_;
+    std::vector<OpenOrder> orders_;
+    size_t mask_;
+    unsigned shift_;
+    size_t size_{0};
+    size_t max_size_;
+    
+    size_t home(OrderId id) const noexcept {
+        return static_cast<size_t>((id * 0x9E3779B97F4A7C15ull) >> shift_);
+    }
+    
+    OpenOrder* find_order(OrderId id) noexcept {
+        for (size_t i = home(id);; i = (i + 1) & mask_) {
+            OpenOrder& order = orders_[i];
+            if (order.remaining == 0) return nullptr;
+            if (order.id == id) return &order;
+        }
+    }
+    
+    void erase_order(OpenOrder& order) noexcept;
+
+public:
+    static constexpr size_t DEFAULT_MAX_ACCOUNTS = 4096;
+    static constexpr size_t DEFAULT_MAX_OPEN_ORDERS = 1 << 20;
+    
+    explicit RiskAccounts(size_t max_accounts = DEFAULT_MAX_ACCOUNTS,
+                          size_t max_open_orders = DEFAULT_MAX_OPEN_ORDERS);
+    
+    AccountState* find(AccountId account) noexcept {
+        return account < accounts_.size() ? &accounts_[account] : nullptr;
+    }
+    
+    const AccountState* find(AccountId account) const noexcept {
+        return account < accounts_.size() ? &accounts_[account] : nullptr;
+    }
+    
+    // Account of a resting order, nullptr if the table doesn't know the order
+    AccountState* find_owner(OrderId id) noexcept {
+        OpenOrder* order = find_order(id);
+        return order ? &accounts_[order->account] : nullptr;
+    }
+    
+    bool set_limits(AccountId account, const AccountLimits& limits) noexcept;
+    void set_default_limits(const AccountLimits& limits) noexcept;  // Every account
+    
+    bool full() const noexcept { return size_ >= max_size_; }
+    size_t open_order_count() const noexcept { return size_; }
+    
+    // Post-trade bookkeeping; orders the table doesn't know are ignored
+    bool open(OrderId id, AccountId account, Side side, Quantity remaining) noexcept;
+    void fill_resting(OrderId id, Quantity quantity) noexcept;
+    void fill_incoming(AccountId account, Side side, Quantity quantity) noexcept;
+    void resize(OrderId id, Quantity remaining) noexcept;
+    void close(OrderId id) noexcept;
+    void clear_open_orders() noexcept;
+    
+    // Positions and open orders, for snapshots; limits are configuration and are
+    // left as set. load() replaces both, reading from data on and advancing it.
+    void save(std::vector<char>& out) const;
+    bool load(const char*& data, const char* end) noexcept;
+    
+    RiskAccounts(const RiskAccounts&) = delete;
+    RiskAccounts& operator=(const RiskAccounts&) = delete;
+};
+
+} // namespace nanotrader
\ No newline at end of file
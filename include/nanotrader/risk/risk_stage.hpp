@@ -0,0 +1,86 @@
+#pragma once
+
+#include "nanotrader/core/matching_engine.hpp"
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <vector>
+
+namespace nanotrader {
+
+enum class RiskReject : uint8_t {
+    None,
+    OrderQuantity,   // Above max_order_quantity
+    OrderNotional,   // Above max_order_notional
+    PriceBand,       // Too far from the last trade / touch
+    FatFinger,       // Priced far through the opposite touch, or an oversized market order
+    Position,        // Worst-case position would exceed the account's limit
+    OpenOrders,      // Account has too many resting orders
+    UnknownAccount,  // Account outside the preallocated range
+    OrderTableFull,  // No room to track another resting order
+    NotOwner,        // Cancel or amend of an order resting for another account
+    Count
+};
+
+// Risk state in snapshots is raw host-layout bytes, like the rest of the file
+template<typename T>
+void put_state(std::vector<char>& out, const T& value) {
+    static_assert(std::is_trivially_copyable_v<T>);
+    const char* bytes = reinterpret_cast<const char*>(&value);
+    out.insert(out.end(), bytes, bytes + sizeof(T));
+}
+
+template<typename T>
+bool take_state(const char*& data, const char* end, T& value) noexcept {
+    static_assert(std::is_trivially_copyable_v<T>);
+    if (static_cast<size_t>(end - data) < sizeof(T)) {
+        return false;
+    }
+    std::memcpy(&value, data, sizeof(T));
+    data += sizeof(T);
+    return true;
+}
+
+// Pre-trade stage the engine runs on the matching thread. check() sees every
+// request for a registered symbol before it reaches the book and returning false
+// rejects it; record() sees the request again with its result, so post-trade
+// state (positions, open orders, last trade) follows exactly what the book did.
+class RiskStage {
+private:
+    std::array<std::atomic<uint64_t>, static_cast<size_t>(RiskReject::Count)> rejects_{};
+
+protected:
+    void count_reject(RiskReject reason) noexcept {
+        rejects_[static_cast<size_t>(reason)].fetch_add(1, std::memory_order_relaxed);
+    }
+    
+    ~RiskStage() = default;
+
+public:
+    virtual bool check(const OrderRequest& request, const OrderBook& book) noexcept = 0;
+    virtual void record(const OrderRequest& request, const MatchResult& result, const OrderBook& book) noexcept = 0;
+    virtual void reset_open_orders() noexcept = 0;  // Books were cleared; positions are kept
+    
+    // Snapshot support: the state record() built up, so a recovered stage judges the
+    // next request as the live one would. load_state() is false if the bytes don't
+    // fit this stage (saved by a different one, or more accounts than it has).
+    virtual void save_state(std::vector<char>& out) const = 0;
+    virtual bool load_state(const char* data, size_t size) noexcept = 0;
+    
+    uint64_t get_reject_count(RiskReject reason) const noexcept {
+        return rejects_[static_cast<size_t>(reason)].load(std::memory_order_relaxed);
+    }
+    
+    uint64_t get_total_rejects() const noexcept {
+        uint64_t total = 0;
+        for (const auto& count : rejects_) {
+            total += count.load(std::memory_order_relaxed);
+        }
+        return total;
+    }
+};
+
+} // namespace nanotrader
\ No newline at end of file
@@ -0,0 +1,36 @@
+#pragma once
+
+#include "latency_histogram.hpp"
+
+namespace nanotrader {
+namespace telemetry {
+
+// Compile-time switch for every instrumentation point, set by ENABLE_PROFILING.
+// With it off the hooks are discarded if-constexpr branches: no timestamps, no
+// stores, and the engine never allocates its metrics.
+#ifdef NANOTRADER_ENABLE_PROFILING
+inline constexpr bool ENABLED = true;
+#else
+inline constexpr bool ENABLED = false;
+#endif
+
+// Order-lifecycle metrics of one MatchingEngine. Latencies are TSC cycles. Every
+// member has exactly one writer; the groups written by different threads start
+// on separate cache lines.
+struct EngineMetrics {
+    // Matching thread
+    LatencyHistogram queue_latency;   // submit_order()/submit_in_place() -> popped
+    LatencyHistogram match_latency;   // Popped -> result ready (batch wait included)
+    Counter requests;
+    Counter fills;                    // Trades
+    Counter rejects;
+    Counter levels_swept;             // Price levels an incoming order traded through
+    Counter pool_in_use;              // Gauges: order pool occupancy after each call
+    Counter pool_capacity;
+    
+    // Thread calling get_result()
+    LatencyHistogram result_latency;  // Result ready -> get_result()
+};
+
+} // namespace telemetry
+} // namespace nanotrader
\ No newline at end of file
@@ -0,0 +1,114 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+
+namespace nanotrader {
+namespace telemetry {
+
+// Log-linear (HDR-style) bucketing: values below 2*SUB_BUCKETS are exact, above
+// that each power of two splits into SUB_BUCKETS buckets, so any recorded value
+// is reported within 1/SUB_BUCKETS (~3%) across the full 64-bit range.
+struct HistogramLayout {
+    static constexpr unsigned SUB_BUCKET_BITS = 5;
+    static constexpr uint64_t SUB_BUCKETS = uint64_t{1} << SUB_BUCKET_BITS;
+    static constexpr size_t BUCKET_COUNT = 2 * SUB_BUCKETS + (63 - SUB_BUCKET_BITS) * SUB_BUCKETS;
+    
+    static constexpr size_t index_of(uint64_t value) noexcept {
+        if (value < 2 * SUB_BUCKETS) {
+            return static_cast<size_t>(value);
+        }
+        unsigned exponent = 63 - static_cast<unsigned>(std::countl_zero(value));   // >= SUB_BUCKET_BITS + 1
+        unsigned shift = exponent - SUB_BUCKET_BITS;
+        uint64_t mantissa = (value >> shift) - SUB_BUCKETS;                       // [0, SUB_BUCKETS)
+        return static_cast<size_t>(2 * SUB_BUCKETS + (shift - 1) * SUB_BUCKETS + mantissa);
+    }
+    
+    // Largest value that lands in the bucket
+    static constexpr uint64_t upper_bound(size_t index) noexcept {
+        if (index < 2 * SUB_BUCKETS) {
+            return index;
+        }
+        size_t offset = index - 2 * SUB_BUCKETS;
+        unsigned shift = static_cast<unsigned>(offset / SUB_BUCKETS) + 1;
+        uint64_t mantissa = SUB_BUCKETS + offset % SUB_BUCKETS;
+        return ((mantissa + 1) << shift) - 1;
+    }
+};
+
+// Plain copy of a histogram for merging and percentile queries (reader side)
+class HistogramSnapshot {
+private:
+    std::array<uint64_t, HistogramLayout::BUCKET_COUNT> counts_{};
+    uint64_t count_{0};
+    uint64_t sum_{0};
+    uint64_t max_{0};
+    
+    friend class LatencyHistogram;
+
+public:
+    void merge(const HistogramSnapshot& other) noexcept;
+    
+    // Upper bound of the bucket holding the q-th quantile (0 < q <= 1); 0 if empty
+    uint64_t value_at_quantile(double q) const noexcept;
+    
+    uint64_t count() const noexcept { return count_; }
+    uint64_t sum() const noexcept { return sum_; }
+    uint64_t max() const noexcept { return max_; }
+    double mean() const noexcept { return count_ ? static_cast<double>(sum_) / count_ : 0.0; }
+};
+
+// Single-writer histogram: exactly one thread records (plain load + store, no
+// locked RMW), while any thread may snapshot() concurrently. A snapshot taken
+// mid-record can be one sample out between buckets and totals, never torn.
+// Cache-line aligned so histograms of different writers never share a line.
+class alignas(64) LatencyHistogram {
+private:
+    std::array<std::atomic<uint64_t>, HistogramLayout::BUCKET_COUNT> counts_{};
+    std::atomic<uint64_t> count_{0};
+    std::atomic<uint64_t> sum_{0};
+    std::atomic<uint64_t> max_{0};
+    
+    static void bump(std::atomic<uint64_t>& cell, uint64_t delta) noexcept {
+        cell.store(cell.load(std::memory_order_relaxed) + delta, std::memory_order_relaxed);
+    }
+
+public:
+    LatencyHistogram() noexcept = default;
+    
+    void record(uint64_t value) noexcept {
+        bump(counts_[HistogramLayout::index_of(value)], 1);
+        bump(count_, 1);
+        bump(sum_, value);
+        if (value > max_.load(std::memory_order_relaxed)) {
+            max_.store(value, std::memory_order_relaxed);
+        }
+    }
+    
+    void snapshot(HistogramSnapshot& out) const noexcept;
+    void reset() noexcept;  // Writer thread, or while it is idle
+    
+    uint64_t count() const noexcept { return count_.load(std::memory_order_relaxed); }
+    
+    LatencyHistogram(const LatencyHistogram&) = delete;
+    LatencyHistogram& operator=(const LatencyHistogram&) = delete;
+};
+
+// Single-writer counter / gauge with the same rules as LatencyHistogram
+class Counter {
+private:
+    std::atomic<uint64_t> value_{0};
+
+public:
+    void add(uint64_t delta = 1) noexcept {
+        value_.store(value_.load(std::memory_order_relaxed) + delta, std::memory_order_relaxed);
+    }
+    void set(uint64_t value) noexcept { value_.store(value, std::memory_order_relaxed); }
+    uint64_t get() const noexcept { return value_.load(std::memory_order_relaxed); }
+};
+
+} // namespace telemetry
+} // namespace nanotrader
\ No newline at end of file
@@ -0,0 +1,63 @@
+#pragma once
+
+#include "engine_metrics.hpp"
+#include "nanotrader/core/tsc_clock.hpp"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+
+namespace nanotrader {
+namespace telemetry {
+
+struct ExporterConfig {
+    std::string path;                          // Prometheus textfile, replaced atomically
+    std::chrono::milliseconds interval{1000};
+    std::string prefix = "nanotrader";         // Metric name prefix
+};
+
+// Publishes EngineMetrics in the Prometheus text format (latencies as summaries
+// in nanoseconds) from its own thread. It only ever loads the metrics' relaxed
+// atomics, so the matching thread never waits on it; each export is written to
+// a temporary file and renamed over path, for a textfile collector to scrape.
+class MetricsExporter {
+private:
+    const EngineMetrics& metrics_;
+    const TscClock& clock_;
+    ExporterConfig config_;
+    
+    std::thread thread_;
+    std::mutex mutex_;                 // Only for waking the thread on stop()
+    std::condition_variable wake_;
+    bool stopping_{false};
+    std::atomic<bool> running_{false};
+    std::atomic<uint64_t> exports_{0};
+    std::atomic<uint64_t> failures_{0};
+    
+    void run();
+
+public:
+    MetricsExporter(const EngineMetrics& metrics, const TscClock& clock, ExporterConfig config);
+    ~MetricsExporter();
+    
+    bool start();
+    void stop();  // Writes a final export, then joins
+    bool is_running() const;
+    
+    bool export_now();  // One synchronous export to config.path
+    
+    static void render(const EngineMetrics& metrics, const TscClock& clock,
+                       const std::string& prefix, std::string& out);
+    
+    uint64_t export_count() const;
+    uint64_t failure_count() const;
+    
+    MetricsExporter(const MetricsExporter&) = delete;
+    MetricsExporter& operator=(const MetricsExporter&) = delete;
+};
+
+} // namespace telemetry
+} // namespace nanotrader
\ No newline at end of file
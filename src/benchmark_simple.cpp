@@ -1,7 +1,9 @@
 #include "nanotrader/core/order_book.hpp"
+#include <algorithm>
 #include <iostream>
 #include <chrono>
 #include <random>
+#include <unordered_map>
 #include <vector>
 
 using namespace nanotrader;
@@ -84,6 +86,76 @@ public:
         }
     }
     
+    // Resting-order index: std::unordered_map (previous OrderBook::orders_) vs OrderIndex
+    void benchmark_order_index(size_t num_orders) {
+        std::cout << "\n=== Order Index Benchmark (" << num_orders << " resting) ===\n";
+        
+        // Values stand in for queue-node indices
+        auto fake_node = [](OrderId id) {
+            return static_cast<uint32_t>(id);
+        };
+        
+        std::vector<OrderId> lookups(num_orders);
+        std::uniform_int_distribution<OrderId> id_dist(1, num_orders);
+        for (auto& id : lookups) {
+            id = id_dist(gen_);
+        }
+        
+        // Cancels arrive in random order, not ID order
+        std::vector<OrderId> cancels(num_orders);
+        for (size_t i = 0; i < num_orders; ++i) {
+            cancels[i] = i + 1;
+        }
+        std::shuffle(cancels.begin(), cancels.end(), gen_);
+        
+        auto run = [&](const char* name, auto& index, auto insert, auto find, auto erase) {
+            auto t0 = high_resolution_clock::now();
+            for (OrderId id = 1; id <= num_orders; ++id) {
+                insert(index, id, fake_node(id));
+            }
+            
+            auto t1 = high_resolution_clock::now();
+            uint64_t checksum = 0;
+            for (OrderId id : lookups) {
+                checksum += find(index, id);
+            }
+            
+            // Cancel/replace churn: every resting order is replaced by a new ID
+            auto t2 = high_resolution_clock::now();
+            for (OrderId id : cancels) {
+                erase(index, id);
+                insert(index, id + num_orders, fake_node(id + num_orders));
+            }
+            auto t3 = high_resolution_clock::now();
+            
+            auto per_op = [&](auto a, auto b) {
+                return static_cast<double>(duration_cast<nanoseconds>(b - a).count()) / num_orders;
+            };
+            
+            std::cout << name << ": insert " << per_op(t0, t1) << " ns"
+                      << " | find " << per_op(t1, t2) << " ns"
+                      << " | erase+insert " << per_op(t2, t3) << " ns"
+                      << " (checksum " << (checksum & 0xffff) << ")\n";
+        };
+        
+        {
+            std::unordered_map<OrderId, uint32_t> index;
+            index.reserve(100000);
+            run("unordered_map", index,
+                [](auto& m, OrderId id, uint32_t node) { m[id] = node; },
+                [](auto& m, OrderId id) { auto it = m.find(id); return it != m.end() ? it->second : OrderIndex::npos; },
+                [](auto& m, OrderId id) { m.erase(id); });
+        }
+        
+        {
+            OrderIndex index(100000);
+            run("OrderIndex   ", index,
+                [](auto& m, OrderId id, uint32_t node) { m.insert(id, node); },
+                [](auto& m, OrderId id) { return m.find(id); },
+                [](auto& m, OrderId id) { m.erase(id); });
+        }
+    }
+    
     void benchmark_price_operations() {
         std::cout << "\n=== Price Operations Benchmark ===\n";
         
@@ -132,6 +204,10 @@ int main() {
     
     bench.benchmark_price_operations();
     
+    for (size_t count : {10000, 100000, 1000000, 10000000}) {
+        bench.benchmark_order_index(count);
+    }
+    
     std::cout << "\nBenchmarks completed!\n";
     
     return 0;
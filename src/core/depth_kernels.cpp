@@ -0,0 +1,177 @@
+#include "nanotrader/core/depth_kernels.hpp"
+#include <bit>
+
+#if defined(__AVX512F__) || defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+namespace nanotrader {
+namespace depth_kernels {
+
+namespace {
+
+uint64_t prefix_sum_scalar(const uint64_t* in, uint64_t* out, size_t n, uint64_t carry) noexcept {
+    for (size_t i = 0; i < n; ++i) {
+        carry += in[i];
+        out[i] = carry;
+    }
+    return carry;
+}
+
+size_t first_at_least_scalar(const uint64_t* values, size_t begin, size_t n, uint64_t target) noexcept {
+    for (size_t i = begin; i < n; ++i) {
+        if (values[i] >= target) {
+            return i;
+        }
+    }
+    return n;
+}
+
+} // namespace
+
+#if defined(__AVX512F__)
+
+const char* isa() noexcept {
+    return "avx512";
+}
+
+// In-register scan: add the vector shifted up by 1, 2 and 4 lanes
+uint64_t prefix_sum(const uint64_t* in, uint64_t* out, size_t n, uint64_t carry) noexcept {
+    const __m512i shift1 = _mm512_set_epi64(6, 5, 4, 3, 2, 1, 0, 0);
+    const __m512i shift2 = _mm512_set_epi64(5, 4, 3, 2, 1, 0, 0, 0);
+    const __m512i shift4 = _mm512_set_epi64(3, 2, 1, 0, 0, 0, 0, 0);
+    const __m512i last = _mm512_set1_epi64(7);
+    __m512i running = _mm512_set1_epi64(static_cast<long long>(carry));
+    
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m512i x = _mm512_loadu_si512(in + i);
+        x = _mm512_add_epi64(x, _mm512_maskz_permutexvar_epi64(0xFE, shift1, x));
+        x = _mm512_add_epi64(x, _mm512_maskz_permutexvar_epi64(0xFC, shift2, x));
+        x = _mm512_add_epi64(x, _mm512_maskz_permutexvar_epi64(0xF0, shift4, x));
+        x = _mm512_add_epi64(x, running);
+        _mm512_storeu_si512(out + i, x);
+        running = _mm512_maskz_permutexvar_epi64(0xFF, last, x);
+    }
+    
+    carry = i > 0 ? out[i - 1] : carry;
+    return prefix_sum_scalar(in + i, out + i, n - i, carry);
+}
+
+size_t first_at_least(const uint64_t* values, size_t n, uint64_t target) noexcept {
+    const __m512i wanted = _mm512_set1_epi64(static_cast<long long>(target));
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __mmask8 hits = _mm512_cmpge_epu64_mask(_mm512_loadu_si512(values + i), wanted);
+        if (hits) {
+            return i + static_cast<size_t>(std::countr_zero(static_cast<unsigned>(hits)));
+        }
+    }
+    return first_at_least_scalar(values, i, n, target);
+}
+
+#elif defined(__AVX2__)
+
+const char* isa() noexcept {
+    return "avx2";
+}
+
+// In-register scan: add the vector shifted up by 1 and 2 lanes
+uint64_t prefix_sum(const uint64_t* in, uint64_t* out, size_t n, uint64_t carry) noexcept {
+    const __m256i zero = _mm256_setzero_si256();
+    __m256i running = _mm256_set1_epi64x(static_cast<long long>(carry));
+    
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + i));
+        x = _mm256_add_epi64(x, _mm256_blend_epi32(_mm256_permute4x64_epi64(x, _MM_SHUFFLE(2, 1, 0, 0)), zero, 0x03));
+        x = _mm256_add_epi64(x, _mm256_blend_epi32(_mm256_permute4x64_epi64(x, _MM_SHUFFLE(1, 0, 0, 0)), zero, 0x0F));
+        x = _mm256_add_epi64(x, running);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), x);
+        running = _mm256_permute4x64_epi64(x, _MM_SHUFFLE(3, 3, 3, 3));
+    }
+    
+    carry = i > 0 ? out[i - 1] : carry;
+    return prefix_sum_scalar(in + i, out + i, n - i, carry);
+}
+
+// AVX2 only compares signed: value >= target is value > target - 1, exact
+// while both stay below 2^63, and no value reaches a larger target
+size_t first_at_least(const uint64_t* values, size_t n, uint64_t target) noexcept {
+    if (target == 0) {
+        return 0;
+    }
+    if (target > static_cast<uint64_t>(INT64_MAX)) {
+        return n;
+    }
+    
+    const __m256i below = _mm256_set1_epi64x(static_cast<long long>(target - 1));
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(values + i));
+        int hits = _mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpgt_epi64(x, below)));
+        if (hits) {
+            return i + static_cast<size_t>(std::countr_zero(static_cast<unsigned>(hits)));
+        }
+    }
+    return first_at_least_scalar(values, i, n, target);
+}
+
+#elif defined(__ARM_NEON)
+
+const char* isa() noexcept {
+    return "neon";
+}
+
+uint64_t prefix_sum(const uint64_t* in, uint64_t* out, size_t n, uint64_t carry) noexcept {
+    const uint64x2_t zero = vdupq_n_u64(0);
+    uint64x2_t running = vdupq_n_u64(carry);
+    
+    size_t i = 0;
+    for (; i + 2 <= n; i += 2) {
+        uint64x2_t x = vld1q_u64(in + i);
+        x = vaddq_u64(x, vextq_u64(zero, x, 1));
+        x = vaddq_u64(x, running);
+        vst1q_u64(out + i, x);
+        running = vdupq_laneq_u64(x, 1);
+    }
+    
+    carry = i > 0 ? out[i - 1] : carry;
+    return prefix_sum_scalar(in + i, out + i, n - i, carry);
+}
+
+size_t first_at_least(const uint64_t* values, size_t n, uint64_t target) noexcept {
+    const uint64x2_t wanted = vdupq_n_u64(target);
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        uint64x2_t low = vcgeq_u64(vld1q_u64(values + i), wanted);
+        uint64x2_t high = vcgeq_u64(vld1q_u64(values + i + 2), wanted);
+        // Narrow the four lane masks to 16 bits each and test them as one word
+        uint64_t hits = vget_lane_u64(vreinterpret_u64_u16(vmovn_u32(vcombine_u32(vmovn_u64(low), vmovn_u64(high)))), 0);
+        if (hits) {
+            return i + static_cast<size_t>(std::countr_zero(hits)) / 16;
+        }
+    }
+    return first_at_least_scalar(values, i, n, target);
+}
+
+#else
+
+const char* isa() noexcept {
+    return "scalar";
+}
+
+uint64_t prefix_sum(const uint64_t* in, uint64_t* out, size_t n, uint64_t carry) noexcept {
+    return prefix_sum_scalar(in, out, n, carry);
+}
+
+size_t first_at_least(const uint64_t* values, size_t n, uint64_t target) noexcept {
+    return first_at_least_scalar(values, 0, n, target);
+}
+
+#endif
+
+} // namespace depth_kernels
+} // namespace nanotrader
\ No newline at end of file
@@ -0,0 +1,213 @@
+#include "nanotrader/core/engine_runner.hpp"
+#include "nanotrader/core/cpu_relax.hpp"
+#include <cstddef>
+
+#if defined(__linux__)
+#include <linux/futex.h>
+#include <pthread.h>
+#include <sched.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace nanotrader {
+
+namespace {
+
+#if defined(__linux__)
+// <numaif.h> belongs to libnuma; the two syscalls used here take no more than this
+constexpr int MPOL_PREFERRED_MODE = 1;
+constexpr int MPOL_BIND_MODE = 2;
+constexpr unsigned MPOL_MF_MOVE_FLAG = 1u << 1;
+constexpr unsigned long MAX_NODES = 64;
+
+int current_numa_node() {
+    unsigned cpu = 0;
+    unsigned node = 0;
+    if (syscall(SYS_getcpu, &cpu, &node, nullptr) != 0 || node >= MAX_NODES) {
+        return -1;
+    }
+    return static_cast<int>(node);
+}
+
+// Moves the whole pages inside [address, address + size) to the node
+bool bind_range(const void* address, size_t size, unsigned long node_mask) {
+    const uintptr_t page = static_cast<uintptr_t>(sysconf(_SC_PAGESIZE));
+    uintptr_t begin = (reinterpret_cast<uintptr_t>(address) + page - 1) & ~(page - 1);
+    uintptr_t end = (reinterpret_cast<uintptr_t>(address) + size) & ~(page - 1);
+    if (end <= begin) {
+        return true;
+    }
+    return syscall(SYS_mbind, begin, end - begin, MPOL_BIND_MODE, &node_mask, MAX_NODES,
+                   MPOL_MF_MOVE_FLAG) == 0;
+}
+#endif
+
+} // namespace
+
+bool pin_thread_to_cpu(int cpu) {
+#if defined(__linux__)
+    if (cpu < 0) {
+        return false;
+    }
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+#else
+    (void)cpu;
+    return false;
+#endif
+}
+
+EngineRunner::EngineRunner(MatchingEngine& engine, const RunnerConfig& config)
+    : engine_(engine)
+    , config_(config) {
+}
+
+EngineRunner::~EngineRunner() {
+    stop();
+}
+
+bool EngineRunner::start() {
+    if (thread_.joinable()) {
+        return false;
+    }
+    
+    ready_.store(false);
+    engine_.start();
+    thread_ = std::thread(&EngineRunner::run, this);
+    while (!ready_.load(std::memory_order_acquire)) {
+        std::this_thread::yield();
+    }
+    return true;
+}
+
+void EngineRunner::stop() {
+    if (!thread_.joinable()) {
+        return;
+    }
+    
+    engine_.stop();
+    wake();
+    thread_.join();
+}
+
+bool EngineRunner::is_running() const {
+    return thread_.joinable() && engine_.is_running();
+}
+
+void EngineRunner::setup_thread() {
+    pinned_.store(pin_thread_to_cpu(config_.cpu));
+
+#if defined(__linux__)
+    if (config_.realtime_priority > 0) {
+        sched_param param{};
+        param.sched_priority = config_.realtime_priority;
+        realtime_.store(pthread_setschedparam(pthread_self(), SCHED_FIFO, &param) == 0);
+    }
+    
+    // Only meaningful once the thread can no longer migrate off the node
+    if (config_.bind_memory && pinned_.load()) {
+        int node = current_numa_node();
+        if (node >= 0) {
+            unsigned long node_mask = 1ul << node;
+            bool bound = true;
+            engine_.for_each_hot_region([&bound, node_mask](const void* address, size_t size) {
+                bound = bind_range(address, size, node_mask) && bound;
+            });
+            
+            // Slabs the pools map later then prefer the node as well
+            syscall(SYS_set_mempolicy, MPOL_PREFERRED_MODE, &node_mask, MAX_NODES);
+            if (bound) {
+                numa_node_.store(node);
+            }
+        }
+    }
+#endif
+}
+
+void EngineRunner::run() {
+    setup_thread();
+    ready_.store(true, std::memory_order_release);
+    
+    uint32_t empty_polls = 0;
+    while (engine_.is_running()) {
+        if (engine_.process_batch() > 0) {
+            empty_polls = 0;
+        } else {
+            idle(empty_polls);
+            if (empty_polls < config_.spin_iterations) {
+                ++empty_polls;
+            }
+        }
+    }
+    
+    // Drain whatever was accepted before stop()
+    while (engine_.process_batch() > 0) {
+    }
+}
+
+void EngineRunner::idle(uint32_t empty_polls) {
+    if (config_.idle == IdleStrategy::Spin || empty_polls < config_.spin_iterations) {
+        cpu_relax();
+    } else if (config_.idle == IdleStrategy::SpinYield) {
+        std::this_thread::yield();
+    } else {
+        park();
+    }
+}
+
+void EngineRunner::park() {
+    uint32_t word = wake_word_.load(std::memory_order_relaxed);
+    parked_.store(true, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);  // Pairs with the fence in notify()
+    
+    // A request pushed before the flag was visible is caught here instead
+    if (engine_.has_pending_requests() || !engine_.is_running()) {
+        parked_.store(false, std::memory_order_relaxed);
+        return;
+    }
+    
+    parks_.store(parks_.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+#if defined(__linux__)
+    auto timeout = std::chrono::duration_cast<std::chrono::nanoseconds>(config_.park_timeout);
+    timespec ts{};
+    ts.tv_sec = static_cast<time_t>(timeout.count() / 1000000000);
+    ts.tv_nsec = static_cast<long>(timeout.count() % 1000000000);
+    syscall(SYS_futex, reinterpret_cast<uint32_t*>(&wake_word_), FUTEX_WAIT_PRIVATE, word, &ts, nullptr, 0);
+#else
+    (void)word;
+    std::this_thread::sleep_for(config_.park_timeout);
+#endif
+    parked_.store(false, std::memory_order_relaxed);
+}
+
+void EngineRunner::wake() noexcept {
+    wake_word_.fetch_add(1, std::memory_order_relaxed);
+#if defined(__linux__)
+    syscall(SYS_futex, reinterpret_cast<uint32_t*>(&wake_word_), FUTEX_WAKE_PRIVATE, 1, nullptr, nullptr, 0);
+#endif
+}
+
+const RunnerConfig& EngineRunner::get_config() const {
+    return config_;
+}
+
+bool EngineRunner::is_pinned() const {
+    return pinned_.load();
+}
+
+bool EngineRunner::is_realtime() const {
+    return realtime_.load();
+}
+
+int EngineRunner::get_numa_node() const {
+    return numa_node_.load();
+}
+
+uint64_t EngineRunner::get_park_count() const {
+    return parks_.load(std::memory_order_relaxed);
+}
+
+} // namespace nanotrader
\ No newline at end of file
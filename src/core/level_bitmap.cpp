@@ -0,0 +1,86 @@
+#include "nanotrader/core/level_bitmap.hpp"
+
+namespace nanotrader {
+
+PriceBitmap::PriceBitmap(int64_t tick_size, size_t width)
+    : bits_(width)
+    , tick_size_(tick_size > 0 ? tick_size : 1)
+    , base_(0)
+    , width_(width)
+    , untracked_(0)
+    , anchored_(false) {
+}
+
+bool PriceBitmap::index_of(Price price, size_t& index) const noexcept {
+    int64_t offset = price.raw_value() - base_;
+    if (!anchored_ || offset < 0 || offset % tick_size_ != 0) {
+        return false;
+    }
+    
+    index = static_cast<size_t>(offset / tick_size_);
+    return index < width_;
+}
+
+void PriceBitmap::mark(Price price) {
+    if (!anchored_ && untracked_ == 0 && price.raw_value() % tick_size_ == 0) {
+        reanchor(price);
+    }
+    
+    size_t index;
+    if (index_of(price, index)) {
+        bits_.set(index);
+    } else {
+        ++untracked_;
+    }
+}
+
+void PriceBitmap::unmark(Price price) noexcept {
+    size_t index;
+    if (index_of(price, index)) {
+        bits_.clear(index);
+    } else if (untracked_ > 0) {
+        --untracked_;
+    }
+}
+
+void PriceBitmap::reanchor(Price center) noexcept {
+    int64_t raw = center.raw_value() - center.raw_value() % tick_size_;
+    base_ = raw - static_cast<int64_t>(width_ / 2) * tick_size_;
+    anchored_ = width_ > 0;
+    untracked_ = 0;
+    bits_.reset();
+}
+
+bool PriceBitmap::find_prev(Price from, Price& out) const noexcept {
+    if (!anchored_) return false;
+    
+    int64_t offset = from.raw_value() - base_;
+    if (offset < 0) return false;
+    
+    size_t index = bits_.find_prev(static_cast<size_t>(offset / tick_size_));
+    if (index == LevelBitmap::npos) return false;
+    
+    out = Price{base_ + static_cast<int64_t>(index) * tick_size_};
+    return true;
+}
+
+bool PriceBitmap::find_next(Price from, Price& out) const noexcept {
+    if (!anchored_) return false;
+    
+    int64_t offset = from.raw_value() - base_;
+    size_t start = offset <= 0 ? 0 : static_cast<size_t>((offset + tick_size_ - 1) / tick_size_);
+    
+    size_t index = bits_.find_next(start);
+    if (index == LevelBitmap::npos) return false;
+    
+    out = Price{base_ + static_cast<int64_t>(index) * tick_size_};
+    return true;
+}
+
+void PriceBitmap::clear() noexcept {
+    bits_.reset();
+    untracked_ = 0;
+    anchored_ = false;
+}
+
+} // namespace nanotrader
@@ -0,0 +1,191 @@
+#include "nanotrader/core/market_data.hpp"
+
+namespace nanotrader {
+
+MarketDataPublisher::MarketDataPublisher(size_t snapshot_interval)
+    : snapshot_interval_(snapshot_interval) {
+}
+
+void MarketDataPublisher::publish_staged() noexcept {
+    if (staged_count_ == 0) {
+        return;
+    }
+    
+    size_t pushed = channel_.try_push_batch(staged_.begin(), staged_count_);
+    published_.fetch_add(pushed, std::memory_order_relaxed);
+    if (pushed < staged_count_) {
+        // Consumer is behind: the gap in sequence numbers tells it so
+        dropped_.fetch_add(staged_count_ - pushed, std::memory_order_relaxed);
+        resync_requested_ = true;
+    }
+    staged_count_ = 0;
+}
+
+void MarketDataPublisher::flush(const SymbolTable& books) {
+    publish_staged();
+    
+    if (resync_requested_) {
+        resync_requested_ = false;
+        resync_remaining_ = books.size();
+    }
+    
+    bool due = resync_remaining_ > 0 ||
+               (snapshot_interval_ > 0 && updates_since_snapshot_ >= snapshot_interval_);
+    if (!due || books.size() == 0) {
+        return;
+    }
+    
+    // A book too deep to ever fit is passed over like a published one; the
+    // consumer simply never syncs it
+    next_snapshot_book_ %= books.size();
+    if (try_snapshot(books.book_at(next_snapshot_book_)) != SnapshotOutcome::NoRoom) {
+        next_snapshot_book_ = (next_snapshot_book_ + 1) % books.size();
+        updates_since_snapshot_ = 0;
+        if (resync_remaining_ > 0) {
+            --resync_remaining_;
+        }
+    }
+}
+
+bool MarketDataPublisher::publish_snapshot(const OrderBook& book) {
+    return try_snapshot(book) == SnapshotOutcome::Published;
+}
+
+MarketDataPublisher::SnapshotOutcome MarketDataPublisher::try_snapshot(const OrderBook& book) {
+    publish_staged();
+    
+    // Only this thread pushes, so free space can only grow until we use it
+    size_t levels = 0;
+    book.for_each_level(Side::Buy, [&levels](const PriceLevel&) { ++levels; });
+    book.for_each_level(Side::Sell, [&levels](const PriceLevel&) { ++levels; });
+    if (levels + 2 > channel_.capacity()) {
+        oversized_.fetch_add(1, std::memory_order_relaxed);
+        return SnapshotOutcome::TooLarge;
+    }
+    if (levels + 2 > channel_.capacity() - channel_.size()) {
+        return SnapshotOutcome::NoRoom;
+    }
+    
+    Symbol symbol = book.get_symbol();
+    stage(MarketDataMessage::Type::SnapshotBegin, symbol, Side::Buy, Price{}, 0);
+    for (Side side : {Side::Buy, Side::Sell}) {
+        book.for_each_level(side, [&](const PriceLevel& level) {
+            stage(MarketDataMessage::Type::SnapshotLevel, symbol, side, level.price, level.total_quantity);
+        });
+    }
+    stage(MarketDataMessage::Type::SnapshotEnd, symbol, Side::Buy, Price{}, 0);
+    publish_staged();
+    
+    snapshots_.fetch_add(1, std::memory_order_relaxed);
+    return SnapshotOutcome::Published;
+}
+
+void MarketDataPublisher::request_resync() {
+    resync_requested_ = true;
+}
+
+bool MarketDataPublisher::poll(MarketDataMessage& message) {
+    return channel_.try_pop(message);
+}
+
+uint64_t MarketDataPublisher::get_published_count() const {
+    return published_.load(std::memory_order_relaxed);
+}
+
+uint64_t MarketDataPublisher::get_dropped_count() const {
+    return dropped_.load(std::memory_order_relaxed);
+}
+
+uint64_t MarketDataPublisher::get_snapshot_count() const {
+    return snapshots_.load(std::memory_order_relaxed);
+}
+
+uint64_t MarketDataPublisher::get_oversized_count() const {
+    return oversized_.load(std::memory_order_relaxed);
+}
+
+uint64_t MarketDataPublisher::get_last_sequence() const {
+    return next_sequence_ - 1;
+}
+
+// MarketDepth
+void MarketDepth::apply(const MarketDataMessage& message) {
+    if (next_sequence_ != 0 && message.sequence != next_sequence_) {
+        ++gaps_;
+        for (auto& [symbol, book] : books_) {
+            book.synced = false;
+            book.in_snapshot = false;
+        }
+    }
+    next_sequence_ = message.sequence + 1;
+    
+    Book& book = books_[message.symbol];
+    int64_t price = message.price.raw_value();
+    switch (message.type) {
+        case MarketDataMessage::Type::SnapshotBegin:
+            book.bids.clear();
+            book.asks.clear();
+            book.synced = false;
+            book.in_snapshot = true;
+            return;
+        case MarketDataMessage::Type::SnapshotEnd:
+            book.synced = book.in_snapshot;
+            book.in_snapshot = false;
+            return;
+        case MarketDataMessage::Type::SnapshotLevel:
+            if (!book.in_snapshot) {
+                return;  // Rest of a snapshot broken by a gap
+            }
+            break;
+        case MarketDataMessage::Type::LevelUpdate:
+            break;
+    }
+    
+    if (message.side == Side::Buy) {
+        if (message.quantity == 0) {
+            book.bids.erase(price);
+        } else {
+            book.bids[price] = message.quantity;
+        }
+    } else {
+        if (message.quantity == 0) {
+            book.asks.erase(price);
+        } else {
+            book.asks[price] = message.quantity;
+        }
+    }
+}
+
+bool MarketDepth::is_synced(Symbol symbol) const {
+    auto it = books_.find(symbol);
+    return it != books_.end() && it->second.synced;
+}
+
+std::vector<std::pair<Price, Quantity>> MarketDepth::get_levels(Symbol symbol, Side side, size_t depth) const {
+    std::vector<std::pair<Price, Quantity>> levels;
+    auto it = books_.find(symbol);
+    if (it == books_.end()) {
+        return levels;
+    }
+    
+    auto collect = [&](const auto& side_levels) {
+        for (const auto& [price, quantity] : side_levels) {
+            if (levels.size() == depth) {
+                break;
+            }
+            levels.emplace_back(Price{price}, quantity);
+        }
+    };
+    if (side == Side::Buy) {
+        collect(it->second.bids);
+    } else {
+        collect(it->second.asks);
+    }
+    return levels;
+}
+
+uint64_t MarketDepth::get_gap_count() const {
+    return gaps_;
+}
+
+} // namespace nanotrader
\ No newline at end of file
@@ -1,123 +1,185 @@
 #include "nanotrader/core/matching_engine.hpp"
+#include "nanotrader/core/cpu_relax.hpp"
+#include "nanotrader/core/market_data.hpp"
+#include "nanotrader/core/top_of_book.hpp"
+#include "nanotrader/persistence/journal.hpp"
+#include "nanotrader/risk/risk_stage.hpp"
 #include <algorithm>
 
 namespace nanotrader {
 
-// MatchingEngine constructor
-MatchingEngine::MatchingEngine() : order_allocator_(1000000) {}
+namespace {
 
-// Private methods
-OrderBook* MatchingEngine::get_or_create_book(Symbol symbol) {
-    auto it = order_books_.find(symbol);
-    if (it != order_books_.end()) {
-        return it->second.get();
+// Non-mutating FOK check. FOK is its own order type, so the price is always a limit.
+bool can_fill_completely(const OrderBook& book, const Order& order) noexcept {
+    Side opposite = order.is_buy() ? Side::Sell : Side::Buy;
+    return book.get_available_quantity(opposite, order.price, order.quantity) >= order.quantity;
+}
+
+// Whether an order would trade against the book before resting
+bool crosses(const OrderBook& book, const Order& order) noexcept {
+    if (order.is_market()) {
+        return true;
     }
-    
-    auto book = std::make_unique<OrderBook>(symbol);
-    OrderBook* book_ptr = book.get();
-    order_books_[symbol] = std::move(book);
-    return book_ptr;
+    return order.is_buy() ? book.has_best_ask() && order.price >= book.get_best_ask()
+                          : book.has_best_bid() && order.price <= book.get_best_bid();
 }
 
-void MatchingEngine::match_order(OrderBook* book, Order* incoming_order, std::vector<Trade>& trades) {
+} // namespace
+
+// MatchingEngine constructor
+MatchingEngine::MatchingEngine() 
+    : order_allocator_(EngineConfig::order_pool_size)
+    , trade_arena_(TRADE_SPILL_BLOCKS) {
+    clock_.calibrate();
+    if constexpr (telemetry::ENABLED) {
+        metrics_ = std::make_unique<telemetry::EngineMetrics>();
+        record_pool_metrics();
+    }
+}
+
+// Private methods
+void MatchingEngine::match_order(OrderBook* book, Order* incoming_order, TradeBuffer& trades, 
+                                 Timestamp match_time) {
     if (incoming_order->is_buy()) {
-        match_buy_order(book, incoming_order, trades);
+        match_buy_order(book, incoming_order, trades, match_time);
     } else {
-        match_sell_order(book, incoming_order, trades);
+        match_sell_order(book, incoming_order, trades, match_time);
     }
 }
 
-void MatchingEngine::match_buy_order(OrderBook* book, Order* buy_order, std::vector<Trade>& trades) {
+void MatchingEngine::match_buy_order(OrderBook* book, Order* buy_order, TradeBuffer& trades, 
+                                     Timestamp match_time) {
     while (buy_order->remaining_quantity > 0 && book->has_best_ask()) {
         Price best_ask = book->get_best_ask();
         
-        if (buy_order->is_market() || buy_order->price >= best_ask) {
-            const PriceLevel* level = book->get_sell_level(best_ask);
-            if (!level || level->is_empty()) {
-                break;
-            }
-            
-            Order* sell_order = level->head;
-            if (!sell_order) {
-                break;
-            }
-            
-            Quantity fill_quantity = std::min(buy_order->remaining_quantity, 
-                                             sell_order->remaining_quantity);
-            
-            trades.emplace_back(sell_order->id, buy_order->id, 
-                              buy_order->symbol, best_ask, fill_quantity, now());
+        if (!buy_order->is_market() && buy_order->price < best_ask) {
+            break;
+        }
+        
+        PriceLevel* level = book->get_best_ask_level();
+        if (!level || level->is_empty()) {
+            break;
+        }
+        if constexpr (telemetry::ENABLED) {
+            metrics_->levels_swept.add();
+        }
+        
+        // Drain this level in FIFO order; the level pointer is dead once its last order pops
+        bool level_done = false;
+        while (buy_order->remaining_quantity > 0 && !level_done) {
+            const QueueNode& maker = book->front(*level);
+            Quantity fill_quantity = std::min(buy_order->remaining_quantity, maker.remaining);
             
-            Quantity old_sell_qty = sell_order->remaining_quantity;
-            sell_order->fill(fill_quantity);
+            trades.emplace_back(maker.order_id, buy_order->id, 
+                              buy_order->symbol, best_ask, fill_quantity, match_time);
             buy_order->fill(fill_quantity);
             
-            if (sell_order->is_filled()) {
-                book->remove_order(sell_order->id);
-                order_allocator_.destroy(sell_order);
-            } else {
-                book->update_order_quantity(sell_order->id, old_sell_qty);
+            // A maker left partially filled ends the match anyway
+            level_done = maker.next == QueueNode::NIL;
+            if (Order* filled = book->fill_front(Side::Sell, level, fill_quantity)) {
+                order_allocator_.destroy(filled);
             }
-        } else {
-            break;
         }
     }
 }
 
-void MatchingEngine::match_sell_order(OrderBook* book, Order* sell_order, std::vector<Trade>& trades) {
+void MatchingEngine::match_sell_order(OrderBook* book, Order* sell_order, TradeBuffer& trades, 
+                                      Timestamp match_time) {
     while (sell_order->remaining_quantity > 0 && book->has_best_bid()) {
         Price best_bid = book->get_best_bid();
         
-        if (sell_order->is_market() || sell_order->price <= best_bid) {
-            const PriceLevel* level = book->get_buy_level(best_bid);
-            if (!level || level->is_empty()) {
-                break;
-            }
-            
-            Order* buy_order = level->head;
-            if (!buy_order) {
-                break;
-            }
-            
-            Quantity fill_quantity = std::min(sell_order->remaining_quantity, 
-                                             buy_order->remaining_quantity);
-            
-            trades.emplace_back(buy_order->id, sell_order->id, 
-                              sell_order->symbol, best_bid, fill_quantity, now());
+        if (!sell_order->is_market() && sell_order->price > best_bid) {
+            break;
+        }
+        
+        PriceLevel* level = book->get_best_bid_level();
+        if (!level || level->is_empty()) {
+            break;
+        }
+        if constexpr (telemetry::ENABLED) {
+            metrics_->levels_swept.add();
+        }
+        
+        // Drain this level in FIFO order; the level pointer is dead once its last order pops
+        bool level_done = false;
+        while (sell_order->remaining_quantity > 0 && !level_done) {
+            const QueueNode& maker = book->front(*level);
+            Quantity fill_quantity = std::min(sell_order->remaining_quantity, maker.remaining);
             
-            Quantity old_buy_qty = buy_order->remaining_quantity;
-            buy_order->fill(fill_quantity);
+            trades.emplace_back(maker.order_id, sell_order->id, 
+                              sell_order->symbol, best_bid, fill_quantity, match_time);
             sell_order->fill(fill_quantity);
             
-            if (buy_order->is_filled()) {
-                book->remove_order(buy_order->id);
-                order_allocator_.destroy(buy_order);
-            } else {
-                book->update_order_quantity(buy_order->id, old_buy_qty);
+            // A maker left partially filled ends the match anyway
+            level_done = maker.next == QueueNode::NIL;
+            if (Order* filled = book->fill_front(Side::Buy, level, fill_quantity)) {
+                order_allocator_.destroy(filled);
             }
-        } else {
-            break;
         }
     }
 }
 
-MatchResult MatchingEngine::process_add_order(const OrderRequest& request) {
-    OrderBook* book = get_or_create_book(request.order.symbol);
+MatchResult MatchingEngine::process_request(OrderBook* book, const OrderRequest& request, bool journal) {
+    if (!book) {
+        return MatchResult(MatchResult::Status::Rejected, request.order.id);  // Unregistered symbol
+    }
+    
+    if (!risk_) {
+        return execute_request(book, request);
+    }
+    if (!risk_->check(request, *book)) {
+        return MatchResult(MatchResult::Status::Rejected, request.order.id);
+    }
+    if (journal && journal_) {
+        journal_->append(request);  // Only what the stage admitted, so replay needn't judge again
+    }
+    MatchResult result = execute_request(book, request);
+    risk_->record(request, result, *book);
+    if (journal && journal_) {
+        journal_->append_result(result);
+    }
+    return result;
+}
+
+MatchResult MatchingEngine::execute_request(OrderBook* book, const OrderRequest& request) {
+    switch (request.type) {
+        case OrderRequest::Type::Add:
+            return process_add_order(book, request);
+        case OrderRequest::Type::Cancel:
+            return process_cancel_order(book, request);
+        case OrderRequest::Type::Modify:
+        case OrderRequest::Type::Replace:
+            return process_modify_order(book, request);
+    }
+    return MatchResult(MatchResult::Status::Rejected, request.order.id);
+}
+
+MatchResult MatchingEngine::process_add_order(OrderBook* book, const OrderRequest& request) {
+    // Fill-or-kill is decided before anything is touched: a rejected FOK leaves
+    // the book as it was, and an accepted one is certain to fill in full
+    if (request.order.is_fok() && !can_fill_completely(*book, request.order)) {
+        return MatchResult(MatchResult::Status::Rejected, request.order.id);
+    }
+    
+    // A limit order that may rest must have a price its book can hold, checked
+    // before any trade so a reject never leaves fills behind
+    const Order& incoming = request.order;
+    if (!incoming.is_market() && !incoming.is_ioc() && !incoming.is_fok() &&
+        !book->accepts_price(incoming.side, incoming.price)) {
+        return MatchResult(MatchResult::Status::Rejected, request.order.id);
+    }
+    
     Order* order = order_allocator_.construct(request.order);
     
     if (!order) {
         return MatchResult(MatchResult::Status::Rejected, request.order.id);
     }
     
-    MatchResult result(MatchResult::Status::Added, request.order.id);
+    MatchResult result(MatchResult::Status::Added, request.order.id, &trade_arena_);
     
-    if (request.order.is_market() || 
-        (request.order.is_buy() && book->has_best_ask() && 
-         request.order.price >= book->get_best_ask()) ||
-        (request.order.is_sell() && book->has_best_bid() && 
-         request.order.price <= book->get_best_bid())) {
-        
-        match_order(book, order, result.trades);
+    if (crosses(*book, request.order)) {
+        match_order(book, order, result.trades, clock_.now());
         
         if (!result.trades.empty()) {
             result.status = MatchResult::Status::Matched;
@@ -125,34 +187,34 @@ MatchResult MatchingEngine::process_add_order(const OrderRequest& request) {
     }
     
     if (order->remaining_quantity > 0 && !order->is_ioc() && !order->is_fok()) {
-        book->add_order(order);
-    } else if (order->is_fok() && order->remaining_quantity > 0) {
-        result.status = MatchResult::Status::Rejected;
-        result.trades.clear();
-        order_allocator_.destroy(order);
-    } else if (order->remaining_quantity == 0 || order->is_ioc()) {
+        if (!book->add_order(order)) {
+            // The book couldn't take the remainder; whatever traded stands
+            order_allocator_.destroy(order);
+            if (result.trades.empty()) {
+                result.status = MatchResult::Status::Rejected;
+            }
+        }
+    } else {
         order_allocator_.destroy(order);
     }
     
     return result;
 }
 
-MatchResult MatchingEngine::process_cancel_order(const OrderRequest& request) {
-    OrderBook* book = get_or_create_book(request.order.symbol);
+MatchResult MatchingEngine::process_cancel_order(OrderBook* book, const OrderRequest& request) {
     Order* order = book->get_order(request.order.id);
     
     if (!order) {
         return MatchResult(MatchResult::Status::Rejected, request.order.id);
     }
     
-    book->remove_order(request.order.id);
+    book->unlink_order(order);
     order_allocator_.destroy(order);
     
     return MatchResult(MatchResult::Status::Cancelled, request.order.id);
 }
 
-MatchResult MatchingEngine::process_modify_order(const OrderRequest& request) {
-    OrderBook* book = get_or_create_book(request.order.symbol);
+MatchResult MatchingEngine::process_modify_order(OrderBook* book, const OrderRequest& request) {
     Order* order = book->get_order(request.order.id);
     
     if (!order) {
@@ -160,53 +222,472 @@ MatchResult MatchingEngine::process_modify_order(const OrderRequest& request) {
     }
     
     if (request.new_quantity == 0) {
-        book->remove_order(request.order.id);
+        book->unlink_order(order);
         order_allocator_.destroy(order);
         return MatchResult(MatchResult::Status::Cancelled, request.order.id);
     }
     
-    Quantity old_quantity = order->remaining_quantity;
+    Price price = request.type == OrderRequest::Type::Replace ? request.order.price : order->price;
+    
+    // Shrinking at the same price keeps the order's place in the queue
+    if (price == order->price && request.new_quantity <= order->remaining_quantity) {
+        Quantity old_quantity = order->remaining_quantity;
+        order->remaining_quantity = request.new_quantity;
+        order->quantity = request.new_quantity;
+        book->update_order_quantity(order->id, old_quantity);
+        return MatchResult(MatchResult::Status::Modified, request.order.id);
+    }
+    
+    if (!book->accepts_price(order->side, price)) {
+        return MatchResult(MatchResult::Status::Rejected, request.order.id);  // Still resting as it was
+    }
+    
+    // Growing or repricing loses priority: the same Order leaves its level, trades
+    // if the new price crosses, and rests at the back of the new level
+    book->unlink_order(order);
+    order->price = price;
     order->remaining_quantity = request.new_quantity;
     order->quantity = request.new_quantity;
     
-    book->update_order_quantity(order->id, old_quantity);
+    MatchResult result(MatchResult::Status::Modified, request.order.id, &trade_arena_);
+    if (crosses(*book, *order)) {
+        match_order(book, order, result.trades, clock_.now());
+        
+        if (!result.trades.empty()) {
+            result.status = MatchResult::Status::Matched;
+        }
+    }
+    
+    if (order->remaining_quantity == 0) {
+        order_allocator_.destroy(order);
+    } else if (!book->add_order(order)) {
+        // Already off its old level: the book couldn't take it back, so it is gone
+        order_allocator_.destroy(order);
+        if (result.trades.empty()) {
+            result.status = MatchResult::Status::Cancelled;
+        }
+    }
+    
+    return result;
+}
+
+void MatchingEngine::publish_book_snapshots() {
+    if (!market_data_) {
+        return;
+    }
     
-    return MatchResult(MatchResult::Status::Modified, request.order.id);
+    // Straight away where the channel has room, otherwise via a resync of every book
+    bool complete = true;
+    symbols_.for_each([this, &complete](const OrderBook& book) {
+        complete = market_data_->publish_snapshot(book) && complete;
+    });
+    if (!complete) {
+        market_data_->request_resync();
+    }
+}
+
+void MatchingEngine::attach_book_feeds(OrderBook& book) {
+    book.set_market_data(market_data_);
+    
+    int32_t slot = top_of_book_ ? top_of_book_->add_book(book) : -1;
+    if (slot >= 0) {
+        book.set_top_of_book(top_of_book_, static_cast<uint32_t>(slot));
+    } else {
+        book.set_top_of_book(nullptr, 0);  // No feed, or the feed is full
+    }
+}
+
+void MatchingEngine::flush_feeds() {
+    if (market_data_) {
+        market_data_->flush(symbols_);
+    }
+    if (top_of_book_) {
+        top_of_book_->flush();
+    }
+}
+
+void MatchingEngine::record_metrics(const OrderRequest& request, MatchResult& result,
+                                    uint64_t popped_cycles) {
+    uint64_t now = TscClock::cycles();
+    if (request.enqueue_cycles != 0 && popped_cycles > request.enqueue_cycles) {
+        metrics_->queue_latency.record(popped_cycles - request.enqueue_cycles);
+    }
+    metrics_->match_latency.record(now - popped_cycles);
+    result.ready_cycles = now;
+    
+    metrics_->requests.add();
+    metrics_->fills.add(result.trades.size());
+    if (result.status == MatchResult::Status::Rejected) {
+        metrics_->rejects.add();
+    }
+}
+
+void MatchingEngine::record_pool_metrics() {
+    size_t capacity = order_allocator_.capacity();
+    metrics_->pool_capacity.set(capacity);
+    metrics_->pool_in_use.set(capacity - order_allocator_.available_count());
 }
 
 // Public methods
+OrderBook* MatchingEngine::register_symbol(Symbol symbol, const BookConfig& config) {
+    OrderBook* book = symbols_.register_symbol(symbol, config);
+    if (book) {
+        attach_book_feeds(*book);
+        if (top_of_book_) {
+            top_of_book_->flush();
+        }
+    }
+    return book;
+}
+
+bool MatchingEngine::is_registered(Symbol symbol) const {
+    return symbols_.contains(symbol);
+}
+
+void MatchingEngine::attach_journal(Journal* journal) {
+    journal_ = journal;
+}
+
+Journal* MatchingEngine::get_journal() const {
+    return journal_;
+}
+
+void MatchingEngine::attach_market_data(MarketDataPublisher* publisher) {
+    market_data_ = publisher;
+    symbols_.for_each([publisher](OrderBook& book) {
+        book.set_market_data(publisher);
+    });
+    publish_book_snapshots();
+}
+
+MarketDataPublisher* MatchingEngine::get_market_data() const {
+    return market_data_;
+}
+
+void MatchingEngine::attach_top_of_book(TopOfBookFeed* feed) {
+    top_of_book_ = feed;
+    symbols_.for_each([this](OrderBook& book) {
+        attach_book_feeds(book);
+    });
+    if (top_of_book_) {
+        top_of_book_->flush();
+    }
+}
+
+TopOfBookFeed* MatchingEngine::get_top_of_book() const {
+    return top_of_book_;
+}
+
+void MatchingEngine::attach_risk(RiskStage* risk) {
+    risk_ = risk;
+}
+
+RiskStage* MatchingEngine::get_risk() const {
+    return risk_;
+}
+
+MatchResult MatchingEngine::apply(const OrderRequest& request) {
+    MatchResult result = process_request(symbols_.find(request.order.symbol), request, false);
+    processed_orders_.fetch_add(1, std::memory_order_relaxed);
+    flush_feeds();
+    return result;
+}
+
+MatchResult MatchingEngine::replay(const OrderRequest& request) {
+    OrderBook* book = symbols_.find(request.order.symbol);
+    if (!book) {
+        return MatchResult(MatchResult::Status::Rejected, request.order.id);
+    }
+    
+    MatchResult result = execute_request(book, request);
+    if (risk_) {
+        risk_->record(request, result, *book);
+    }
+    processed_orders_.fetch_add(1, std::memory_order_relaxed);
+    flush_feeds();
+    return result;
+}
+
+bool MatchingEngine::restore_order(const Order& order) {
+    OrderBook* book = symbols_.find(order.symbol);
+    if (!book) {
+        return false;
+    }
+    
+    Order* resting = order_allocator_.construct(order);
+    if (!resting) {
+        return false;
+    }
+    
+    if (!book->add_order(resting)) {
+        order_allocator_.destroy(resting);
+        return false;
+    }
+    return true;
+}
+
 bool MatchingEngine::submit_order(const OrderRequest& request) {
+    if constexpr (telemetry::ENABLED) {
+        OrderRequest stamped = request;
+        stamped.enqueue_cycles = TscClock::cycles();
+        return input_buffer_.try_push(stamped);
+    }
     return input_buffer_.try_push(request);
 }
 
 bool MatchingEngine::get_result(MatchResult& result) {
-    return output_buffer_.try_pop(result);
+    if (!output_buffer_.try_pop(result)) {
+        return false;
+    }
+    if constexpr (telemetry::ENABLED) {
+        if (result.ready_cycles != 0) {
+            metrics_->result_latency.record(TscClock::cycles() - result.ready_cycles);
+        }
+    }
+    return true;
 }
 
 void MatchingEngine::process_orders() {
+    clock_.reanchor_if_due();
+    drain_overflow();
+    
+    // Only pop what is certain to be published; the room is re-read when it runs out
+    size_t admitted = output_room();
     OrderRequest request;
-    while (input_buffer_.try_pop(request)) {
-        MatchResult result;
+    while (admitted > 0 && input_buffer_.try_pop(request)) {
+        uint64_t popped_cycles = 0;
+        if constexpr (telemetry::ENABLED) {
+            popped_cycles = TscClock::cycles();
+        }
         
-        switch (request.type) {
-            case OrderRequest::Type::Add:
-                result = process_add_order(request);
-                break;
-            case OrderRequest::Type::Cancel:
-                result = process_cancel_order(request);
-                break;
-            case OrderRequest::Type::Modify:
-                result = process_modify_order(request);
-                break;
+        // With a risk stage attached, process_request() journals what it admits
+        if (journal_ && !risk_) {
+            journal_->append(request);
         }
         
-        if (!output_buffer_.try_push(std::move(result))) {
-            // Output buffer full, could implement backpressure
-            break;
+        MatchResult result = process_request(symbols_.find(request.order.symbol), request, true);
+        if (journal_ && !risk_) {
+            journal_->append_result(result);
+        }
+        if constexpr (telemetry::ENABLED) {
+            record_metrics(request, result, popped_cycles);
         }
         
+        publish_result(std::move(result));
         processed_orders_.fetch_add(1, std::memory_order_relaxed);
+        
+        if (--admitted == 0) {
+            admitted = output_room();
+        }
+    }
+    
+    if (admitted == 0 && !input_buffer_.empty()) {
+        throttles_.fetch_add(1, std::memory_order_relaxed);
+    }
+    flush_feeds();
+    if constexpr (telemetry::ENABLED) {
+        record_pool_metrics();
+    }
+}
+
+size_t MatchingEngine::process_batch() {
+    // Idle calls still flush, so snapshots owed to the feed keep going out, and
+    // keep the clock anchored (a compare until a re-anchor is due)
+    clock_.reanchor_if_due();
+    flush_feeds();
+    
+    // Never pop more than can be published, so no result is dropped
+    drain_overflow();
+    size_t limit = std::min(batch_size_, output_room());
+    
+    size_t count = 0;
+    if (limit > 0) {
+        input_buffer_.try_pop_batch([this, &count](OrderRequest&& request) {
+            batch_requests_[count++] = std::move(request);
+        }, limit);
+    }
+    if (count == limit && limit < batch_size_ && !input_buffer_.empty()) {
+        throttles_.fetch_add(1, std::memory_order_relaxed);
+    }
+    
+    if (count == 0) {
+        return 0;
+    }
+    
+    uint64_t popped_cycles = 0;
+    if constexpr (telemetry::ENABLED) {
+        popped_cycles = TscClock::cycles();
+    }
+    
+    if (journal_ && !risk_) {
+        journal_->append_batch(batch_requests_.data(), count);
+    }
+    
+    if (risk_) {
+        // Risk state spans symbols, so verdicts depend on arrival order: run the
+        // batch as submitted, the same as apply() and journal replay do
+        for (size_t i = 0; i < count; ++i) {
+            batch_order_[i] = static_cast<uint16_t>(i);
+        }
+    } else {
+        // Stable insertion sort of indices by symbol: per-symbol order is preserved
+        // and each run of one symbol shares a single book lookup
+        for (size_t i = 0; i < count; ++i) {
+            uint16_t idx = static_cast<uint16_t>(i);
+            Symbol symbol = batch_requests_[idx].order.symbol;
+            size_t j = i;
+            while (j > 0 && batch_requests_[batch_order_[j - 1]].order.symbol > symbol) {
+                batch_order_[j] = batch_order_[j - 1];
+                --j;
+            }
+            batch_order_[j] = idx;
+        }
     }
+    
+    OrderBook* book = nullptr;
+    for (size_t i = 0; i < count; ++i) {
+        const OrderRequest& request = batch_requests_[batch_order_[i]];
+        if (!book || book->get_symbol() != request.order.symbol) {
+            book = symbols_.find(request.order.symbol);
+        }
+        batch_results_[batch_order_[i]] = process_request(book, request, true);
+        if constexpr (telemetry::ENABLED) {
+            record_metrics(request, batch_results_[batch_order_[i]], popped_cycles);
+        }
+    }
+    
+    // Results pair with journal records in submission order, not execution order
+    if (journal_ && !risk_) {
+        for (size_t i = 0; i < count; ++i) {
+            journal_->append_result(batch_results_[i]);
+        }
+    }
+    
+    publish_results(count);
+    processed_orders_.fetch_add(count, std::memory_order_relaxed);
+    flush_feeds();
+    if constexpr (telemetry::ENABLED) {
+        record_pool_metrics();
+    }
+    
+    return count;
+}
+
+size_t MatchingEngine::output_room() const {
+    size_t output_free = output_buffer_.capacity() - output_buffer_.size();
+    switch (backpressure_) {
+        case BackpressurePolicy::Throttle:
+            return output_free;
+        case BackpressurePolicy::Spin:
+            return INPUT_BUFFER_SIZE;  // Never the limit
+        case BackpressurePolicy::Spill:
+            return output_free + (overflow_->capacity() - overflow_->size());
+    }
+    return output_free;
+}
+
+void MatchingEngine::drain_overflow() {
+    if (!overflow_ || overflow_->empty()) {
+        return;
+    }
+    
+    size_t output_free = output_buffer_.capacity() - output_buffer_.size();
+    overflow_->try_pop_batch([this](MatchResult&& result) {
+        output_buffer_.try_push(std::move(result));
+    }, output_free);
+}
+
+// Callers admitted the request against output_room(), so every branch has a slot
+void MatchingEngine::publish_result(MatchResult&& result) {
+    switch (backpressure_) {
+        case BackpressurePolicy::Throttle:
+            output_buffer_.try_push(std::move(result));
+            return;
+        case BackpressurePolicy::Spin:
+            if (!output_buffer_.try_push(std::move(result))) {
+                spin_waits_.fetch_add(1, std::memory_order_relaxed);
+                do {
+                    cpu_relax();
+                } while (!output_buffer_.try_push(std::move(result)));
+            }
+            return;
+        case BackpressurePolicy::Spill:
+            drain_overflow();
+            if (!overflow_->empty() || !output_buffer_.try_push(std::move(result))) {
+                overflow_->try_push(std::move(result));
+                spills_.fetch_add(1, std::memory_order_relaxed);
+            }
+            return;
+    }
+}
+
+void MatchingEngine::publish_results(size_t count) {
+    MatchResult* results = batch_results_.data();
+    size_t pushed = 0;
+    switch (backpressure_) {
+        case BackpressurePolicy::Throttle:
+            output_buffer_.try_push_batch(results, count);
+            return;
+        case BackpressurePolicy::Spin:
+            pushed = output_buffer_.try_push_batch(results, count);
+            if (pushed < count) {
+                spin_waits_.fetch_add(count - pushed, std::memory_order_relaxed);
+                do {
+                    cpu_relax();
+                    pushed += output_buffer_.try_push_batch(results + pushed, count - pushed);
+                } while (pushed < count);
+            }
+            return;
+        case BackpressurePolicy::Spill:
+            drain_overflow();
+            if (overflow_->empty()) {
+                pushed = output_buffer_.try_push_batch(results, count);
+            }
+            if (pushed < count) {
+                overflow_->try_push_batch(results + pushed, count - pushed);
+                spills_.fetch_add(count - pushed, std::memory_order_relaxed);
+            }
+            return;
+    }
+}
+
+void MatchingEngine::set_batch_size(size_t batch_size) {
+    batch_size_ = std::clamp<size_t>(batch_size, 1, MAX_BATCH_SIZE);
+}
+
+size_t MatchingEngine::get_batch_size() const {
+    return batch_size_;
+}
+
+bool MatchingEngine::set_backpressure_policy(BackpressurePolicy policy) {
+    if (policy != BackpressurePolicy::Spill && overflow_ && !overflow_->empty()) {
+        return false;
+    }
+    if (policy == BackpressurePolicy::Spill && !overflow_) {
+        overflow_ = std::make_unique<SPSCRingBuffer<MatchResult, OUTPUT_BUFFER_SIZE>>();
+    }
+    backpressure_ = policy;
+    return true;
+}
+
+BackpressurePolicy MatchingEngine::get_backpressure_policy() const {
+    return backpressure_;
+}
+
+uint64_t MatchingEngine::get_throttle_count() const {
+    return throttles_.load(std::memory_order_relaxed);
+}
+
+uint64_t MatchingEngine::get_spin_wait_count() const {
+    return spin_waits_.load(std::memory_order_relaxed);
+}
+
+uint64_t MatchingEngine::get_spill_count() const {
+    return spills_.load(std::memory_order_relaxed);
+}
+
+size_t MatchingEngine::get_spilled_results() const {
+    return overflow_ ? overflow_->size() : 0;
 }
 
 void MatchingEngine::start() {
@@ -226,24 +707,22 @@ uint64_t MatchingEngine::get_processed_orders() const {
 }
 
 OrderBook* MatchingEngine::get_order_book(Symbol symbol) {
-    auto it = order_books_.find(symbol);
-    return (it != order_books_.end()) ? it->second.get() : nullptr;
+    return symbols_.find(symbol);
 }
 
 const OrderBook* MatchingEngine::get_order_book(Symbol symbol) const {
-    auto it = order_books_.find(symbol);
-    return (it != order_books_.end()) ? it->second.get() : nullptr;
+    return symbols_.find(symbol);
 }
 
 size_t MatchingEngine::get_order_book_count() const {
-    return order_books_.size();
+    return symbols_.size();
 }
 
 size_t MatchingEngine::get_total_orders() const {
     size_t total = 0;
-    for (const auto& [symbol, book] : order_books_) {
-        total += book->get_order_count();
-    }
+    symbols_.for_each([&total](const OrderBook& book) {
+        total += book.get_order_count();
+    });
     return total;
 }
 
@@ -251,9 +730,36 @@ size_t MatchingEngine::get_available_order_capacity() const {
     return order_allocator_.available_count();
 }
 
+const telemetry::EngineMetrics* MatchingEngine::get_metrics() const {
+    return metrics_.get();
+}
+
+const TscClock& MatchingEngine::get_clock() const {
+    return clock_;
+}
+
+const SymbolTable& MatchingEngine::get_symbol_table() const {
+    return symbols_;
+}
+
 void MatchingEngine::clear_all_books() {
-    order_books_.clear();
+    symbols_.for_each([](OrderBook& book) {
+        book.clear();
+    });
     processed_orders_.store(0);
+    
+    // Levels vanished without deltas
+    publish_book_snapshots();
+    if (risk_) {
+        risk_->reset_open_orders();
+    }
+    if (top_of_book_) {
+        top_of_book_->mark_all_dirty();
+        top_of_book_->flush();
+    }
+    if constexpr (telemetry::ENABLED) {
+        record_pool_metrics();
+    }
 }
 
 } // namespace nanotrader
\ No newline at end of file
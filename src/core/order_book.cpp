@@ -1,5 +1,9 @@
 #include "nanotrader/core/order_book.hpp"
+#include "nanotrader/core/depth_kernels.hpp"
+#include "nanotrader/core/market_data.hpp"
+#include "nanotrader/core/top_of_book.hpp"
 #include <algorithm>
+#include <new>
 
 namespace nanotrader {
 
@@ -7,79 +11,196 @@ namespace nanotrader {
 PriceLevel::PriceLevel() noexcept 
     : price(Price{})
     , total_quantity(0)
-    , head(nullptr)
-    , tail(nullptr) {
+    , head(QueueNode::NIL)
+    , tail(QueueNode::NIL) {
 }
 
 PriceLevel::PriceLevel(Price p) noexcept 
     : price(p)
     , total_quantity(0)
-    , head(nullptr)
-    , tail(nullptr) {
+    , head(QueueNode::NIL)
+    , tail(QueueNode::NIL) {
 }
 
-void PriceLevel::add_order(Order* order) noexcept {
-    if (!head) {
-        head = tail = order;
-        order->next = order->prev = nullptr;
+void PriceLevel::push_back(QueueNodeSlabs& nodes, uint32_t node) noexcept {
+    QueueNode& entry = nodes[node];
+    entry.next = QueueNode::NIL;
+    entry.prev = tail;
+    if (tail == QueueNode::NIL) {
+        head = node;
     } else {
-        tail->next = order;
-        order->prev = tail;
-        order->next = nullptr;
-        tail = order;
+        nodes[tail].next = node;
     }
-    total_quantity += order->remaining_quantity;
+    tail = node;
+    total_quantity += entry.remaining;
 }
 
-void PriceLevel::remove_order(Order* order) noexcept {
-    if (order->prev) {
-        order->prev->next = order->next;
+void PriceLevel::unlink(QueueNodeSlabs& nodes, uint32_t node) noexcept {
+    QueueNode& entry = nodes[node];
+    if (entry.prev != QueueNode::NIL) {
+        nodes[entry.prev].next = entry.next;
     } else {
-        head = order->next;
+        head = entry.next;
     }
     
-    if (order->next) {
-        order->next->prev = order->prev;
+    if (entry.next != QueueNode::NIL) {
+        nodes[entry.next].prev = entry.prev;
     } else {
-        tail = order->prev;
+        tail = entry.prev;
     }
     
-    total_quantity -= order->remaining_quantity;
-    order->next = order->prev = nullptr;
+    total_quantity -= entry.remaining;
 }
 
-void PriceLevel::update_quantity(Order* order, Quantity old_quantity) noexcept {
-    total_quantity = total_quantity - old_quantity + order->remaining_quantity;
+bool PriceLevel::is_empty() const noexcept {
+    return head == QueueNode::NIL;
 }
 
-bool PriceLevel::is_empty() const noexcept {
-    return head == nullptr;
+// QueueNodeSlabs
+uint32_t QueueNodeSlabs::emplace_back() {
+    if (size_ == slabs_.size() * SLAB_SIZE) {
+        // Allocate before recording it, so a failure at either step leaves no trace
+        std::unique_ptr<QueueNode[]> slab(new QueueNode[SLAB_SIZE]);
+        slabs_.push_back(std::move(slab));
+    }
+    return size_++;
+}
+
+void QueueNodeSlabs::reserve(size_t count) {
+    size_t slabs = (count + SLAB_SIZE - 1) / SLAB_SIZE;
+    slabs_.reserve(slabs);
+    while (slabs_.size() < slabs) {
+        slabs_.push_back(std::unique_ptr<QueueNode[]>(new QueueNode[SLAB_SIZE]));
+    }
 }
 
 // OrderBook implementations
 OrderBook::OrderBook(Symbol symbol) noexcept 
+    : OrderBook(symbol, BookConfig{}) {
+}
+
+OrderBook::OrderBook(Symbol symbol, const BookConfig& config)
     : symbol_(symbol)
+    , config_(config)
+    , use_ladder_(config.backend == BookConfig::Backend::Ladder)
+    , buy_ladder_(config.tick_size, use_ladder_ ? config.ladder_width : 0, config.max_ladder_width)
+    , sell_ladder_(config.tick_size, use_ladder_ ? config.ladder_width : 0, config.max_ladder_width)
+    , buy_occupancy_(config.tick_size, use_ladder_ ? 0 : config.bitmap_width)
+    , sell_occupancy_(config.tick_size, use_ladder_ ? 0 : config.bitmap_width)
     , best_bid_(Price{})
     , best_ask_(Price{})
     , has_best_bid_(false)
     , has_best_ask_(false) {
-    buy_levels_.reserve(10000);
-    sell_levels_.reserve(10000);
-    orders_.reserve(100000);
+    if (!use_ladder_) {
+        buy_levels_.reserve(config.level_reserve);
+        sell_levels_.reserve(config.level_reserve);
+    }
+    orders_.reserve(config.order_reserve);
+    nodes_.reserve(config.order_reserve);
+}
+
+void OrderBook::publish_level(Side side, Price price, const PriceLevel& level) noexcept {
+    if (market_data_) {
+        market_data_->on_level_change(symbol_, side, price, level.total_quantity);
+    }
+    if (top_of_book_) {
+        top_of_book_->mark_dirty(top_of_book_slot_);
+    }
+}
+
+PriceLevel* OrderBook::find_level(Side side, Price price) noexcept {
+    if (use_ladder_) {
+        return side == Side::Buy ? buy_ladder_.find(price) : sell_ladder_.find(price);
+    }
+    
+    PriceLevelMap& levels = side == Side::Buy ? buy_levels_ : sell_levels_;
+    auto it = levels.find(price.raw_value());
+    return (it != levels.end()) ? &it->second : nullptr;
+}
+
+const PriceLevel* OrderBook::find_level(Side side, Price price) const noexcept {
+    return const_cast<OrderBook*>(this)->find_level(side, price);
+}
+
+PriceLevel* OrderBook::acquire_level(Side side, Price price) noexcept {
+    if (use_ladder_) {
+        return side == Side::Buy ? buy_ladder_.get_or_create(price) 
+                                 : sell_ladder_.get_or_create(price);
+    }
+    
+    PriceLevelMap& levels = side == Side::Buy ? buy_levels_ : sell_levels_;
+    try {
+        auto& level = levels[price.raw_value()];
+        level.price = price;
+        return &level;
+    } catch (const std::bad_alloc&) {
+        return nullptr;  // A new level's node; the map is unchanged
+    }
+}
+
+void OrderBook::mark_level_occupied(Side side, Price price) {
+    if (use_ladder_) {
+        PriceLadder& ladder = side == Side::Buy ? buy_ladder_ : sell_ladder_;
+        ladder.mark_occupied(ladder.index_of(price));
+    } else {
+        (side == Side::Buy ? buy_occupancy_ : sell_occupancy_).mark(price);
+    }
+}
+
+void OrderBook::release_level(Side side, Price price) noexcept {
+    // Ladder slots stay in place; only the hash backend drops empty levels
+    if (use_ladder_) {
+        PriceLadder& ladder = side == Side::Buy ? buy_ladder_ : sell_ladder_;
+        ladder.mark_empty(ladder.index_of(price));
+    } else {
+        (side == Side::Buy ? buy_occupancy_ : sell_occupancy_).unmark(price);
+        cleanup_empty_level(side == Side::Buy ? buy_levels_ : sell_levels_, price.raw_value());
+    }
+}
+
+void OrderBook::rebuild_occupancy(PriceBitmap& occupancy, const PriceLevelMap& levels, Price center) {
+    occupancy.reanchor(center);
+    for (const auto& [price_raw, level] : levels) {
+        if (!level.is_empty()) {
+            occupancy.mark(Price{price_raw});
+        }
+    }
 }
 
 void OrderBook::update_best_bid() noexcept {
     Price new_best_bid{};
     bool found = false;
     
-    for (const auto& [price_raw, level] : buy_levels_) {
-        if (!level.is_empty()) {
-            Price price{price_raw};
-            if (!found || price > new_best_bid) {
-                new_best_bid = price;
+    if (use_ladder_) {
+        // Nothing rests above the old best, so search down from it
+        if (has_best_bid_ && buy_ladder_.in_band(best_bid_)) {
+            size_t idx = buy_ladder_.prev_occupied(buy_ladder_.index_of(best_bid_));
+            if (idx != LevelBitmap::npos) {
+                new_best_bid = buy_ladder_.price_at(idx);
                 found = true;
             }
         }
+    } else if (buy_occupancy_.exact()) {
+        found = has_best_bid_ && buy_occupancy_.find_prev(best_bid_, new_best_bid);
+    } else {
+        // Some levels sit outside the bitmap window: rescan, then re-centre the window
+        for (const auto& [price_raw, level] : buy_levels_) {
+            if (!level.is_empty()) {
+                Price price{price_raw};
+                if (!found || price > new_best_bid) {
+                    new_best_bid = price;
+                    found = true;
+                }
+            }
+        }
+        
+        if (found) {
+            rebuild_occupancy(buy_occupancy_, buy_levels_, new_best_bid);
+        }
+    }
+    
+    if (!found && !use_ladder_) {
+        buy_occupancy_.clear();
     }
     
     best_bid_ = new_best_bid;
@@ -90,14 +211,36 @@ void OrderBook::update_best_ask() noexcept {
     Price new_best_ask{};
     bool found = false;
     
-    for (const auto& [price_raw, level] : sell_levels_) {
-        if (!level.is_empty()) {
-            Price price{price_raw};
-            if (!found || price < new_best_ask) {
-                new_best_ask = price;
+    if (use_ladder_) {
+        // Nothing rests below the old best, so search up from it
+        if (has_best_ask_ && sell_ladder_.in_band(best_ask_)) {
+            size_t idx = sell_ladder_.next_occupied(sell_ladder_.index_of(best_ask_));
+            if (idx != LevelBitmap::npos) {
+                new_best_ask = sell_ladder_.price_at(idx);
                 found = true;
             }
         }
+    } else if (sell_occupancy_.exact()) {
+        found = has_best_ask_ && sell_occupancy_.find_next(best_ask_, new_best_ask);
+    } else {
+        // Some levels sit outside the bitmap window: rescan, then re-centre the window
+        for (const auto& [price_raw, level] : sell_levels_) {
+            if (!level.is_empty()) {
+                Price price{price_raw};
+                if (!found || price < new_best_ask) {
+                    new_best_ask = price;
+                    found = true;
+                }
+            }
+        }
+        
+        if (found) {
+            rebuild_occupancy(sell_occupancy_, sell_levels_, new_best_ask);
+        }
+    }
+    
+    if (!found && !use_ladder_) {
+        sell_occupancy_.clear();
     }
     
     best_ask_ = new_best_ask;
@@ -111,27 +254,68 @@ void OrderBook::cleanup_empty_level(PriceLevelMap& levels, int64_t price_raw) no
     }
 }
 
+uint32_t OrderBook::acquire_node(Order* order) noexcept {
+    uint32_t node = free_node_;
+    if (node != QueueNode::NIL) {
+        free_node_ = nodes_[node].next;
+    } else {
+        try {
+            node = nodes_.emplace_back();
+        } catch (const std::bad_alloc&) {
+            return QueueNode::NIL;  // The pool is unchanged
+        }
+    }
+    
+    QueueNode& entry = nodes_[node];
+    entry.order_id = order->id;
+    entry.remaining = order->remaining_quantity;
+    entry.order = order;
+    return node;
+}
+
+void OrderBook::release_node(uint32_t node) noexcept {
+    nodes_[node].next = free_node_;
+    free_node_ = node;
+}
+
 bool OrderBook::add_order(Order* order) noexcept {
-    if (orders_.find(order->id) != orders_.end()) {
+    uint32_t node = acquire_node(order);
+    if (node == QueueNode::NIL) {
+        return false;
+    }
+    
+    bool inserted;
+    try {
+        inserted = orders_.insert(order->id, node);
+    } catch (const std::bad_alloc&) {
+        inserted = false;  // Growing the index failed; it keeps its old slots
+    }
+    if (!inserted) {
+        release_node(node);
         return false;
     }
     
-    orders_[order->id] = order;
+    PriceLevel* level = acquire_level(order->side, order->price);
+    if (!level) {
+        orders_.erase(order->id);
+        release_node(node);
+        return false; // Outside what the ladder covers, or no memory for the level
+    }
+    
+    bool was_empty = level->is_empty();
+    level->push_back(nodes_, node);
+    publish_level(order->side, order->price, *level);
+    
+    if (was_empty) {
+        mark_level_occupied(order->side, order->price);
+    }
     
     if (order->is_buy()) {
-        auto& level = buy_levels_[order->price.raw_value()];
-        level.price = order->price;
-        level.add_order(order);
-        
         if (!has_best_bid_ || order->price > best_bid_) {
             best_bid_ = order->price;
             has_best_bid_ = true;
         }
     } else {
-        auto& level = sell_levels_[order->price.raw_value()];
-        level.price = order->price;
-        level.add_order(order);
-        
         if (!has_best_ask_ || order->price < best_ask_) {
             best_ask_ = order->price;
             has_best_ask_ = true;
@@ -141,60 +325,100 @@ bool OrderBook::add_order(Order* order) noexcept {
     return true;
 }
 
-bool OrderBook::remove_order(OrderId order_id) noexcept {
-    auto it = orders_.find(order_id);
-    if (it == orders_.end()) {
-        return false;
-    }
-    
-    Order* order = it->second;
-    orders_.erase(it);
+void OrderBook::detach_node(Side side, PriceLevel* level, uint32_t node) noexcept {
+    Price price = level->price;
+    level->unlink(nodes_, node);
+    release_node(node);
+    publish_level(side, price, *level);  // Before the hash backend frees the level
     
-    if (order->is_buy()) {
-        auto& level = buy_levels_[order->price.raw_value()];
-        level.remove_order(order);
-        
-        if (level.is_empty()) {
-            cleanup_empty_level(buy_levels_, order->price.raw_value());
-            if (has_best_bid_ && order->price == best_bid_) {
+    if (level->is_empty()) {
+        release_level(side, price);
+        if (side == Side::Buy) {
+            if (has_best_bid_ && price == best_bid_) {
                 update_best_bid();
             }
-        }
-    } else {
-        auto& level = sell_levels_[order->price.raw_value()];
-        level.remove_order(order);
-        
-        if (level.is_empty()) {
-            cleanup_empty_level(sell_levels_, order->price.raw_value());
-            if (has_best_ask_ && order->price == best_ask_) {
+        } else {
+            if (has_best_ask_ && price == best_ask_) {
                 update_best_ask();
             }
         }
     }
+}
+
+bool OrderBook::remove_order(OrderId order_id) noexcept {
+    uint32_t node = orders_.extract(order_id);
+    if (node == OrderIndex::npos) {
+        return false;
+    }
+    
+    const Order* order = nodes_[node].order;
+    detach_node(order->side, find_level(order->side, order->price), node);
     
     return true;
 }
 
+bool OrderBook::unlink_order(Order* order) noexcept {
+    PriceLevel* level = find_level(order->side, order->price);
+    if (!level) {
+        return false;
+    }
+    
+    uint32_t node = orders_.extract(order->id);
+    if (node == OrderIndex::npos) {
+        return false;
+    }
+    
+    detach_node(order->side, level, node);
+    return true;
+}
+
+PriceLevel* OrderBook::get_best_bid_level() noexcept {
+    return has_best_bid_ ? find_level(Side::Buy, best_bid_) : nullptr;
+}
+
+PriceLevel* OrderBook::get_best_ask_level() noexcept {
+    return has_best_ask_ ? find_level(Side::Sell, best_ask_) : nullptr;
+}
+
+Order* OrderBook::fill_front(Side side, PriceLevel* level, Quantity quantity) noexcept {
+    uint32_t node = level->head;
+    QueueNode& entry = nodes_[node];
+    entry.remaining -= quantity;
+    level->total_quantity -= quantity;
+    
+    if (entry.remaining > 0) {
+        // Only the last maker of a match can be left partially filled
+        entry.order->remaining_quantity = entry.remaining;
+        publish_level(side, level->price, *level);
+        return nullptr;
+    }
+    
+    Order* order = entry.order;
+    order->remaining_quantity = 0;
+    orders_.erase(entry.order_id);
+    detach_node(side, level, node);
+    return order;
+}
+
 void OrderBook::update_order_quantity(OrderId order_id, Quantity old_quantity) noexcept {
-    auto it = orders_.find(order_id);
-    if (it == orders_.end()) {
+    uint32_t node = orders_.find(order_id);
+    if (node == OrderIndex::npos) {
         return;
     }
     
-    Order* order = it->second;
+    QueueNode& entry = nodes_[node];
+    entry.remaining = entry.order->remaining_quantity;
     
-    if (order->is_buy()) {
-        auto& level = buy_levels_[order->price.raw_value()];
-        level.update_quantity(order, old_quantity);
-    } else {
-        auto& level = sell_levels_[order->price.raw_value()];
-        level.update_quantity(order, old_quantity);
+    PriceLevel* level = find_level(entry.order->side, entry.order->price);
+    if (level) {
+        level->total_quantity = level->total_quantity - old_quantity + entry.remaining;
+        publish_level(entry.order->side, entry.order->price, *level);
     }
 }
 
 Order* OrderBook::get_order(OrderId order_id) const noexcept {
-    auto it = orders_.find(order_id);
-    return (it != orders_.end()) ? it->second : nullptr;
+    uint32_t node = orders_.find(order_id);
+    return node != OrderIndex::npos ? nodes_[node].order : nullptr;
 }
 
 Price OrderBook::get_best_bid() const noexcept {
@@ -214,13 +438,11 @@ bool OrderBook::has_best_ask() const noexcept {
 }
 
 const PriceLevel* OrderBook::get_buy_level(Price price) const noexcept {
-    auto it = buy_levels_.find(price.raw_value());
-    return (it != buy_levels_.end()) ? &it->second : nullptr;
+    return find_level(Side::Buy, price);
 }
 
 const PriceLevel* OrderBook::get_sell_level(Price price) const noexcept {
-    auto it = sell_levels_.find(price.raw_value());
-    return (it != sell_levels_.end()) ? &it->second : nullptr;
+    return find_level(Side::Sell, price);
 }
 
 Symbol OrderBook::get_symbol() const noexcept {
@@ -231,10 +453,38 @@ size_t OrderBook::get_order_count() const noexcept {
     return orders_.size();
 }
 
+const BookConfig& OrderBook::get_config() const noexcept {
+    return config_;
+}
+
+bool OrderBook::accepts_price(Side side, Price price) const noexcept {
+    return !use_ladder_ || (side == Side::Buy ? buy_ladder_ : sell_ladder_).covers(price);
+}
+
+void OrderBook::set_market_data(MarketDataPublisher* publisher) noexcept {
+    market_data_ = publisher;
+}
+
+void OrderBook::set_top_of_book(TopOfBookFeed* feed, uint32_t slot) noexcept {
+    top_of_book_ = feed;
+    top_of_book_slot_ = slot;
+}
+
 std::vector<std::pair<Price, Quantity>> OrderBook::get_bid_levels(size_t depth) const {
     std::vector<std::pair<Price, Quantity>> levels;
     levels.reserve(depth);
     
+    if (use_ladder_) {
+        // Levels are already price-ordered: walk down from the best bid
+        if (depth > 0 && has_best_bid_) {
+            buy_ladder_.walk_down(buy_ladder_.index_of(best_bid_), [&](const PriceLevel& level) {
+                levels.emplace_back(level.price, level.total_quantity);
+                return levels.size() < depth;
+            });
+        }
+        return levels;
+    }
+    
     std::vector<std::pair<Price, Quantity>> all_levels;
     for (const auto& [price_raw, level] : buy_levels_) {
         if (!level.is_empty()) {
@@ -256,6 +506,17 @@ std::vector<std::pair<Price, Quantity>> OrderBook::get_ask_levels(size_t depth)
     std::vector<std::pair<Price, Quantity>> levels;
     levels.reserve(depth);
     
+    if (use_ladder_) {
+        // Levels are already price-ordered: walk up from the best ask
+        if (depth > 0 && has_best_ask_) {
+            sell_ladder_.walk_up(sell_ladder_.index_of(best_ask_), [&](const PriceLevel& level) {
+                levels.emplace_back(level.price, level.total_quantity);
+                return levels.size() < depth;
+            });
+        }
+        return levels;
+    }
+    
     std::vector<std::pair<Price, Quantity>> all_levels;
     for (const auto& [price_raw, level] : sell_levels_) {
         if (!level.is_empty()) {
@@ -273,10 +534,76 @@ std::vector<std::pair<Price, Quantity>> OrderBook::get_ask_levels(size_t depth)
     return levels;
 }
 
+size_t OrderBook::get_cumulative_depth(Side side, size_t depth, Quantity* out) const noexcept {
+    size_t written = 0;
+    for_each_best_level(side, depth, [out, &written](Price, Quantity quantity) {
+        out[written++] = quantity;
+    });
+    depth_kernels::prefix_sum(out, out, written);
+    return written;
+}
+
+DepthSummary OrderBook::get_depth_summary(Side side, size_t depth) const noexcept {
+    DepthSummary summary;
+    __int128 notional = 0;  // Raw price times quantity overflows 64 bits on deep books
+    for_each_best_level(side, depth, [&summary, &notional](Price price, Quantity quantity) {
+        summary.quantity += quantity;
+        notional += static_cast<__int128>(price.raw_value()) * quantity;
+        ++summary.levels;
+    });
+    
+    if (summary.quantity > 0) {
+        summary.vwap = Price{static_cast<int64_t>(notional / summary.quantity)};
+    }
+    return summary;
+}
+
+Quantity OrderBook::get_available_quantity(Side side, Price limit, Quantity needed) const noexcept {
+    // Small blocks first: a fill-or-kill usually completes within the first levels
+    uint64_t block[DEPTH_BLOCK];
+    size_t block_size = 8;
+    size_t count = 0;
+    Quantity available = 0;
+    bool reached = false;
+    
+    auto flush = [&] {
+        uint64_t total = depth_kernels::prefix_sum(block, block, count, available);
+        size_t hit = depth_kernels::first_at_least(block, count, needed);
+        reached = hit < count;
+        available = reached ? block[hit] : total;
+        count = 0;
+        block_size = std::min(block_size * 2, DEPTH_BLOCK);
+    };
+    
+    // No side has more levels than the book has orders
+    for_each_best_level(side, orders_.size(), [&](Price price, Quantity quantity) {
+        if (side == Side::Buy ? price < limit : price > limit) {
+            return false;
+        }
+        block[count++] = quantity;
+        if (count == block_size) {
+            flush();
+            return !reached;
+        }
+        return true;
+    });
+    
+    if (count > 0) {
+        flush();
+    }
+    return available;
+}
+
 void OrderBook::clear() noexcept {
     buy_levels_.clear();
     sell_levels_.clear();
+    buy_ladder_.clear();
+    sell_ladder_.clear();
+    buy_occupancy_.clear();
+    sell_occupancy_.clear();
     orders_.clear();
+    nodes_.clear();
+    free_node_ = QueueNode::NIL;
     has_best_bid_ = false;
     has_best_ask_ = false;
 }
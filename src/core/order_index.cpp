@@ -0,0 +1,112 @@
+#include "nanotrader/core/order_index.hpp"
+#include <bit>
+
+namespace nanotrader {
+
+namespace {
+
+// Max load factor 3/4
+size_t capacity_for(size_t expected) {
+    size_t needed = expected + expected / 3 + 1;
+    size_t capacity = 16;
+    while (capacity < needed) {
+        capacity <<= 1;
+    }
+    return capacity;
+}
+
+} // namespace
+
+OrderIndex::OrderIndex(size_t expected)
+    : mask_(0)
+    , shift_(64)
+    , size_(0)
+    , grow_at_(0) {
+    rehash(capacity_for(expected));
+}
+
+void OrderIndex::rehash(size_t new_capacity) {
+    std::vector<Slot> old_slots(new_capacity, Slot{0, npos});
+    old_slots.swap(slots_);
+    mask_ = new_capacity - 1;
+    shift_ = 64 - static_cast<unsigned>(std::countr_zero(new_capacity));
+    grow_at_ = new_capacity - new_capacity / 4;
+    
+    for (const Slot& slot : old_slots) {
+        if (slot.value != npos) {
+            size_t i = home(slot.key);
+            while (slots_[i].value != npos) {
+                i = (i + 1) & mask_;
+            }
+            slots_[i] = slot;
+        }
+    }
+}
+
+bool OrderIndex::insert(OrderId key, uint32_t value) {
+    if (size_ + 1 > grow_at_) {
+        rehash(slots_.size() * 2);
+    }
+    
+    size_t i = home(key);
+    while (slots_[i].value != npos) {
+        if (slots_[i].key == key) {
+            return false;
+        }
+        i = (i + 1) & mask_;
+    }
+    
+    slots_[i] = Slot{key, value};
+    ++size_;
+    return true;
+}
+
+void OrderIndex::erase_slot(size_t index) noexcept {
+    // Backward-shift: pull later members of the probe run into the hole
+    size_t hole = index;
+    for (size_t i = (hole + 1) & mask_; slots_[i].value != npos; i = (i + 1) & mask_) {
+        size_t ideal = home(slots_[i].key);
+        // Move if the hole lies cyclically within [ideal, i)
+        if (((i - ideal) & mask_) >= ((i - hole) & mask_)) {
+            slots_[hole] = slots_[i];
+            hole = i;
+        }
+    }
+    
+    slots_[hole] = Slot{0, npos};
+    --size_;
+}
+
+bool OrderIndex::erase(OrderId key) noexcept {
+    return extract(key) != npos;
+}
+
+uint32_t OrderIndex::extract(OrderId key) noexcept {
+    for (size_t i = home(key);; i = (i + 1) & mask_) {
+        Slot& slot = slots_[i];
+        if (slot.value == npos) {
+            return npos;
+        }
+        if (slot.key == key) {
+            uint32_t value = slot.value;
+            erase_slot(i);
+            return value;
+        }
+    }
+}
+
+void OrderIndex::reserve(size_t expected) {
+    size_t capacity = capacity_for(expected);
+    if (capacity > slots_.size()) {
+        rehash(capacity);
+    }
+}
+
+void OrderIndex::clear() noexcept {
+    for (Slot& slot : slots_) {
+        slot = Slot{0, npos};
+    }
+    size_ = 0;
+}
+
+} // namespace nanotrader
\ No newline at end of file
@@ -0,0 +1,122 @@
+#include "nanotrader/core/price_ladder.hpp"
+#include <algorithm>
+#include <new>
+
+namespace nanotrader {
+
+PriceLadder::PriceLadder(int64_t tick_size, size_t width, size_t max_width)
+    : levels_(width)
+    , occupancy_(width)
+    , tick_size_(tick_size > 0 ? tick_size : 1)
+    , base_(0)
+    , max_width_(std::max({max_width, width, size_t{1}}))
+    , anchored_(false) {
+}
+
+size_t PriceLadder::span_with(int64_t price_raw, int64_t& lo, int64_t& hi) const noexcept {
+    lo = price_raw;
+    hi = price_raw;
+    if (anchored_) {
+        size_t lowest = occupancy_.lowest();
+        if (lowest != LevelBitmap::npos) {
+            lo = std::min(lo, price_at(lowest).raw_value());
+            hi = std::max(hi, price_at(occupancy_.highest()).raw_value());
+        }
+    }
+    // Unsigned: the distance between any two prices fits even where hi - lo overflows
+    return static_cast<size_t>((static_cast<uint64_t>(hi) - static_cast<uint64_t>(lo)) /
+                               static_cast<uint64_t>(tick_size_)) + 1;
+}
+
+void PriceLadder::rebuild(int64_t new_base, size_t new_width) {
+    std::vector<PriceLevel> new_levels(new_width);
+    for (size_t i = 0; i < new_width; ++i) {
+        new_levels[i].price = Price{new_base + static_cast<int64_t>(i) * tick_size_};
+    }
+    
+    LevelBitmap new_occupancy(new_width);
+    if (anchored_) {
+        walk_up(0, [&](const PriceLevel& level) {
+            size_t idx = static_cast<size_t>((level.price.raw_value() - new_base) / tick_size_);
+            new_levels[idx] = level;
+            new_occupancy.set(idx);
+            return true;
+        });
+    }
+    
+    levels_ = std::move(new_levels);
+    occupancy_ = std::move(new_occupancy);
+    base_ = new_base;
+    anchored_ = true;
+}
+
+bool PriceLadder::rebase_to_cover(int64_t price_raw) noexcept {
+    int64_t lo;
+    int64_t hi;
+    size_t span = span_with(price_raw, lo, hi);
+    if (span > max_width_) {
+        return false;
+    }
+    
+    size_t width = std::max(levels_.size(), std::min<size_t>(64, max_width_));
+    if (span > width) {
+        // Live levels no longer fit: grow to a power of two with headroom, up to the cap
+        while (width < span * 2 && width < max_width_) {
+            width *= 2;
+        }
+        width = std::min(width, max_width_);
+    }
+    
+    // Centre the band on the new price, clamped so every live level stays in range
+    int64_t extent = static_cast<int64_t>(width - 1) * tick_size_;
+    int64_t new_base = price_raw - static_cast<int64_t>(width / 2) * tick_size_;
+    new_base = std::min(new_base, lo);
+    new_base = std::max(new_base, hi - extent);
+    
+    // rebuild() allocates the new band before touching the old one
+    try {
+        rebuild(new_base, width);
+    } catch (const std::bad_alloc&) {
+        return false;
+    }
+    return true;
+}
+
+bool PriceLadder::covers(Price price) const noexcept {
+    if (!on_tick(price)) {
+        return false;
+    }
+    int64_t lo;
+    int64_t hi;
+    return in_band(price) || span_with(price.raw_value(), lo, hi) <= max_width_;
+}
+
+PriceLevel* PriceLadder::find(Price price) noexcept {
+    return in_band(price) ? &levels_[index_of(price)] : nullptr;
+}
+
+const PriceLevel* PriceLadder::find(Price price) const noexcept {
+    return in_band(price) ? &levels_[index_of(price)] : nullptr;
+}
+
+PriceLevel* PriceLadder::get_or_create(Price price) noexcept {
+    if (!on_tick(price)) {
+        return nullptr;
+    }
+    
+    if (!in_band(price) && !rebase_to_cover(price.raw_value())) {
+        return nullptr;
+    }
+    
+    return &levels_[index_of(price)];
+}
+
+void PriceLadder::clear() noexcept {
+    for (size_t i = occupancy_.lowest(); i != LevelBitmap::npos; i = occupancy_.find_next(i + 1)) {
+        levels_[i].total_quantity = 0;
+        levels_[i].head = levels_[i].tail = QueueNode::NIL;
+    }
+    occupancy_.reset();
+}
+
+} // namespace nanotrader
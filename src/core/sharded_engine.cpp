@@ -0,0 +1,114 @@
+#include "nanotrader/core/sharded_engine.hpp"
+#include <algorithm>
+
+namespace nanotrader {
+
+ShardedEngine::ShardedEngine(size_t shard_count, const std::vector<int>& cpus, 
+                             const RunnerConfig& runner_config) 
+    : shards_(std::max<size_t>(shard_count, 1)) {
+    for (size_t i = 0; i < shards_.size(); ++i) {
+        RunnerConfig config = runner_config;
+        config.cpu = i < cpus.size() ? cpus[i] : -1;
+        shards_[i].engine = std::make_unique<MatchingEngine>();
+        shards_[i].runner = std::make_unique<EngineRunner>(*shards_[i].engine, config);
+    }
+}
+
+ShardedEngine::~ShardedEngine() {
+    stop();
+}
+
+OrderBook* ShardedEngine::register_symbol(Symbol symbol, const BookConfig& config) {
+    return shards_[shard_for(symbol)].engine->register_symbol(symbol, config);
+}
+
+bool ShardedEngine::submit_order(const OrderRequest& request) {
+    return shards_[shard_for(request.order.symbol)].engine->submit_order(request);
+}
+
+bool ShardedEngine::get_result(MatchResult& result) {
+    // Round-robin so a busy shard cannot starve the others' output rings
+    for (size_t i = 0; i < shards_.size(); ++i) {
+        size_t index = next_result_shard_;
+        next_result_shard_ = (next_result_shard_ + 1) % shards_.size();
+        if (shards_[index].engine->get_result(result)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void ShardedEngine::start() {
+    if (running_.exchange(true)) {
+        return;
+    }
+    
+    for (Shard& shard : shards_) {
+        shard.runner->start();
+    }
+}
+
+void ShardedEngine::stop() {
+    if (!running_.exchange(false)) {
+        return;
+    }
+    
+    // Stop every shard before joining any, so they drain in parallel
+    for (Shard& shard : shards_) {
+        shard.engine->stop();
+        shard.runner->wake();
+    }
+    for (Shard& shard : shards_) {
+        shard.runner->stop();
+    }
+}
+
+bool ShardedEngine::is_running() const {
+    return running_.load();
+}
+
+size_t ShardedEngine::get_shard_count() const {
+    return shards_.size();
+}
+
+MatchingEngine& ShardedEngine::get_shard(size_t index) {
+    return *shards_[index].engine;
+}
+
+const MatchingEngine& ShardedEngine::get_shard(size_t index) const {
+    return *shards_[index].engine;
+}
+
+EngineRunner& ShardedEngine::get_runner(size_t index) {
+    return *shards_[index].runner;
+}
+
+uint64_t ShardedEngine::get_processed_orders() const {
+    uint64_t total = 0;
+    for (const Shard& shard : shards_) {
+        total += shard.engine->get_processed_orders();
+    }
+    return total;
+}
+
+OrderBook* ShardedEngine::get_order_book(Symbol symbol) {
+    return shards_[shard_for(symbol)].engine->get_order_book(symbol);
+}
+
+size_t ShardedEngine::get_order_book_count() const {
+    size_t total = 0;
+    for (const Shard& shard : shards_) {
+        total += shard.engine->get_order_book_count();
+    }
+    return total;
+}
+
+size_t ShardedEngine::get_total_orders() const {
+    size_t total = 0;
+    for (const Shard& shard : shards_) {
+        total += shard.engine->get_total_orders();
+    }
+    return total;
+}
+
+} // namespace nanotrader
\ No newline at end of file
@@ -0,0 +1,29 @@
+#include "nanotrader/core/symbol_table.hpp"
+
+namespace nanotrader {
+
+SymbolTable::SymbolTable(size_t max_symbol, size_t max_books) 
+    : slots_(max_symbol + 1, nullptr) {
+    books_.reserve(max_books);
+}
+
+OrderBook* SymbolTable::register_symbol(Symbol symbol, const BookConfig& config) {
+    if (symbol >= slots_.size()) {
+        return nullptr;
+    }
+    
+    if (slots_[symbol]) {
+        return slots_[symbol];
+    }
+    
+    // Growing past the reservation would move every book
+    if (books_.size() == books_.capacity()) {
+        return nullptr;
+    }
+    
+    books_.emplace_back(symbol, config);
+    slots_[symbol] = &books_.back().book;
+    return slots_[symbol];
+}
+
+} // namespace nanotrader
\ No newline at end of file
@@ -0,0 +1,135 @@
+#include "nanotrader/core/top_of_book.hpp"
+
+namespace nanotrader {
+
+TopOfBookFeed::TopOfBookFeed(size_t max_books, size_t max_symbol)
+    : slots_(max_books)
+    , slot_of_(max_symbol + 1)
+    , shadows_(max_books) {
+    dirty_.reserve(max_books);
+}
+
+int32_t TopOfBookFeed::add_book(const OrderBook& book) {
+    Symbol symbol = book.get_symbol();
+    if (symbol >= slot_of_.size()) {
+        return -1;
+    }
+    
+    uint32_t existing = slot_of_[symbol].load(std::memory_order_relaxed);
+    if (existing != NO_SLOT) {
+        shadows_[existing - 1].book = &book;
+        mark_dirty(existing - 1);
+        return static_cast<int32_t>(existing - 1);
+    }
+    
+    size_t slot = slot_count_.load(std::memory_order_relaxed);
+    if (slot == slots_.size()) {
+        return -1;
+    }
+    
+    shadows_[slot].book = &book;
+    slot_count_.store(slot + 1, std::memory_order_relaxed);
+    slot_of_[symbol].store(static_cast<uint32_t>(slot + 1), std::memory_order_release);
+    mark_dirty(static_cast<uint32_t>(slot));
+    return static_cast<int32_t>(slot);
+}
+
+void TopOfBookFeed::mark_all_dirty() noexcept {
+    size_t count = slot_count_.load(std::memory_order_relaxed);
+    for (size_t slot = 0; slot < count; ++slot) {
+        mark_dirty(static_cast<uint32_t>(slot));
+    }
+}
+
+void TopOfBookFeed::flush() {
+    for (uint32_t slot : dirty_) {
+        Shadow& shadow = shadows_[slot];
+        shadow.queued = false;
+        
+        TopOfBook top;
+        shadow.book->for_each_best_level(Side::Buy, DEPTH, [&top](Price price, Quantity quantity) {
+            top.bids[top.bid_count++] = {price, quantity};
+        });
+        shadow.book->for_each_best_level(Side::Sell, DEPTH, [&top](Price price, Quantity quantity) {
+            top.asks[top.ask_count++] = {price, quantity};
+        });
+        
+        // Changes below the top DEPTH levels leave readers' cache lines alone
+        if (top.bid_count == shadow.top.bid_count && top.ask_count == shadow.top.ask_count &&
+            top.bids == shadow.top.bids && top.asks == shadow.top.asks) {
+            continue;
+        }
+        shadow.top = top;
+        publish(slot, top);
+    }
+    dirty_.clear();
+}
+
+void TopOfBookFeed::publish(uint32_t slot, const TopOfBook& top) noexcept {
+    Slot& target = slots_[slot];
+    uint64_t seq = target.seq.load(std::memory_order_relaxed);
+    target.seq.store(seq + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    
+    target.bid_count.store(top.bid_count, std::memory_order_relaxed);
+    target.ask_count.store(top.ask_count, std::memory_order_relaxed);
+    for (size_t i = 0; i < DEPTH; ++i) {
+        target.bid_prices[i].store(top.bids[i].price.raw_value(), std::memory_order_relaxed);
+        target.bid_quantities[i].store(top.bids[i].quantity, std::memory_order_relaxed);
+        target.ask_prices[i].store(top.asks[i].price.raw_value(), std::memory_order_relaxed);
+        target.ask_quantities[i].store(top.asks[i].quantity, std::memory_order_relaxed);
+    }
+    
+    target.seq.store(seq + 2, std::memory_order_release);
+}
+
+bool TopOfBookFeed::read(Symbol symbol, TopOfBook& out) const noexcept {
+    if (symbol >= slot_of_.size()) {
+        return false;
+    }
+    uint32_t index = slot_of_[symbol].load(std::memory_order_acquire);
+    if (index == NO_SLOT) {
+        return false;
+    }
+    
+    const Slot& source = slots_[index - 1];
+    for (;;) {
+        uint64_t before = source.seq.load(std::memory_order_acquire);
+        if (before & 1) {
+            continue;  // Writer mid-update
+        }
+        
+        out.bid_count = source.bid_count.load(std::memory_order_relaxed);
+        out.ask_count = source.ask_count.load(std::memory_order_relaxed);
+        for (size_t i = 0; i < DEPTH; ++i) {
+            out.bids[i].price = Price{source.bid_prices[i].load(std::memory_order_relaxed)};
+            out.bids[i].quantity = source.bid_quantities[i].load(std::memory_order_relaxed);
+            out.asks[i].price = Price{source.ask_prices[i].load(std::memory_order_relaxed)};
+            out.asks[i].quantity = source.ask_quantities[i].load(std::memory_order_relaxed);
+        }
+        
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (source.seq.load(std::memory_order_relaxed) == before) {
+            out.symbol = symbol;
+            out.version = before / 2;
+            return true;
+        }
+    }
+}
+
+uint64_t TopOfBookFeed::get_version(Symbol symbol) const noexcept {
+    if (symbol >= slot_of_.size()) {
+        return 0;
+    }
+    uint32_t index = slot_of_[symbol].load(std::memory_order_acquire);
+    if (index == NO_SLOT) {
+        return 0;
+    }
+    return slots_[index - 1].seq.load(std::memory_order_acquire) / 2;
+}
+
+size_t TopOfBookFeed::get_book_count() const noexcept {
+    return slot_count_.load(std::memory_order_relaxed);
+}
+
+} // namespace nanotrader
\ No newline at end of file
@@ -0,0 +1,61 @@
+#include "nanotrader/core/trade_buffer.hpp"
+#include <algorithm>
+#include <memory>
+
+namespace nanotrader {
+
+void TradeBuffer::grow() {
+    Trade* old_data = data();
+    
+    // Inline -> arena block, if one is available
+    if (!block_ && !heap_ && arena_) {
+        SpillBlock* block = arena_->allocate();
+        if (block) {
+            std::uninitialized_copy(old_data, old_data + size_, block->trades);
+            block_ = block;
+            capacity_ = SPILL_CAPACITY;
+            return;
+        }
+    }
+    
+    // Beyond the arena: heap, doubling
+    size_t new_capacity = std::max(capacity_ * 2, SPILL_CAPACITY);
+    std::unique_ptr<Trade[]> heap(new Trade[new_capacity]);
+    std::copy(old_data, old_data + size_, heap.get());
+    
+    if (block_) {
+        arena_->deallocate(block_);
+        block_ = nullptr;
+    }
+    
+    heap_ = std::move(heap);
+    capacity_ = new_capacity;
+}
+
+void TradeBuffer::release() noexcept {
+    if (block_) {
+        arena_->deallocate(block_);
+        block_ = nullptr;
+    }
+    heap_.reset();
+    size_ = 0;
+    capacity_ = INLINE_CAPACITY;
+}
+
+void TradeBuffer::steal(TradeBuffer& other) noexcept {
+    size_ = other.size_;
+    capacity_ = other.capacity_;
+    arena_ = other.arena_;
+    block_ = other.block_;
+    heap_ = std::move(other.heap_);
+    
+    if (!block_ && !heap_) {
+        std::uninitialized_copy(other.inline_data(), other.inline_data() + size_, inline_data());
+    }
+    
+    other.block_ = nullptr;
+    other.size_ = 0;
+    other.capacity_ = INLINE_CAPACITY;
+}
+
+} // namespace nanotrader
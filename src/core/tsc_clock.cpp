@@ -0,0 +1,62 @@
+#include "nanotrader/core/tsc_clock.hpp"
+#include <algorithm>
+
+namespace nanotrader {
+
+void TscClock::calibrate(std::chrono::microseconds window) {
+    auto wall_start = std::chrono::steady_clock::now();
+    Timestamp ts_start = nanotrader::now();
+    uint64_t cycles_start = cycles();
+    
+    while (std::chrono::steady_clock::now() - wall_start < window) {
+        // Busy-wait: sleeping would let the core clock down mid-measurement
+    }
+    
+    Timestamp ts_end = nanotrader::now();
+    uint64_t cycles_end = cycles();
+    
+    uint64_t elapsed_cycles = cycles_end - cycles_start;
+    uint64_t elapsed_ns = ts_end - ts_start;
+    if (elapsed_cycles == 0 || elapsed_ns == 0) {
+        return;
+    }
+    
+    ns_per_cycle_q32_.store(static_cast<uint64_t>(
+        (static_cast<unsigned __int128>(elapsed_ns) << 32) / elapsed_cycles), std::memory_order_relaxed);
+    uint64_t per_us = std::max<uint64_t>(elapsed_cycles * 1000 / elapsed_ns, 1);
+    cycles_per_us_.store(per_us, std::memory_order_relaxed);
+    
+    base_cycles_ = cycles_end;
+    base_time_ = ts_end;
+    reanchor_cycles_ = static_cast<uint64_t>(reanchor_interval_.count()) * 1000 * per_us;
+}
+
+void TscClock::reanchor(uint64_t cycle_count) noexcept {
+    Timestamp wall = nanotrader::now();
+    uint64_t elapsed_cycles = cycle_count - base_cycles_;
+    
+    // The interval is long enough that now()'s own jitter barely moves the rate.
+    // A big disagreement means the counter or now() jumped (suspend, migration
+    // to an unsynchronised core): re-anchor, but keep the old rate.
+    if (wall > base_time_ && elapsed_cycles > 0) {
+        uint64_t elapsed_ns = wall - base_time_;
+        uint64_t rate = static_cast<uint64_t>(
+            (static_cast<unsigned __int128>(elapsed_ns) << 32) / elapsed_cycles);
+        uint64_t current = ns_per_cycle_q32_.load(std::memory_order_relaxed);
+        uint64_t change = rate > current ? rate - current : current - rate;
+        if (static_cast<unsigned __int128>(change) * 1000000 <= 
+            static_cast<unsigned __int128>(current) * MAX_RATE_CHANGE_PPM) {
+            ns_per_cycle_q32_.store(rate, std::memory_order_relaxed);
+            uint64_t per_us = std::max<uint64_t>(
+                static_cast<uint64_t>((static_cast<unsigned __int128>(elapsed_cycles) * 1000) / elapsed_ns), 1);
+            cycles_per_us_.store(per_us, std::memory_order_relaxed);
+        }
+    }
+    
+    base_cycles_ = cycle_count;
+    base_time_ = wall;
+    reanchor_cycles_ = static_cast<uint64_t>(reanchor_interval_.count()) * 1000 * 
+                       cycles_per_us_.load(std::memory_order_relaxed);
+}
+
+} // namespace nanotrader
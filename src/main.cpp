@@ -20,6 +20,7 @@ int main() {
     
     // Create some test orders
     Symbol symbol = 1; // AAPL
+    engine.register_symbol(symbol);
     OrderId next_order_id = 1;
     
     // Add buy order
@@ -0,0 +1,189 @@
+#include "nanotrader/network/gateway.hpp"
+#include "nanotrader/network/io_uring_transport.hpp"
+#include <algorithm>
+
+namespace nanotrader {
+
+namespace {
+std::unique_ptr<GatewayTransport> make_transport(const GatewayConfig& config) {
+    if (config.backend == GatewayConfig::Backend::IoUring) {
+        return std::make_unique<IoUringTransport>();
+    }
+    return std::make_unique<SocketTransport>();
+}
+}
+
+Gateway::Gateway(MatchingEngine& engine, GatewayConfig config) 
+    : Gateway(engine, config, make_transport(config)) {}
+
+Gateway::Gateway(MatchingEngine& engine, GatewayConfig config, std::unique_ptr<GatewayTransport> transport) 
+    : engine_(engine)
+    , config_(std::move(config))
+    , transport_(std::move(transport)) {
+    config_.receive_buffer_size = std::max(config_.receive_buffer_size, 2 * wire::MAX_MESSAGE_SIZE);
+    config_.max_requests_per_poll = std::max<size_t>(config_.max_requests_per_poll, 1);
+    
+    peer_accounts_ = config_.peer_accounts;
+    std::sort(peer_accounts_.begin(), peer_accounts_.end(), 
+              [](const PeerAccount& a, const PeerAccount& b) { return a.address < b.address; });
+}
+
+Gateway::~Gateway() {
+    close();
+}
+
+AccountId Gateway::account_for(uint32_t peer) const noexcept {
+    auto it = std::lower_bound(peer_accounts_.begin(), peer_accounts_.end(), peer,
+                               [](const PeerAccount& entry, uint32_t address) { return entry.address < address; });
+    return peer != 0 && it != peer_accounts_.end() && it->address == peer ? it->account : config_.unknown_peer_account;
+}
+
+size_t Gateway::submit_from(const char* data, size_t size, size_t budget, Timestamp received, AccountId account,
+                            size_t& consumed, bool& malformed, bool& ring_full) {
+    consumed = 0;
+    malformed = false;
+    ring_full = false;
+    bool exhausted = false;
+    uint64_t invalid = 0;
+    
+    size_t submitted = engine_.submit_in_place(budget, [&](OrderRequest& slot) {
+        while (consumed < size) {
+            size_t length = 0;
+            switch (wire::decode(data + consumed, size - consumed, slot, length, received)) {
+                case wire::DecodeStatus::Ok:
+                    consumed += length;
+                    slot.account = account;  // Not the client's to choose
+                    return true;
+                case wire::DecodeStatus::Invalid:
+                    consumed += length;
+                    ++invalid;
+                    continue;
+                case wire::DecodeStatus::Malformed:
+                    malformed = true;
+                    exhausted = true;
+                    return false;
+                case wire::DecodeStatus::Incomplete:
+                    exhausted = true;
+                    return false;
+            }
+        }
+        exhausted = true;
+        return false;
+    });
+    
+    // Stopped with bytes left, neither for lack of data nor budget: the ring is full
+    if (!exhausted && submitted < budget && consumed < size) {
+        ring_full = true;
+        ring_full_.fetch_add(1, std::memory_order_relaxed);
+    }
+    
+    messages_.fetch_add(submitted, std::memory_order_relaxed);
+    if (invalid) {
+        invalid_messages_.fetch_add(invalid, std::memory_order_relaxed);
+    }
+    return submitted;
+}
+
+ReceiveResult Gateway::on_receive(const char* data, size_t size, bool whole_messages, uint32_t peer) {
+    size_t consumed;
+    bool malformed;
+    bool ring_full;
+    submitted_ += submit_from(data, size, budget_ - submitted_, received_, account_for(peer),
+                              consumed, malformed, ring_full);
+    bool stop = ring_full || submitted_ == budget_;
+    
+    if (malformed) {
+        protocol_errors_.fetch_add(1, std::memory_order_relaxed);
+        // No way to find the next message boundary: drop the stream, or skip the datagram
+        return whole_messages ? ReceiveResult{size, stop, false} : ReceiveResult{consumed, stop, true};
+    }
+    
+    // Datagrams carry whole messages: leftovers are truncation or garbage
+    if (whole_messages && consumed < size && !stop) {
+        protocol_errors_.fetch_add(1, std::memory_order_relaxed);
+        return ReceiveResult{size, false, false};
+    }
+    return ReceiveResult{consumed, stop, false};
+}
+
+bool Gateway::open() {
+    return transport_ && transport_->open(config_);
+}
+
+void Gateway::close() {
+    stop();
+    if (transport_) {
+        transport_->close();
+    }
+}
+
+bool Gateway::is_open() const {
+    return transport_ && transport_->is_open();
+}
+
+uint16_t Gateway::local_port() const {
+    return transport_ ? transport_->local_port() : 0;
+}
+
+const char* Gateway::backend_name() const {
+    return transport_ ? transport_->name() : "none";
+}
+
+size_t Gateway::poll() {
+    if (!is_open()) {
+        return 0;
+    }
+    
+    budget_ = config_.max_requests_per_poll;
+    submitted_ = 0;
+    received_ = now();  // One clock read per poll, shared by the batch
+    transport_->poll(*this);
+    return submitted_;
+}
+
+void Gateway::start() {
+    if (!is_open() || running_.exchange(true)) {
+        return;
+    }
+    
+    worker_ = std::thread([this] {
+        while (running_.load(std::memory_order_relaxed)) {
+            poll();
+        }
+    });
+}
+
+void Gateway::stop() {
+    if (!running_.exchange(false)) {
+        return;
+    }
+    if (worker_.joinable()) {
+        worker_.join();
+    }
+}
+
+uint64_t Gateway::get_message_count() const {
+    return messages_.load(std::memory_order_relaxed);
+}
+
+uint64_t Gateway::get_invalid_message_count() const {
+    return invalid_messages_.load(std::memory_order_relaxed);
+}
+
+uint64_t Gateway::get_protocol_error_count() const {
+    return protocol_errors_.load(std::memory_order_relaxed);
+}
+
+uint64_t Gateway::get_ring_full_count() const {
+    return ring_full_.load(std::memory_order_relaxed);
+}
+
+uint64_t Gateway::get_read_count() const {
+    return transport_ ? transport_->read_count() : 0;
+}
+
+size_t Gateway::get_connection_count() const {
+    return transport_ ? transport_->connection_count() : 0;
+}
+
+} // namespace nanotrader
\ No newline at end of file
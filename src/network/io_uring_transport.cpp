@@ -0,0 +1,548 @@
+#include "nanotrader/network/io_uring_transport.hpp"
+#include "nanotrader/network/socket_transport.hpp"
+#include "nanotrader/network/wire_protocol.hpp"
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cerrno>
+#include <cstring>
+
+#if defined(__linux__)
+#include <arpa/inet.h>
+#include <linux/io_uring.h>
+#include <netinet/in.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace nanotrader {
+
+// msghdr for the UDP multishot recvmsg: room for the sender's name, no control
+// data. The kernel reads it at submission, which SQPOLL defers, so it lives here.
+struct IoUringTransport::RecvMsg {
+#if defined(__linux__)
+    msghdr header{};
+#endif
+};
+
+IoUringTransport::IoUringTransport() = default;
+
+IoUringTransport::~IoUringTransport() {
+    close();
+}
+
+const char* IoUringTransport::name() const {
+    return "io_uring";
+}
+
+#if defined(__linux__)
+
+namespace {
+constexpr uint64_t ACCEPT_TAG = ~uint64_t{0};
+constexpr uint64_t IGNORE_TAG = ~uint64_t{0} - 1;  // Cancellations: nothing to do on completion
+constexpr uint16_t BUFFER_GROUP = 0;
+constexpr uint32_t MAX_BUFFERS = 32768;            // Kernel limit for a buffer ring
+// Multishot recvmsg lays each buffer out as this header, the sender, then the payload
+constexpr size_t RECVMSG_PREFIX = sizeof(io_uring_recvmsg_out) + sizeof(sockaddr_in);
+
+inline uint64_t recv_tag(uint32_t slot, uint32_t generation) {
+    return (static_cast<uint64_t>(generation) << 32) | slot;
+}
+
+// The ring indices are shared with the kernel
+inline uint32_t load_acquire(uint32_t* index) {
+    return std::atomic_ref<uint32_t>(*index).load(std::memory_order_acquire);
+}
+
+inline void store_release(uint32_t* index, uint32_t value) {
+    std::atomic_ref<uint32_t>(*index).store(value, std::memory_order_release);
+}
+
+void* map_ring(int fd, size_t size, off_t offset) {
+    void* ring = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, offset);
+    return ring == MAP_FAILED ? nullptr : ring;
+}
+
+void* map_anonymous(size_t size) {
+    void* memory = mmap(nullptr, size, PROT_READ | PROT_WRITE,
+                        MAP_PRIVATE | MAP_ANONYMOUS | MAP_POPULATE, -1, 0);
+    return memory == MAP_FAILED ? nullptr : memory;
+}
+}
+
+bool IoUringTransport::setup_ring() {
+    uint32_t entries = std::bit_ceil(std::clamp<uint32_t>(config_.uring_entries, 8, 4096));
+    
+    io_uring_params params{};
+    params.flags = IORING_SETUP_CQSIZE;
+    params.cq_entries = entries * 4;
+    if (config_.uring_sqpoll) {
+        params.flags |= IORING_SETUP_SQPOLL;
+        params.sq_thread_idle = config_.uring_sqpoll_idle_ms;
+        if (config_.uring_sqpoll_cpu >= 0) {
+            params.flags |= IORING_SETUP_SQ_AFF;
+            params.sq_thread_cpu = static_cast<uint32_t>(config_.uring_sqpoll_cpu);
+        }
+    }
+    
+    ring_fd_ = static_cast<int>(syscall(__NR_io_uring_setup, entries, &params));
+    if (ring_fd_ < 0) {
+        return false;
+    }
+    sqpoll_ = config_.uring_sqpoll;
+    
+    sq_ring_size_ = params.sq_off.array + params.sq_entries * sizeof(uint32_t);
+    cq_ring_size_ = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+    bool single_mmap = params.features & IORING_FEAT_SINGLE_MMAP;
+    if (single_mmap) {
+        sq_ring_size_ = cq_ring_size_ = std::max(sq_ring_size_, cq_ring_size_);
+    }
+    
+    sq_ring_ = map_ring(ring_fd_, sq_ring_size_, IORING_OFF_SQ_RING);
+    cq_ring_ = single_mmap ? sq_ring_ : map_ring(ring_fd_, cq_ring_size_, IORING_OFF_CQ_RING);
+    sqes_size_ = params.sq_entries * sizeof(io_uring_sqe);
+    sqes_ = static_cast<io_uring_sqe*>(map_ring(ring_fd_, sqes_size_, IORING_OFF_SQES));
+    if (!sq_ring_ || !cq_ring_ || !sqes_) {
+        return false;
+    }
+    
+    char* sq = static_cast<char*>(sq_ring_);
+    sq_head_ = reinterpret_cast<uint32_t*>(sq + params.sq_off.head);
+    sq_tail_ = reinterpret_cast<uint32_t*>(sq + params.sq_off.tail);
+    sq_flags_ = reinterpret_cast<uint32_t*>(sq + params.sq_off.flags);
+    sq_array_ = reinterpret_cast<uint32_t*>(sq + params.sq_off.array);
+    sq_mask_ = *reinterpret_cast<uint32_t*>(sq + params.sq_off.ring_mask);
+    sq_entries_ = params.sq_entries;
+    sq_local_tail_ = *sq_tail_;
+    
+    char* cq = static_cast<char*>(cq_ring_);
+    cq_head_ = reinterpret_cast<uint32_t*>(cq + params.cq_off.head);
+    cq_tail_ = reinterpret_cast<uint32_t*>(cq + params.cq_off.tail);
+    cq_mask_ = *reinterpret_cast<uint32_t*>(cq + params.cq_off.ring_mask);
+    cqes_ = reinterpret_cast<io_uring_cqe*>(cq + params.cq_off.cqes);
+    return true;
+}
+
+bool IoUringTransport::setup_buffers() {
+    // Every data completion holds a buffer until the poll that reads it, and the CQ
+    // has room for 4x the SQ, so keep the pool below that to make overflow impossible
+    uint32_t cq_entries = cq_mask_ + 1;
+    buffer_count_ = std::bit_ceil(std::clamp<uint32_t>(config_.uring_buffer_count, 1, MAX_BUFFERS));
+    buffer_count_ = std::min(buffer_count_, std::bit_floor(cq_entries / 2));
+    buffer_size_ = std::max({config_.uring_buffer_size, static_cast<uint32_t>(config_.max_datagram_size),
+                             static_cast<uint32_t>(2 * wire::MAX_MESSAGE_SIZE)});
+    if (datagram_) {
+        buffer_size_ += static_cast<uint32_t>(RECVMSG_PREFIX);
+    }
+    
+    buf_ring_size_ = buffer_count_ * sizeof(io_uring_buf);
+    buf_ring_ = static_cast<io_uring_buf_ring*>(map_anonymous(buf_ring_size_));
+    buffers_size_ = static_cast<size_t>(buffer_count_) * buffer_size_;
+    buffers_ = static_cast<char*>(map_anonymous(buffers_size_));
+    if (!buf_ring_ || !buffers_) {
+        return false;
+    }
+    
+    io_uring_buf_reg registration{};
+    registration.ring_addr = reinterpret_cast<uint64_t>(buf_ring_);
+    registration.ring_entries = buffer_count_;
+    registration.bgid = BUFFER_GROUP;
+    if (syscall(__NR_io_uring_register, ring_fd_, IORING_REGISTER_PBUF_RING, &registration, 1) != 0) {
+        return false;
+    }
+    
+    buf_tail_ = 0;
+    for (uint32_t id = 0; id < buffer_count_; ++id) {
+        recycle(static_cast<uint16_t>(id));
+    }
+    std::atomic_ref<uint16_t>(buf_ring_->tail).store(buf_tail_, std::memory_order_release);
+    return true;
+}
+
+bool IoUringTransport::open(const GatewayConfig& config) {
+    if (is_open()) {
+        return true;
+    }
+    
+    config_ = config;
+    datagram_ = config_.transport == GatewayConfig::Transport::Udp;
+    socket_fd_ = open_gateway_socket(config_, local_port_);
+    if (socket_fd_ < 0 || !setup_ring() || !setup_buffers()) {
+        close();
+        return false;
+    }
+    
+    // A stash holds at most one buffer plus a partial message
+    connections_.resize(datagram_ ? 1 : config_.max_connections);
+    for (Connection& connection : connections_) {
+        connection.stash.reserve(buffer_size_ + 2 * wire::MAX_MESSAGE_SIZE);
+    }
+    
+    if (datagram_) {
+        recv_msg_ = std::make_unique<RecvMsg>();
+        recv_msg_->header.msg_namelen = sizeof(sockaddr_in);
+        connections_[0].fd = socket_fd_;
+        arm_recv(0);
+    } else {
+        arm_accept();
+    }
+    submit();
+    return true;
+}
+
+void IoUringTransport::close() {
+    // Closing the ring cancels every outstanding request
+    if (ring_fd_ >= 0) {
+        ::close(ring_fd_);
+        ring_fd_ = -1;
+    }
+    if (!datagram_) {
+        for (Connection& connection : connections_) {
+            if (connection.fd >= 0) {
+                ::close(connection.fd);
+            }
+        }
+    }
+    connections_.clear();
+    connection_count_ = 0;
+    if (socket_fd_ >= 0) {
+        ::close(socket_fd_);
+        socket_fd_ = -1;
+    }
+    
+    if (cq_ring_ && cq_ring_ != sq_ring_) {
+        munmap(cq_ring_, cq_ring_size_);
+    }
+    if (sq_ring_) {
+        munmap(sq_ring_, sq_ring_size_);
+    }
+    if (sqes_) {
+        munmap(sqes_, sqes_size_);
+    }
+    if (buf_ring_) {
+        munmap(buf_ring_, buf_ring_size_);
+    }
+    if (buffers_) {
+        munmap(buffers_, buffers_size_);
+    }
+    sq_ring_ = cq_ring_ = nullptr;
+    sqes_ = nullptr;
+    buf_ring_ = nullptr;
+    buffers_ = nullptr;
+    sq_pending_ = 0;
+    sqpoll_ = accept_armed_ = rearm_ = backlog_ = false;
+}
+
+io_uring_sqe* IoUringTransport::next_sqe() {
+    if (sq_local_tail_ - load_acquire(sq_head_) >= sq_entries_) {
+        submit();
+        if (sq_local_tail_ - load_acquire(sq_head_) >= sq_entries_) {
+            return nullptr;  // SQPOLL thread hasn't caught up; caller re-arms later
+        }
+    }
+    
+    uint32_t index = sq_local_tail_ & sq_mask_;
+    io_uring_sqe* sqe = &sqes_[index];
+    std::memset(sqe, 0, sizeof(*sqe));
+    sq_array_[index] = index;
+    ++sq_local_tail_;
+    ++sq_pending_;
+    return sqe;
+}
+
+void IoUringTransport::submit() {
+    if (sq_pending_ == 0) {
+        return;
+    }
+    
+    store_release(sq_tail_, sq_local_tail_);
+    if (sqpoll_) {
+        // The kernel thread sees the new tail on its own unless it has gone idle
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (std::atomic_ref<uint32_t>(*sq_flags_).load(std::memory_order_relaxed) & IORING_SQ_NEED_WAKEUP) {
+            syscall(__NR_io_uring_enter, ring_fd_, 0, 0, IORING_ENTER_SQ_WAKEUP, nullptr, 0);
+        }
+        sq_pending_ = 0;
+        return;
+    }
+    
+    long submitted = syscall(__NR_io_uring_enter, ring_fd_, sq_pending_, 0, 0, nullptr, 0);
+    if (submitted > 0) {
+        sq_pending_ -= std::min(sq_pending_, static_cast<uint32_t>(submitted));
+    }
+}
+
+void IoUringTransport::arm_accept() {
+    io_uring_sqe* sqe = next_sqe();
+    if (!sqe) {
+        rearm_ = true;
+        return;
+    }
+    
+    sqe->opcode = IORING_OP_ACCEPT;
+    sqe->fd = socket_fd_;
+    sqe->ioprio = IORING_ACCEPT_MULTISHOT;
+    sqe->accept_flags = SOCK_CLOEXEC;
+    sqe->user_data = ACCEPT_TAG;
+    accept_armed_ = true;
+}
+
+void IoUringTransport::arm_recv(uint32_t slot) {
+    io_uring_sqe* sqe = next_sqe();
+    if (!sqe) {
+        rearm_ = true;
+        return;
+    }
+    
+    Connection& connection = connections_[slot];
+    sqe->opcode = datagram_ ? IORING_OP_RECVMSG : IORING_OP_RECV;
+    sqe->fd = connection.fd;
+    if (datagram_) {
+        sqe->addr = reinterpret_cast<uint64_t>(&recv_msg_->header);
+        sqe->len = 1;
+    }
+    sqe->ioprio = IORING_RECV_MULTISHOT;
+    sqe->flags = IOSQE_BUFFER_SELECT;  // Kernel picks a buffer per completion
+    sqe->buf_group = BUFFER_GROUP;
+    sqe->user_data = recv_tag(slot, connection.generation);
+    connection.armed = true;
+}
+
+void IoUringTransport::rearm() {
+    rearm_ = false;
+    if (!datagram_ && !accept_armed_) {
+        arm_accept();
+    }
+    for (uint32_t slot = 0; slot < connections_.size(); ++slot) {
+        if (connections_[slot].fd >= 0 && !connections_[slot].armed) {
+            arm_recv(slot);
+        }
+    }
+}
+
+void IoUringTransport::recycle(uint16_t buffer_id) {
+    // Indexed by hand: in C++ the uapi flex-array wrapper shifts bufs[] by 8 bytes.
+    // resv is left alone, since in slot 0 it overlays the ring tail.
+    io_uring_buf& buffer = reinterpret_cast<io_uring_buf*>(buf_ring_)[buf_tail_ & (buffer_count_ - 1)];
+    buffer.addr = reinterpret_cast<uint64_t>(buffers_ + static_cast<size_t>(buffer_id) * buffer_size_);
+    buffer.len = buffer_size_;
+    buffer.bid = buffer_id;
+    ++buf_tail_;
+}
+
+void IoUringTransport::accept_client(int fd) {
+    auto slot = std::find_if(connections_.begin(), connections_.end(),
+                             [](const Connection& c) { return c.fd < 0; });
+    if (slot == connections_.end()) {
+        ::close(fd);  // At max_connections
+        return;
+    }
+    
+    tune_gateway_connection(fd, config_);
+    sockaddr_in peer{};
+    socklen_t peer_len = sizeof(peer);
+    slot->fd = fd;
+    slot->peer = getpeername(fd, reinterpret_cast<sockaddr*>(&peer), &peer_len) == 0 ? ntohl(peer.sin_addr.s_addr) : 0;
+    slot->armed = false;
+    slot->backlogged = false;
+    slot->stash.clear();
+    ++connection_count_;
+    arm_recv(static_cast<uint32_t>(slot - connections_.begin()));
+}
+
+void IoUringTransport::close_connection(Connection& connection) {
+    uint32_t slot = static_cast<uint32_t>(&connection - connections_.data());
+    if (connection.armed) {
+        if (io_uring_sqe* sqe = next_sqe()) {
+            sqe->opcode = IORING_OP_ASYNC_CANCEL;
+            sqe->fd = -1;
+            sqe->addr = recv_tag(slot, connection.generation);
+            sqe->user_data = IGNORE_TAG;
+        }
+    }
+    
+    ::close(connection.fd);
+    connection.fd = -1;
+    ++connection.generation;  // Whatever is still in flight for this slot is now stale
+    connection.armed = false;
+    connection.backlogged = false;
+    connection.stash.clear();
+    --connection_count_;
+}
+
+bool IoUringTransport::deliver(Connection& connection, const char* data, size_t size,
+                               ReceiveHandler& handler) {
+    if (!connection.stash.empty()) {
+        // Complete the stashed message with at most one message's worth of new bytes
+        size_t held = connection.stash.size();
+        size_t bridge = std::min(size, wire::MAX_MESSAGE_SIZE);
+        connection.stash.insert(connection.stash.end(), data, data + bridge);
+        
+        ReceiveResult result = handler.on_receive(connection.stash.data(), connection.stash.size(), datagram_,
+                                                  connection.peer);
+        if (result.drop) {
+            close_connection(connection);
+            return result.stop;
+        }
+        if (result.consumed < held) {
+            connection.stash.erase(connection.stash.begin(), connection.stash.begin() + result.consumed);
+            connection.stash.insert(connection.stash.end(), data + bridge, data + size);
+            connection.backlogged = result.stop;
+            backlog_ = backlog_ || result.stop;
+            return result.stop;
+        }
+        
+        // Stash drained: carry on in the kernel buffer past what the bridge used
+        connection.stash.clear();
+        size_t offset = result.consumed - held;
+        data += offset;
+        size -= offset;
+        if (result.stop || size == 0) {
+            connection.stash.assign(data, data + size);
+            connection.backlogged = size > 0;
+            backlog_ = backlog_ || connection.backlogged;
+            return result.stop;
+        }
+    }
+    
+    ReceiveResult result = handler.on_receive(data, size, datagram_, connection.peer);
+    if (result.drop) {
+        close_connection(connection);
+        return result.stop;
+    }
+    
+    // Whatever is left must outlive the buffer, which goes back to the kernel
+    connection.stash.assign(data + result.consumed, data + size);
+    connection.backlogged = result.stop && !connection.stash.empty();
+    backlog_ = backlog_ || connection.backlogged;
+    return result.stop;
+}
+
+bool IoUringTransport::complete(const io_uring_cqe& cqe, ReceiveHandler& handler) {
+    if (cqe.user_data == ACCEPT_TAG) {
+        if (cqe.res >= 0) {
+            accept_client(cqe.res);
+        }
+        if (!(cqe.flags & IORING_CQE_F_MORE)) {
+            accept_armed_ = false;
+            rearm_ = true;
+        }
+        return false;
+    }
+    if (cqe.user_data == IGNORE_TAG) {
+        return false;
+    }
+    
+    bool has_buffer = cqe.flags & IORING_CQE_F_BUFFER;
+    uint16_t buffer_id = static_cast<uint16_t>(cqe.flags >> IORING_CQE_BUFFER_SHIFT);
+    uint32_t slot = static_cast<uint32_t>(cqe.user_data);
+    uint32_t generation = static_cast<uint32_t>(cqe.user_data >> 32);
+    bool stop = false;
+    
+    if (slot < connections_.size()) {
+        Connection& connection = connections_[slot];
+        if (connection.fd >= 0 && connection.generation == generation) {
+            const char* data = buffers_ + static_cast<size_t>(buffer_id) * buffer_size_;
+            size_t size = cqe.res > 0 ? static_cast<size_t>(cqe.res) : 0;
+            if (datagram_ && has_buffer && size >= RECVMSG_PREFIX) {
+                io_uring_recvmsg_out out;
+                sockaddr_in sender{};
+                std::memcpy(&out, data, sizeof(out));
+                std::memcpy(&sender, data + sizeof(out), sizeof(sender));
+                connection.peer = out.namelen >= sizeof(sender) ? ntohl(sender.sin_addr.s_addr) : 0;
+                data += RECVMSG_PREFIX;
+                size = std::min<size_t>(out.payloadlen, size - RECVMSG_PREFIX);  // Less if truncated
+            } else if (datagram_) {
+                size = 0;
+            }
+            if (size > 0 && has_buffer) {
+                reads_.fetch_add(1, std::memory_order_relaxed);
+                stop = deliver(connection, data, size, handler);
+            } else if (!datagram_ && cqe.res != -ENOBUFS && cqe.res <= 0) {
+                close_connection(connection);  // Orderly shutdown or socket error
+            }
+        }
+        
+        // Multishot ended (out of buffers, CQ pressure, ...): resubmit after this poll
+        if (connection.fd >= 0 && connection.generation == generation && !(cqe.flags & IORING_CQE_F_MORE)) {
+            connection.armed = false;
+            rearm_ = true;
+        }
+    }
+    
+    if (has_buffer) {
+        recycle(buffer_id);  // deliver() has decoded or stashed its bytes
+    }
+    return stop;
+}
+
+void IoUringTransport::poll(ReceiveHandler& handler) {
+    bool stop = false;
+    if (backlog_) {
+        backlog_ = false;
+        for (Connection& connection : connections_) {
+            if (connection.backlogged && deliver(connection, nullptr, 0, handler)) {
+                stop = true;
+                break;
+            }
+        }
+    }
+    
+    uint32_t head = *cq_head_;
+    uint32_t tail = load_acquire(cq_tail_);
+    while (!stop && head != tail) {
+        stop = complete(cqes_[head & cq_mask_], handler);
+        ++head;
+    }
+    store_release(cq_head_, head);
+    std::atomic_ref<uint16_t>(buf_ring_->tail).store(buf_tail_, std::memory_order_release);
+    
+    if (rearm_) {
+        rearm();
+    }
+    submit();
+}
+
+#else
+
+bool IoUringTransport::setup_ring() {
+    return false;
+}
+
+bool IoUringTransport::setup_buffers() {
+    return false;
+}
+
+bool IoUringTransport::open(const GatewayConfig&) {
+    return false;  // io_uring is Linux-only
+}
+
+void IoUringTransport::close() {}
+
+void IoUringTransport::poll(ReceiveHandler&) {}
+
+#endif
+
+bool IoUringTransport::is_open() const {
+    return ring_fd_ >= 0;
+}
+
+uint16_t IoUringTransport::local_port() const {
+    return local_port_;
+}
+
+size_t IoUringTransport::connection_count() const {
+    return connection_count_.load(std::memory_order_relaxed);
+}
+
+uint64_t IoUringTransport::read_count() const {
+    return reads_.load(std::memory_order_relaxed);
+}
+
+bool IoUringTransport::using_sqpoll() const {
+    return sqpoll_;
+}
+
+} // namespace nanotrader
\ No newline at end of file
@@ -0,0 +1,506 @@
+#include "nanotrader/network/shm_gateway.hpp"
+#include <algorithm>
+#include <bit>
+#include <new>
+
+#if defined(__linux__)
+#include <cerrno>
+#include <csignal>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace nanotrader {
+
+namespace shm {
+
+Request Request::from_request(const OrderRequest& request) noexcept {
+    Request out{};
+    out.order_id = request.order.id;
+    out.price = request.order.price.raw_value();
+    out.quantity = request.order.quantity;
+    out.new_quantity = request.new_quantity;
+    out.symbol = request.order.symbol;
+    out.request_type = static_cast<uint8_t>(request.type);
+    out.side = static_cast<uint8_t>(request.order.side);
+    out.order_type = static_cast<uint8_t>(request.order.type);
+    return out;
+}
+
+bool Request::to_request(OrderRequest& out, Timestamp received, AccountId account) const noexcept {
+    // Written by another process: nothing reaches the engine unchecked
+    if (request_type > static_cast<uint8_t>(OrderRequest::Type::Replace) ||
+        side > static_cast<uint8_t>(Side::Sell) ||
+        order_type > static_cast<uint8_t>(OrderType::FOK)) {
+        return false;
+    }
+    
+    out.type = static_cast<OrderRequest::Type>(request_type);
+    out.account = account;  // Bound by the host, never taken from the client
+    out.order = Order(order_id, symbol, Price(price), quantity,
+                      static_cast<Side>(side), static_cast<OrderType>(order_type), received);
+    out.new_quantity = new_quantity;
+    return true;
+}
+
+} // namespace shm
+
+// ShmGateway
+ShmGateway::ShmGateway(MatchingEngine& engine, ShmConfig config)
+    : engine_(engine)
+    , config_(std::move(config)) {
+    config_.max_requests_per_poll = std::max<size_t>(config_.max_requests_per_poll, 1);
+    config_.max_requests_per_lane = std::max<size_t>(config_.max_requests_per_lane, 1);
+    config_.max_in_flight_per_lane = std::bit_ceil(std::max<size_t>(config_.max_in_flight_per_lane, 1));
+    config_.liveness_check_polls = std::max<size_t>(config_.liveness_check_polls, 1);
+}
+
+ShmGateway::~ShmGateway() {
+    close();
+}
+
+bool ShmGateway::open() {
+#if defined(__linux__)
+    if (segment_ || config_.lanes == 0 || config_.lanes > shm::MAX_LANES) {
+        return false;
+    }
+    
+    const size_t size = shm::segment_size(config_.lanes);
+    shm_unlink(config_.name.c_str());  // Left behind by an earlier run
+    int fd = shm_open(config_.name.c_str(), O_CREAT | O_EXCL | O_RDWR, static_cast<mode_t>(config_.permissions));
+    if (fd < 0) {
+        return false;
+    }
+    void* segment = MAP_FAILED;
+    if (ftruncate(fd, static_cast<off_t>(size)) == 0) {
+        // Prefaulted: the polling loop never takes a page fault on a lane
+        segment = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, 0);
+    }
+    ::close(fd);
+    if (segment == MAP_FAILED) {
+        shm_unlink(config_.name.c_str());
+        return false;
+    }
+    
+    auto* header = new (segment) shm::SegmentHeader();
+    header->magic = shm::MAGIC;
+    header->version = shm::VERSION;
+    header->lane_count = static_cast<uint32_t>(config_.lanes);
+    header->request_slots = static_cast<uint32_t>(shm::REQUEST_SLOTS);
+    header->report_slots = static_cast<uint32_t>(shm::REPORT_SLOTS);
+    header->lane_size = static_cast<uint32_t>(sizeof(shm::Lane));
+    header->host_pid = static_cast<uint32_t>(getpid());
+    header->lane_offset = sizeof(shm::SegmentHeader);
+    
+    lanes_ = reinterpret_cast<shm::Lane*>(static_cast<char*>(segment) + header->lane_offset);
+    for (size_t i = 0; i < config_.lanes; ++i) {
+        new (&lanes_[i]) shm::Lane();
+    }
+    
+    // Each lane has at most max_in_flight_per_lane requests in flight, so routes
+    // never wrap onto live entries and every result has a backlog slot
+    const size_t in_flight_cap = config_.max_in_flight_per_lane;
+    routes_.assign(std::bit_ceil(config_.lanes * in_flight_cap), 0);
+    route_head_ = route_tail_ = 0;
+    in_flight_.assign(config_.lanes, 0);
+    held_.clear();
+    held_.resize(config_.lanes * in_flight_cap);
+    backlogs_.assign(config_.lanes, Backlog{});
+    held_mask_ = in_flight_cap - 1;
+    held_lanes_ = 0;
+    config_.lane_accounts.resize(config_.lanes, NO_ACCOUNT);
+    next_lane_ = 0;
+    polls_ = 0;
+    segment_ = segment;
+    segment_size_ = size;
+    
+    header->ready.store(1, std::memory_order_release);
+    return true;
+#else
+    return false;
+#endif
+}
+
+void ShmGateway::close() {
+    stop();
+#if defined(__linux__)
+    if (!segment_) {
+        return;
+    }
+    
+    static_cast<shm::SegmentHeader*>(segment_)->ready.store(0, std::memory_order_release);
+    munmap(segment_, segment_size_);
+    shm_unlink(config_.name.c_str());
+    segment_ = nullptr;
+    lanes_ = nullptr;
+#endif
+}
+
+bool ShmGateway::is_open() const {
+    return segment_ != nullptr;
+}
+
+const std::string& ShmGateway::name() const {
+    return config_.name;
+}
+
+bool ShmGateway::push_records(shm::Lane& lane, const MatchResult& result, size_t& next) {
+    const size_t total = result.trades.size() + 1;
+    
+    while (next < total) {
+        size_t count = std::min(staging_.size(), total - next);
+        for (size_t i = 0; i < count; ++i) {
+            size_t record = next + i;
+            shm::Report& report = staging_[i];
+            report = shm::Report{};
+            if (record == 0) {
+                report.status = result.status;
+                report.trade_count = static_cast<uint32_t>(total - 1);
+                report.order_id = result.order_id;
+            } else {
+                report.kind = shm::Report::Kind::Trade;
+                report.trade = result.trades[record - 1];
+            }
+        }
+        
+        size_t pushed = lane.reports.try_push_batch(staging_.begin(), count);
+        next += pushed;
+        if (pushed < count) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void ShmGateway::flush_backlog(size_t index) {
+    Backlog& backlog = backlogs_[index];
+    if (backlog.head == backlog.tail) {
+        return;
+    }
+    
+    shm::Lane& lane = lanes_[index];
+    const bool claimed = lane.state.load(std::memory_order_acquire) == shm::Claimed;
+    while (backlog.head != backlog.tail) {
+        MatchResult& result = held_[index * (held_mask_ + 1) + (backlog.head & held_mask_)];
+        if (!claimed) {
+            discarded_results_.fetch_add(1, std::memory_order_relaxed);
+        } else if (push_records(lane, result, backlog.next)) {
+            results_.fetch_add(1, std::memory_order_relaxed);
+        } else {
+            return;  // Still no room; tried again on the next poll
+        }
+        
+        result = MatchResult();  // Hands any spill block back to the engine's arena
+        ++backlog.head;
+        backlog.next = 0;
+        --in_flight_[index];
+    }
+    --held_lanes_;
+}
+
+void ShmGateway::deliver() {
+    // Held results go first, so each lane still gets its results in order
+    for (size_t i = 0; held_lanes_ > 0 && i < config_.lanes; ++i) {
+        flush_backlog(i);
+    }
+    
+    const size_t mask = routes_.size() - 1;
+    MatchResult result;
+    while (engine_.get_result(result)) {
+        size_t index = routes_[route_head_++ & mask];
+        shm::Lane& lane = lanes_[index];
+        Backlog& backlog = backlogs_[index];
+        size_t next = 0;
+        
+        if (lane.state.load(std::memory_order_acquire) != shm::Claimed) {
+            discarded_results_.fetch_add(1, std::memory_order_relaxed);
+        } else if (backlog.head == backlog.tail && push_records(lane, result, next)) {
+            results_.fetch_add(1, std::memory_order_relaxed);
+        } else {
+            // Its client is behind: park the rest on the host instead of holding up other lanes
+            if (backlog.head == backlog.tail) {
+                backlog.next = next;
+                ++held_lanes_;
+            }
+            held_[index * (held_mask_ + 1) + (backlog.tail++ & held_mask_)] = std::move(result);
+            report_stalls_.fetch_add(1, std::memory_order_relaxed);
+            continue;  // Still in flight
+        }
+        --in_flight_[index];
+    }
+}
+
+size_t ShmGateway::admit(size_t index, size_t budget, Timestamp received) {
+    shm::Lane& lane = lanes_[index];
+    
+    // Credit: a report slot for the result of everything in flight and everything admitted
+    // now, and never more in flight than the lane's backlog can hold
+    size_t room = lane.reports.capacity() - lane.reports.size();
+    size_t in_flight = in_flight_[index];
+    if (room <= in_flight || in_flight >= config_.max_in_flight_per_lane) {
+        return 0;
+    }
+    size_t limit = std::min({budget, config_.max_requests_per_lane, room - in_flight,
+                             config_.max_in_flight_per_lane - in_flight});
+    
+    const size_t mask = routes_.size() - 1;
+    const AccountId account = config_.lane_accounts[index];
+    uint64_t invalid = 0;
+    size_t submitted = engine_.submit_in_place(limit, [&](OrderRequest& slot) {
+        shm::Request request;
+        while (lane.requests.try_pop(request)) {
+            if (request.to_request(slot, received, account)) {
+                routes_[route_tail_++ & mask] = static_cast<uint16_t>(index);
+                return true;
+            }
+            ++invalid;
+        }
+        return false;
+    });
+    
+    in_flight_[index] += static_cast<uint32_t>(submitted);
+    if (invalid) {
+        invalid_requests_.fetch_add(invalid, std::memory_order_relaxed);
+    }
+    return submitted;
+}
+
+void ShmGateway::recycle(size_t index) {
+    if (in_flight_[index] > 0) {
+        return;  // Their results, held ones included, are discarded as they come out
+    }
+    
+    // The client has let go of both rings: rebuild them empty and reopen the lane
+    shm::Lane& lane = lanes_[index];
+    new (&lane.requests) SPSCRingBuffer<shm::Request, shm::REQUEST_SLOTS>();
+    new (&lane.reports) SPSCRingBuffer<shm::Report, shm::REPORT_SLOTS>();
+    lane.owner_pid.store(0, std::memory_order_relaxed);
+    lane.state.store(shm::Free, std::memory_order_release);
+}
+
+void ShmGateway::reclaim_abandoned() {
+#if defined(__linux__)
+    for (size_t i = 0; i < config_.lanes; ++i) {
+        shm::Lane& lane = lanes_[i];
+        pid_t owner = static_cast<pid_t>(lane.owner_pid.load(std::memory_order_relaxed));
+        if (owner == 0 || lane.state.load(std::memory_order_acquire) != shm::Claimed) {
+            continue;  // Unclaimed, or claimed and its pid not stored yet
+        }
+        
+        // Only ESRCH means gone; EPERM is a live process of another user
+        if (kill(owner, 0) != 0 && errno == ESRCH) {
+            uint32_t expected = shm::Claimed;
+            if (lane.state.compare_exchange_strong(expected, shm::Closing, std::memory_order_acq_rel)) {
+                abandoned_lanes_.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+    }
+#endif
+}
+
+size_t ShmGateway::poll() {
+    if (!is_open()) {
+        return 0;
+    }
+    
+    if (++polls_ % config_.liveness_check_polls == 0) {
+        reclaim_abandoned();
+    }
+    deliver();
+    
+    // Round-robin, starting one lane further each poll
+    const size_t lane_count = config_.lanes;
+    const size_t start = next_lane_;
+    next_lane_ = start + 1 == lane_count ? 0 : start + 1;
+    
+    size_t submitted = 0;
+    Timestamp received = now();  // One clock read per poll, shared by the batch
+    for (size_t visited = 0; visited < lane_count && submitted < config_.max_requests_per_poll; ++visited) {
+        size_t index = (start + visited) % lane_count;
+        switch (lanes_[index].state.load(std::memory_order_acquire)) {
+            case shm::Claimed:
+                submitted += admit(index, config_.max_requests_per_poll - submitted, received);
+                break;
+            case shm::Closing:
+                recycle(index);
+                break;
+            default:
+                break;
+        }
+    }
+    
+    requests_.fetch_add(submitted, std::memory_order_relaxed);
+    return submitted;
+}
+
+void ShmGateway::start() {
+    if (!is_open() || running_.exchange(true)) {
+        return;
+    }
+    
+    worker_ = std::thread([this] {
+        while (running_.load(std::memory_order_relaxed)) {
+            poll();
+        }
+    });
+}
+
+void ShmGateway::stop() {
+    if (!running_.exchange(false)) {
+        return;
+    }
+    if (worker_.joinable()) {
+        worker_.join();
+    }
+}
+
+size_t ShmGateway::get_client_count() const {
+    size_t count = 0;
+    for (size_t i = 0; lanes_ && i < config_.lanes; ++i) {
+        count += lanes_[i].state.load(std::memory_order_relaxed) == shm::Claimed;
+    }
+    return count;
+}
+
+uint64_t ShmGateway::get_request_count() const {
+    return requests_.load(std::memory_order_relaxed);
+}
+
+uint64_t ShmGateway::get_result_count() const {
+    return results_.load(std::memory_order_relaxed);
+}
+
+uint64_t ShmGateway::get_invalid_request_count() const {
+    return invalid_requests_.load(std::memory_order_relaxed);
+}
+
+uint64_t ShmGateway::get_discarded_result_count() const {
+    return discarded_results_.load(std::memory_order_relaxed);
+}
+
+uint64_t ShmGateway::get_report_stall_count() const {
+    return report_stalls_.load(std::memory_order_relaxed);
+}
+
+uint64_t ShmGateway::get_abandoned_lane_count() const {
+    return abandoned_lanes_.load(std::memory_order_relaxed);
+}
+
+// ShmClient
+ShmClient::~ShmClient() {
+    disconnect();
+}
+
+bool ShmClient::connect(const std::string& name, size_t lane) {
+#if defined(__linux__)
+    if (lane_) {
+        return false;
+    }
+    
+    int fd = shm_open(name.c_str(), O_RDWR, 0);
+    if (fd < 0) {
+        return false;
+    }
+    struct stat info{};
+    size_t size = 0;
+    void* segment = MAP_FAILED;
+    if (fstat(fd, &info) == 0 && static_cast<size_t>(info.st_size) >= sizeof(shm::SegmentHeader)) {
+        size = static_cast<size_t>(info.st_size);
+        segment = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    }
+    ::close(fd);
+    if (segment == MAP_FAILED) {
+        return false;
+    }
+    
+    // Ready is stored last, so the rest of the header is complete once it reads 1
+    const auto* header = static_cast<const shm::SegmentHeader*>(segment);
+    bool compatible = header->ready.load(std::memory_order_acquire) == 1 &&
+                      header->magic == shm::MAGIC && header->version == shm::VERSION &&
+                      header->request_slots == shm::REQUEST_SLOTS && header->report_slots == shm::REPORT_SLOTS &&
+                      header->lane_size == sizeof(shm::Lane) && header->lane_offset == sizeof(shm::SegmentHeader) &&
+                      header->lane_count <= shm::MAX_LANES && shm::segment_size(header->lane_count) <= size;
+    if (compatible) {
+        auto* lanes = reinterpret_cast<shm::Lane*>(static_cast<char*>(segment) + header->lane_offset);
+        size_t first = lane == ANY_LANE ? 0 : lane;
+        size_t last = lane == ANY_LANE ? header->lane_count : std::min<size_t>(lane + 1, header->lane_count);
+        for (size_t i = first; i < last; ++i) {
+            uint32_t expected = shm::Free;
+            if (lanes[i].state.compare_exchange_strong(expected, shm::Claimed, std::memory_order_acq_rel)) {
+                lanes[i].owner_pid.store(static_cast<uint32_t>(getpid()), std::memory_order_relaxed);
+                segment_ = segment;
+                segment_size_ = size;
+                lane_ = &lanes[i];
+                lane_index_ = i;
+                has_partial_ = false;
+                return true;
+            }
+        }
+    }
+    
+    munmap(segment, size);
+    return false;
+#else
+    (void)name;
+    (void)lane;
+    return false;
+#endif
+}
+
+void ShmClient::disconnect() {
+#if defined(__linux__)
+    if (!lane_) {
+        return;
+    }
+    
+    lane_->state.store(shm::Closing, std::memory_order_release);
+    munmap(segment_, segment_size_);
+    segment_ = nullptr;
+    lane_ = nullptr;
+    has_partial_ = false;
+#endif
+}
+
+bool ShmClient::is_connected() const {
+    return lane_ != nullptr;
+}
+
+size_t ShmClient::lane_index() const {
+    return lane_index_;
+}
+
+bool ShmClient::submit(const OrderRequest& request) {
+    return lane_ && lane_->requests.try_push(shm::Request::from_request(request));
+}
+
+bool ShmClient::get_result(MatchResult& result) {
+    if (!lane_) {
+        return false;
+    }
+    
+    shm::Report report;
+    if (!has_partial_) {
+        if (!lane_->reports.try_pop(report)) {
+            return false;
+        }
+        partial_ = MatchResult(report.status, report.order_id);
+        partial_trades_ = report.trade_count;
+        has_partial_ = true;
+    }
+    
+    // The host may still be writing the tail of a long sweep
+    while (partial_.trades.size() < partial_trades_) {
+        if (!lane_->reports.try_pop(report)) {
+            return false;
+        }
+        partial_.trades.emplace_back(report.trade);
+    }
+    
+    result = std::move(partial_);
+    has_partial_ = false;
+    return true;
+}
+
+} // namespace nanotrader
\ No newline at end of file
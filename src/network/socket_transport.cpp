@@ -0,0 +1,348 @@
+#include "nanotrader/network/socket_transport.hpp"
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <cstring>
+
+#if defined(__linux__)
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
+namespace nanotrader {
+
+namespace {
+constexpr uint64_t LISTEN_TAG = ~uint64_t{0};
+constexpr int EPOLL_BATCH = 64;
+}
+
+SocketTransport::~SocketTransport() {
+    close();
+}
+
+const char* SocketTransport::name() const {
+    return "socket";
+}
+
+#if defined(__linux__)
+
+int open_gateway_socket(const GatewayConfig& config, uint16_t& local_port) {
+    bool tcp = config.transport == GatewayConfig::Transport::Tcp;
+    int fd = ::socket(AF_INET, (tcp ? SOCK_STREAM : SOCK_DGRAM) | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (fd < 0) {
+        return -1;
+    }
+    
+    int one = 1;
+    setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+#ifdef SO_BUSY_POLL
+    if (!tcp && config.socket_busy_poll_us > 0) {
+        setsockopt(fd, SOL_SOCKET, SO_BUSY_POLL, &config.socket_busy_poll_us,
+                   sizeof(config.socket_busy_poll_us));
+    }
+#endif
+    
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(config.port);
+    if (inet_pton(AF_INET, config.bind_address.c_str(), &addr.sin_addr) != 1 ||
+        ::bind(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0 ||
+        (tcp && ::listen(fd, static_cast<int>(config.max_connections)) != 0)) {
+        ::close(fd);
+        return -1;
+    }
+    
+    socklen_t len = sizeof(addr);
+    getsockname(fd, reinterpret_cast<sockaddr*>(&addr), &len);
+    local_port = ntohs(addr.sin_port);
+    return fd;
+}
+
+void tune_gateway_connection(int fd, const GatewayConfig& config) {
+    int one = 1;
+    setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+#ifdef SO_BUSY_POLL
+    if (config.socket_busy_poll_us > 0) {
+        setsockopt(fd, SOL_SOCKET, SO_BUSY_POLL, &config.socket_busy_poll_us,
+                   sizeof(config.socket_busy_poll_us));
+    }
+#else
+    (void)config;
+#endif
+}
+
+bool SocketTransport::open(const GatewayConfig& config) {
+    if (is_open()) {
+        return true;
+    }
+    
+    config_ = config;
+    config_.datagram_batch = std::clamp<size_t>(config_.datagram_batch, 1, MAX_DATAGRAM_BATCH);
+    listen_fd_ = open_gateway_socket(config_, local_port_);
+    if (listen_fd_ < 0) {
+        return false;
+    }
+    
+    if (config_.transport == GatewayConfig::Transport::Tcp) {
+        epoll_fd_ = epoll_create1(EPOLL_CLOEXEC);
+        epoll_event event{};
+        event.events = EPOLLIN | EPOLLET;
+        event.data.u64 = LISTEN_TAG;
+        if (epoll_fd_ < 0 || epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, listen_fd_, &event) != 0) {
+            close();
+            return false;
+        }
+        
+        connections_.resize(config_.max_connections);
+        for (Connection& connection : connections_) {
+            connection.buffer.resize(config_.receive_buffer_size);
+        }
+    } else {
+        datagrams_.assign(config_.datagram_batch, std::vector<char>(config_.max_datagram_size));
+        datagram_sizes_.assign(config_.datagram_batch, 0);
+        datagram_peers_.assign(config_.datagram_batch, 0);
+    }
+    
+    return true;
+}
+
+void SocketTransport::close() {
+    for (Connection& connection : connections_) {
+        if (connection.fd >= 0) {
+            close_connection(connection);
+        }
+    }
+    if (epoll_fd_ >= 0) {
+        ::close(epoll_fd_);
+        epoll_fd_ = -1;
+    }
+    if (listen_fd_ >= 0) {
+        ::close(listen_fd_);
+        listen_fd_ = -1;
+    }
+    datagram_next_ = datagram_count_ = datagram_offset_ = 0;
+}
+
+void SocketTransport::accept_clients() {
+    for (;;) {
+        sockaddr_in peer{};
+        socklen_t peer_len = sizeof(peer);
+        int fd = accept4(listen_fd_, reinterpret_cast<sockaddr*>(&peer), &peer_len, SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (fd < 0) {
+            if (errno == EINTR) continue;
+            return;  // EAGAIN: backlog drained
+        }
+        
+        auto slot = std::find_if(connections_.begin(), connections_.end(),
+                                 [](const Connection& c) { return c.fd < 0; });
+        if (slot == connections_.end()) {
+            ::close(fd);  // At max_connections
+            continue;
+        }
+        
+        tune_gateway_connection(fd, config_);
+        
+        epoll_event event{};
+        event.events = EPOLLIN | EPOLLRDHUP | EPOLLET;
+        event.data.u64 = static_cast<uint64_t>(slot - connections_.begin());
+        if (epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, fd, &event) != 0) {
+            ::close(fd);
+            continue;
+        }
+        
+        slot->fd = fd;
+        slot->peer = ntohl(peer.sin_addr.s_addr);
+        slot->begin = slot->end = 0;
+        slot->readable = true;  // Bytes may have arrived before registration
+        ++connection_count_;
+    }
+}
+
+void SocketTransport::close_connection(Connection& connection) {
+    if (epoll_fd_ >= 0) {
+        epoll_ctl(epoll_fd_, EPOLL_CTL_DEL, connection.fd, nullptr);
+    }
+    ::close(connection.fd);
+    connection.fd = -1;
+    connection.begin = connection.end = 0;
+    connection.readable = false;
+    --connection_count_;
+}
+
+bool SocketTransport::service(Connection& connection, ReceiveHandler& handler) {
+    for (;;) {
+        if (connection.begin < connection.end) {
+            ReceiveResult result = handler.on_receive(connection.buffer.data() + connection.begin,
+                                                      connection.end - connection.begin, false, connection.peer);
+            connection.begin += result.consumed;
+            
+            if (result.drop) {
+                close_connection(connection);
+                return result.stop;
+            }
+            if (result.stop) {
+                return true;  // Rest stays buffered for the next poll
+            }
+        }
+        
+        if (!connection.readable) {
+            return false;
+        }
+        
+        // Only a partial message (< MAX_MESSAGE_SIZE) is ever left to move
+        if (connection.begin > 0) {
+            std::memmove(connection.buffer.data(), connection.buffer.data() + connection.begin,
+                         connection.end - connection.begin);
+            connection.end -= connection.begin;
+            connection.begin = 0;
+        }
+        
+        ssize_t n = ::recv(connection.fd, connection.buffer.data() + connection.end,
+                           connection.buffer.size() - connection.end, MSG_DONTWAIT);
+        if (n > 0) {
+            connection.end += static_cast<size_t>(n);
+            reads_.fetch_add(1, std::memory_order_relaxed);
+            continue;
+        }
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+            connection.readable = false;  // Wait for the next edge
+            return false;
+        }
+        
+        close_connection(connection);  // Orderly shutdown or socket error
+        return false;
+    }
+}
+
+void SocketTransport::poll_tcp(ReceiveHandler& handler) {
+    std::array<epoll_event, EPOLL_BATCH> events;
+    int ready = epoll_wait(epoll_fd_, events.data(), EPOLL_BATCH, 0);
+    for (int i = 0; i < ready; ++i) {
+        if (events[i].data.u64 == LISTEN_TAG) {
+            accept_clients();
+        } else {
+            connections_[events[i].data.u64].readable = true;  // Errors surface in recv()
+        }
+    }
+    
+    size_t slots = connections_.size();
+    for (size_t i = 0; i < slots; ++i) {
+        Connection& connection = connections_[(next_connection_ + i) % slots];
+        if (connection.fd >= 0 && (connection.readable || connection.begin < connection.end) &&
+            service(connection, handler)) {
+            break;
+        }
+    }
+    next_connection_ = slots ? (next_connection_ + 1) % slots : 0;
+}
+
+void SocketTransport::poll_udp(ReceiveHandler& handler) {
+    for (;;) {
+        if (datagram_next_ == datagram_count_) {
+            std::array<mmsghdr, MAX_DATAGRAM_BATCH> messages{};
+            std::array<iovec, MAX_DATAGRAM_BATCH> vectors;
+            std::array<sockaddr_in, MAX_DATAGRAM_BATCH> senders{};
+            for (size_t i = 0; i < config_.datagram_batch; ++i) {
+                vectors[i].iov_base = datagrams_[i].data();
+                vectors[i].iov_len = datagrams_[i].size();
+                messages[i].msg_hdr.msg_iov = &vectors[i];
+                messages[i].msg_hdr.msg_iovlen = 1;
+                messages[i].msg_hdr.msg_name = &senders[i];
+                messages[i].msg_hdr.msg_namelen = sizeof(senders[i]);
+            }
+            
+            int n = recvmmsg(listen_fd_, messages.data(), static_cast<unsigned>(config_.datagram_batch),
+                             MSG_DONTWAIT, nullptr);
+            if (n <= 0) {
+                return;
+            }
+            
+            reads_.fetch_add(1, std::memory_order_relaxed);
+            for (int i = 0; i < n; ++i) {
+                datagram_sizes_[i] = messages[i].msg_len;
+                datagram_peers_[i] = ntohl(senders[i].sin_addr.s_addr);
+            }
+            datagram_count_ = static_cast<size_t>(n);
+            datagram_next_ = 0;
+            datagram_offset_ = 0;
+        }
+        
+        size_t datagram_size = datagram_sizes_[datagram_next_];
+        ReceiveResult result = handler.on_receive(datagrams_[datagram_next_].data() + datagram_offset_,
+                                                  datagram_size - datagram_offset_, true,
+                                                  datagram_peers_[datagram_next_]);
+        datagram_offset_ += result.consumed;
+        if (result.stop && datagram_offset_ < datagram_size) {
+            return;  // Resume inside this datagram next poll
+        }
+        
+        ++datagram_next_;
+        datagram_offset_ = 0;
+        if (result.stop) {
+            return;
+        }
+    }
+}
+
+void SocketTransport::poll(ReceiveHandler& handler) {
+    if (config_.transport == GatewayConfig::Transport::Tcp) {
+        poll_tcp(handler);
+    } else {
+        poll_udp(handler);
+    }
+}
+
+#else
+
+int open_gateway_socket(const GatewayConfig&, uint16_t&) {
+    return -1;  // epoll and recvmmsg are Linux-only
+}
+
+void tune_gateway_connection(int, const GatewayConfig&) {}
+
+bool SocketTransport::open(const GatewayConfig&) {
+    return false;
+}
+
+void SocketTransport::close() {}
+
+void SocketTransport::accept_clients() {}
+
+void SocketTransport::close_connection(Connection&) {}
+
+bool SocketTransport::service(Connection&, ReceiveHandler&) {
+    return false;
+}
+
+void SocketTransport::poll_tcp(ReceiveHandler&) {}
+
+void SocketTransport::poll_udp(ReceiveHandler&) {}
+
+void SocketTransport::poll(ReceiveHandler&) {}
+
+#endif
+
+bool SocketTransport::is_open() const {
+    return listen_fd_ >= 0;
+}
+
+uint16_t SocketTransport::local_port() const {
+    return local_port_;
+}
+
+size_t SocketTransport::connection_count() const {
+    return connection_count_.load(std::memory_order_relaxed);
+}
+
+uint64_t SocketTransport::read_count() const {
+    return reads_.load(std::memory_order_relaxed);
+}
+
+} // namespace nanotrader
\ No newline at end of file
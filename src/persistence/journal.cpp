@@ -0,0 +1,606 @@
+#include "nanotrader/persistence/journal.hpp"
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <cstddef>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace nanotrader {
+
+// JournalRecord
+JournalRecord JournalRecord::from_request(const OrderRequest& request, uint64_t sequence) noexcept {
+    JournalRecord record{};
+    record.sequence = sequence;
+    record.order_id = request.order.id;
+    record.price = request.order.price.raw_value();
+    record.quantity = request.order.quantity;
+    record.new_quantity = request.new_quantity;
+    record.timestamp = request.order.timestamp;
+    record.symbol = request.order.symbol;
+    record.request_type = static_cast<uint8_t>(request.type);
+    record.side = static_cast<uint8_t>(request.order.side);
+    record.order_type = static_cast<uint8_t>(request.order.type);
+    record.account = request.account;
+    record.checksum = record.compute_checksum();
+    return record;
+}
+
+OrderRequest JournalRecord::to_request() const noexcept {
+    OrderRequest request(static_cast<OrderRequest::Type>(request_type), 
+                         Order(order_id, symbol, Price(price), quantity, 
+                               static_cast<Side>(side), static_cast<OrderType>(order_type), timestamp));
+    request.new_quantity = new_quantity;
+    request.account = account;
+    return request;
+}
+
+uint32_t JournalRecord::compute_checksum() const noexcept {
+    const unsigned char* bytes = reinterpret_cast<const unsigned char*>(this);
+    uint32_t hash = 2166136261u;
+    for (size_t i = 0; i < offsetof(JournalRecord, checksum); ++i) {
+        hash = (hash ^ bytes[i]) * 16777619u;
+    }
+    return hash;
+}
+
+// Result digests
+uint64_t result_digest(const MatchResult& result) noexcept {
+    uint64_t hash = 14695981039346656037ull;
+    auto mix = [&hash](uint64_t value) {
+        hash = (hash ^ value) * 1099511628211ull;
+    };
+    
+    mix(static_cast<uint64_t>(result.status));
+    mix(result.order_id);
+    mix(result.trades.size());
+    for (const Trade& trade : result.trades) {
+        mix(trade.maker_order_id);
+        mix(trade.taker_order_id);
+        mix(static_cast<uint64_t>(trade.price.raw_value()));
+        mix(trade.quantity);
+    }
+    return hash;
+}
+
+static bool valid_results_header(const ResultDigestHeader& header) {
+    return std::memcmp(header.magic, ResultDigestHeader::MAGIC, sizeof(header.magic)) == 0 &&
+           header.version == ResultDigestHeader::VERSION &&
+           header.record_size == sizeof(ResultDigest);
+}
+
+bool read_result_digests(const std::string& path, std::vector<ResultDigest>& digests) {
+    int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        return false;
+    }
+    
+    struct stat st;
+    ResultDigestHeader header;
+    bool ok = fstat(fd, &st) == 0 &&
+              pread(fd, &header, sizeof(header), 0) == static_cast<ssize_t>(sizeof(header)) &&
+              valid_results_header(header);
+    if (ok) {
+        size_t count = (static_cast<size_t>(st.st_size) - sizeof(header)) / sizeof(ResultDigest);
+        digests.resize(count);
+        size_t bytes = count * sizeof(ResultDigest);
+        size_t got = 0;
+        while (got < bytes) {
+            ssize_t n = pread(fd, reinterpret_cast<char*>(digests.data()) + got, bytes - got,
+                              static_cast<off_t>(sizeof(header) + got));
+            if (n < 0 && errno == EINTR) continue;
+            if (n <= 0) {
+                ok = false;
+                break;
+            }
+            got += static_cast<size_t>(n);
+        }
+    }
+    
+    ::close(fd);
+    return ok;
+}
+
+// Journal
+Journal::Journal(JournalConfig config) 
+    : config_(std::move(config))
+    , ring_(std::make_unique<SPSCRingBuffer<JournalRecord, RING_SIZE>>()) {
+    config_.write_batch_records = std::max<size_t>(config_.write_batch_records, 1);
+    if (!config_.results_path.empty()) {
+        results_ = std::make_unique<SPSCRingBuffer<ResultDigest, RING_SIZE>>();
+    }
+}
+
+Journal::~Journal() {
+    close();
+}
+
+bool Journal::recover_tail() {
+    struct stat st;
+    if (fstat(fd_, &st) != 0) {
+        return false;
+    }
+    
+    uint64_t last_sequence = 0;
+    if (st.st_size == 0) {
+        JournalHeader header{};
+        std::memcpy(header.magic, JournalHeader::MAGIC, sizeof(header.magic));
+        header.version = JournalHeader::VERSION;
+        header.record_size = sizeof(JournalRecord);
+        if (!write_all(fd_, &header, sizeof(header)) || fdatasync(fd_) != 0) {
+            return false;
+        }
+    } else {
+        JournalReader reader(config_.path);
+        if (!reader.is_open()) {
+            return false;  // Not a journal (or a different version): refuse to append
+        }
+        
+        JournalRecord record;
+        while (reader.next(record)) {
+            last_sequence = record.sequence;
+        }
+        
+        // Drop a torn final write so new records follow the last good one
+        off_t valid_end = static_cast<off_t>(reader.valid_bytes());
+        if (valid_end != st.st_size && ftruncate(fd_, valid_end) != 0) {
+            return false;
+        }
+        if (lseek(fd_, valid_end, SEEK_SET) != valid_end) {
+            return false;
+        }
+    }
+    
+    // A recovered snapshot may reflect records this file lost; never reuse their numbers
+    last_sequence = std::max(last_sequence, config_.resume_after);
+    next_sequence_ = last_sequence + 1;
+    next_result_sequence_ = next_sequence_;
+    appended_sequence_.store(last_sequence);
+    written_sequence_.store(last_sequence);
+    durable_sequence_.store(last_sequence);
+    return true;
+}
+
+bool Journal::open_results() {
+    results_fd_ = ::open(config_.results_path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+    if (results_fd_ < 0) {
+        return false;
+    }
+    
+    struct stat st;
+    if (fstat(results_fd_, &st) != 0) {
+        return false;
+    }
+    
+    if (st.st_size == 0) {
+        ResultDigestHeader header{};
+        std::memcpy(header.magic, ResultDigestHeader::MAGIC, sizeof(header.magic));
+        header.version = ResultDigestHeader::VERSION;
+        header.record_size = sizeof(ResultDigest);
+        return write_all(results_fd_, &header, sizeof(header)) && fdatasync(results_fd_) == 0;
+    }
+    
+    ResultDigestHeader header;
+    if (pread(results_fd_, &header, sizeof(header), 0) != static_cast<ssize_t>(sizeof(header)) ||
+        !valid_results_header(header)) {
+        return false;  // Not a results sidecar: refuse to append
+    }
+    
+    // Keep whole entries for records the journal still has; the two files are
+    // synced together but a crash can persist either one further
+    size_t count = (static_cast<size_t>(st.st_size) - sizeof(header)) / sizeof(ResultDigest);
+    while (count > 0) {
+        ResultDigest last;
+        off_t offset = static_cast<off_t>(sizeof(header) + (count - 1) * sizeof(ResultDigest));
+        if (pread(results_fd_, &last, sizeof(last), offset) != static_cast<ssize_t>(sizeof(last))) {
+            return false;
+        }
+        if (last.sequence < next_sequence_) {
+            break;
+        }
+        --count;
+    }
+    
+    off_t valid_end = static_cast<off_t>(sizeof(header) + count * sizeof(ResultDigest));
+    if (valid_end != st.st_size && ftruncate(results_fd_, valid_end) != 0) {
+        return false;
+    }
+    return lseek(results_fd_, valid_end, SEEK_SET) == valid_end;
+}
+
+bool Journal::open() {
+    if (is_open()) {
+        return true;
+    }
+    
+    fd_ = ::open(config_.path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+    if (fd_ < 0) {
+        return false;
+    }
+    
+    if (!recover_tail() || (results_ && !open_results())) {
+        if (results_fd_ >= 0) {
+            ::close(results_fd_);
+            results_fd_ = -1;
+        }
+        ::close(fd_);
+        fd_ = -1;
+        return false;
+    }
+    
+    failed_.store(false);
+    running_.store(true);
+    io_thread_ = std::thread(&Journal::run_io, this);
+    return true;
+}
+
+void Journal::close() {
+    if (!is_open()) {
+        return;
+    }
+    
+    running_.store(false);
+    if (io_thread_.joinable()) {
+        io_thread_.join();
+    }
+    
+    if (results_fd_ >= 0) {
+        ::close(results_fd_);
+        results_fd_ = -1;
+    }
+    ::close(fd_);
+    fd_ = -1;
+}
+
+bool Journal::is_open() const {
+    return fd_ >= 0;
+}
+
+bool Journal::healthy() const {
+    return !failed_.load(std::memory_order_relaxed);
+}
+
+bool Journal::write_all(int fd, const void* data, size_t size) {
+    const char* ptr = static_cast<const char*>(data);
+    while (size > 0) {
+        ssize_t written = ::write(fd, ptr, size);
+        if (written < 0) {
+            if (errno == EINTR) continue;
+            return false;
+        }
+        ptr += written;
+        size -= static_cast<size_t>(written);
+    }
+    return true;
+}
+
+bool Journal::sync() {
+    syncs_.fetch_add(1, std::memory_order_relaxed);
+    bool ok = fdatasync(fd_) == 0;
+    if (results_fd_ >= 0 && fdatasync(results_fd_) != 0) {
+        ok = false;
+    }
+    return ok;
+}
+
+void Journal::run_io() {
+    using Clock = std::chrono::steady_clock;
+    
+    std::vector<JournalRecord> batch(config_.write_batch_records);
+    std::vector<ResultDigest> digests(results_ ? config_.write_batch_records : 0);
+    size_t unsynced_bytes = 0;
+    auto last_sync = Clock::now();
+    
+    auto commit = [&]() {
+        if (!sync()) {
+            failed_.store(true, std::memory_order_relaxed);
+        }
+        durable_sequence_.store(written_sequence_.load(std::memory_order_relaxed), 
+                                std::memory_order_release);
+        unsynced_bytes = 0;
+        last_sync = Clock::now();
+    };
+    
+    for (;;) {
+        // Read the flag first: anything pushed before close() is drained below
+        bool running = running_.load(std::memory_order_acquire);
+        
+        // Results ride along with the records and are synced by the same commits
+        size_t results = 0;
+        if (results_) {
+            results_->try_pop_batch([&digests, &results](ResultDigest&& digest) {
+                digests[results++] = digest;
+            }, digests.size());
+            if (results > 0) {
+                if (!write_all(results_fd_, digests.data(), results * sizeof(ResultDigest))) {
+                    failed_.store(true, std::memory_order_relaxed);
+                }
+                unsynced_bytes += results * sizeof(ResultDigest);
+            }
+        }
+        
+        size_t count = 0;
+        ring_->try_pop_batch([&batch, &count](JournalRecord&& record) {
+            batch[count++] = record;
+        }, batch.size());
+        
+        if (count > 0) {
+            size_t bytes = count * sizeof(JournalRecord);
+            if (!write_all(fd_, batch.data(), bytes)) {
+                failed_.store(true, std::memory_order_relaxed);
+            }
+            written_sequence_.store(batch[count - 1].sequence, std::memory_order_release);
+            unsynced_bytes += bytes;
+            
+            switch (config_.durability) {
+                case JournalConfig::Durability::Buffered:
+                    durable_sequence_.store(batch[count - 1].sequence, std::memory_order_release);
+                    break;
+                case JournalConfig::Durability::EveryBatch:
+                    commit();
+                    break;
+                case JournalConfig::Durability::GroupCommit:
+                    if (unsynced_bytes >= config_.group_commit_bytes ||
+                        Clock::now() - last_sync >= config_.group_commit_interval) {
+                        commit();
+                    }
+                    break;
+            }
+            continue;
+        }
+        if (results > 0) {
+            continue;  // Keep draining; close() must not strand results
+        }
+        
+        if (unsynced_bytes > 0 && config_.durability == JournalConfig::Durability::GroupCommit &&
+            (!running || Clock::now() - last_sync >= config_.group_commit_interval)) {
+            commit();
+        }
+        
+        if (!running) {
+            break;
+        }
+        
+        std::this_thread::sleep_for(config_.idle_sleep);
+    }
+    
+    // Buffered mode still leaves a clean, synced file on orderly shutdown
+    if (unsynced_bytes > 0) {
+        commit();
+    }
+}
+
+uint64_t Journal::append(const OrderRequest& request) noexcept {
+    uint64_t sequence = next_sequence_++;
+    JournalRecord record = JournalRecord::from_request(request, sequence);
+    
+    if (!ring_->try_push(record)) {
+        stalls_.fetch_add(1, std::memory_order_relaxed);
+        while (!ring_->try_push(record)) {
+            std::this_thread::yield();
+        }
+    }
+    
+    appended_sequence_.store(sequence, std::memory_order_release);
+    return sequence;
+}
+
+void Journal::append_batch(const OrderRequest* requests, size_t count) noexcept {
+    std::array<JournalRecord, PUSH_CHUNK> chunk;
+    
+    while (count > 0) {
+        size_t n = std::min(count, PUSH_CHUNK);
+        for (size_t i = 0; i < n; ++i) {
+            chunk[i] = JournalRecord::from_request(requests[i], next_sequence_++);
+        }
+        
+        // One tail store per chunk; only loop when the I/O thread has fallen behind
+        size_t pushed = ring_->try_push_batch(chunk.begin(), n);
+        if (pushed < n) {
+            stalls_.fetch_add(1, std::memory_order_relaxed);
+            while (pushed < n) {
+                std::this_thread::yield();
+                pushed += ring_->try_push_batch(chunk.begin() + pushed, n - pushed);
+            }
+        }
+        
+        requests += n;
+        count -= n;
+    }
+    
+    appended_sequence_.store(next_sequence_ - 1, std::memory_order_release);
+}
+
+void Journal::append_result(const MatchResult& result) noexcept {
+    if (!results_) {
+        return;
+    }
+    
+    ResultDigest digest{next_result_sequence_++, result_digest(result)};
+    if (!results_->try_push(digest)) {
+        stalls_.fetch_add(1, std::memory_order_relaxed);
+        while (!results_->try_push(digest)) {
+            std::this_thread::yield();
+        }
+    }
+}
+
+void Journal::flush() {
+    uint64_t target = appended_sequence_.load(std::memory_order_acquire);
+    while (is_open() && durable_sequence_.load(std::memory_order_acquire) < target) {
+        std::this_thread::sleep_for(config_.idle_sleep);
+    }
+}
+
+bool Journal::wait_durable(uint64_t sequence) {
+    while (durable_sequence_.load(std::memory_order_acquire) < sequence && is_open() && healthy()) {
+        std::this_thread::sleep_for(config_.idle_sleep);
+    }
+    return durable_sequence_.load(std::memory_order_acquire) >= sequence && healthy();
+}
+
+uint64_t Journal::appended_sequence() const {
+    return appended_sequence_.load(std::memory_order_acquire);
+}
+
+uint64_t Journal::written_sequence() const {
+    return written_sequence_.load(std::memory_order_acquire);
+}
+
+uint64_t Journal::durable_sequence() const {
+    return durable_sequence_.load(std::memory_order_acquire);
+}
+
+uint64_t Journal::stall_count() const {
+    return stalls_.load(std::memory_order_relaxed);
+}
+
+uint64_t Journal::sync_count() const {
+    return syncs_.load(std::memory_order_relaxed);
+}
+
+const JournalConfig& Journal::get_config() const {
+    return config_;
+}
+
+// JournalReader
+JournalReader::JournalReader(const std::string& path) 
+    : buffer_(READ_BATCH_RECORDS) {
+    fd_ = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd_ < 0) {
+        return;
+    }
+    
+    JournalHeader header;
+    if (::read(fd_, &header, sizeof(header)) == static_cast<ssize_t>(sizeof(header)) &&
+        std::memcmp(header.magic, JournalHeader::MAGIC, sizeof(header.magic)) == 0 &&
+        header.version == JournalHeader::VERSION && 
+        header.record_size == sizeof(JournalRecord)) {
+        header_ok_ = true;
+        valid_bytes_ = sizeof(header);
+    }
+}
+
+JournalReader::~JournalReader() {
+    if (fd_ >= 0) {
+        ::close(fd_);
+    }
+}
+
+bool JournalReader::fill() {
+    char* dest = reinterpret_cast<char*>(buffer_.data());
+    size_t capacity = buffer_.size() * sizeof(JournalRecord);
+    size_t got = 0;
+    
+    while (got < capacity) {
+        ssize_t n = ::read(fd_, dest + got, capacity - got);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            break;
+        }
+        if (n == 0) break;
+        got += static_cast<size_t>(n);
+    }
+    
+    buffered_ = got / sizeof(JournalRecord);
+    position_ = 0;
+    if (got % sizeof(JournalRecord) != 0) {
+        corrupt_ = true;  // Partial record at the tail; the complete ones are still used
+    }
+    return buffered_ > 0;
+}
+
+bool JournalReader::next(JournalRecord& record) {
+    if (!header_ok_ || fd_ < 0) {
+        return false;
+    }
+    
+    if (position_ == buffered_) {
+        if (corrupt_ || !fill()) {
+            return false;
+        }
+    }
+    
+    const JournalRecord& candidate = buffer_[position_];
+    if (!candidate.valid() || candidate.sequence <= last_sequence_) {
+        corrupt_ = true;
+        buffered_ = position_;
+        return false;
+    }
+    
+    record = candidate;
+    last_sequence_ = candidate.sequence;
+    ++position_;
+    ++records_read_;
+    valid_bytes_ += sizeof(JournalRecord);
+    return true;
+}
+
+bool JournalReader::seek_after(uint64_t sequence) {
+    if (!header_ok_) {
+        return false;
+    }
+    
+    struct stat st;
+    if (fstat(fd_, &st) != 0) {
+        return false;
+    }
+    
+    // First record index whose sequence exceeds the target; a bad record ends the range
+    size_t lo = 0;
+    size_t hi = (static_cast<size_t>(st.st_size) - sizeof(JournalHeader)) / sizeof(JournalRecord);
+    while (lo < hi) {
+        size_t mid = lo + (hi - lo) / 2;
+        JournalRecord record;
+        off_t offset = static_cast<off_t>(sizeof(JournalHeader) + mid * sizeof(JournalRecord));
+        if (pread(fd_, &record, sizeof(record), offset) != static_cast<ssize_t>(sizeof(record)) ||
+            !record.valid() || record.sequence > sequence) {
+            hi = mid;
+        } else {
+            lo = mid + 1;
+        }
+    }
+    
+    off_t offset = static_cast<off_t>(sizeof(JournalHeader) + lo * sizeof(JournalRecord));
+    if (lseek(fd_, offset, SEEK_SET) != offset) {
+        return false;
+    }
+    
+    JournalRecord before{};
+    if (lo > 0 && pread(fd_, &before, sizeof(before), offset - static_cast<off_t>(sizeof(before))) !=
+                      static_cast<ssize_t>(sizeof(before))) {
+        return false;
+    }
+    
+    buffered_ = 0;
+    position_ = 0;
+    corrupt_ = false;
+    records_read_ = lo;
+    last_sequence_ = lo > 0 ? before.sequence : 0;
+    valid_bytes_ = static_cast<uint64_t>(offset);
+    return true;
+}
+
+bool JournalReader::is_open() const {
+    return header_ok_;
+}
+
+uint64_t JournalReader::records_read() const {
+    return records_read_;
+}
+
+uint64_t JournalReader::last_sequence() const {
+    return last_sequence_;
+}
+
+uint64_t JournalReader::valid_bytes() const {
+    return valid_bytes_;
+}
+
+bool JournalReader::corrupt() const {
+    return corrupt_;
+}
+
+} // namespace nanotrader
\ No newline at end of file
@@ -0,0 +1,281 @@
+#include "nanotrader/persistence/snapshot.hpp"
+#include "nanotrader/persistence/journal.hpp"
+#include "nanotrader/risk/risk_stage.hpp"
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace nanotrader {
+
+uint64_t snapshot_checksum(const char* data, size_t size) noexcept {
+    // FNV-1a over 8-byte words (then the tail bytes): cheap enough for GB-sized files
+    uint64_t hash = 14695981039346656037ull;
+    size_t i = 0;
+    for (; i + sizeof(uint64_t) <= size; i += sizeof(uint64_t)) {
+        uint64_t word;
+        std::memcpy(&word, data + i, sizeof(word));
+        hash = (hash ^ word) * 1099511628211ull;
+    }
+    for (; i < size; ++i) {
+        hash = (hash ^ static_cast<unsigned char>(data[i])) * 1099511628211ull;
+    }
+    return hash;
+}
+
+// SnapshotWriter
+void SnapshotWriter::capture(const MatchingEngine& engine) {
+    Journal* journal = engine.get_journal();
+    capture(engine, journal ? journal->appended_sequence() : 0);
+    journal_ = journal;
+}
+
+void SnapshotWriter::capture(const MatchingEngine& engine, uint64_t journal_sequence) {
+    const SymbolTable& symbols = engine.get_symbol_table();
+    
+    journal_ = nullptr;
+    buffer_.clear();
+    buffer_.reserve(sizeof(SnapshotHeader) + symbols.size() * sizeof(SnapshotBook) + 
+                    engine.get_total_orders() * sizeof(SnapshotOrder));
+    buffer_.resize(sizeof(SnapshotHeader));
+    
+    uint64_t order_count = 0;
+    symbols.for_each([this, &order_count](const OrderBook& book) {
+        const BookConfig& config = book.get_config();
+        
+        SnapshotBook entry{};
+        entry.symbol = book.get_symbol();
+        entry.backend = static_cast<uint8_t>(config.backend);
+        entry.tick_size = config.tick_size;
+        entry.ladder_width = config.ladder_width;
+        entry.max_ladder_width = config.max_ladder_width;
+        entry.bitmap_width = config.bitmap_width;
+        entry.level_reserve = config.level_reserve;
+        entry.order_reserve = config.order_reserve;
+        entry.order_count = book.get_order_count();
+        put(entry);
+        
+        for (Side side : {Side::Buy, Side::Sell}) {
+            book.for_each_level(side, [this, &book](const PriceLevel& level) {
+                book.for_each_order(level, [this](const Order& order) {
+                    SnapshotOrder saved{};
+                    saved.id = order.id;
+                    saved.price = order.price.raw_value();
+                    saved.quantity = order.quantity;
+                    saved.remaining_quantity = order.remaining_quantity;
+                    saved.timestamp = order.timestamp;
+                    saved.side = static_cast<uint8_t>(order.side);
+                    saved.type = static_cast<uint8_t>(order.type);
+                    put(saved);
+                });
+            });
+        }
+        order_count += entry.order_count;
+    });
+    
+    size_t books_end = buffer_.size();
+    if (const RiskStage* risk = engine.get_risk()) {
+        risk->save_state(buffer_);
+    }
+    
+    SnapshotHeader header{};
+    std::memcpy(header.magic, SnapshotHeader::MAGIC, sizeof(header.magic));
+    header.version = SnapshotHeader::VERSION;
+    header.book_count = static_cast<uint32_t>(symbols.size());
+    header.order_count = order_count;
+    header.journal_sequence = journal_sequence;
+    header.payload_bytes = buffer_.size() - sizeof(SnapshotHeader);
+    header.risk_bytes = buffer_.size() - books_end;
+    header.checksum = snapshot_checksum(buffer_.data() + sizeof(SnapshotHeader), header.payload_bytes);
+    std::memcpy(buffer_.data(), &header, sizeof(header));
+}
+
+bool SnapshotWriter::write(const std::string& path) const {
+    if (buffer_.size() < sizeof(SnapshotHeader)) {
+        return false;  // Nothing captured
+    }
+    if (journal_ && !journal_->wait_durable(header().journal_sequence)) {
+        return false;
+    }
+    
+    std::string tmp_path = path + ".tmp";
+    int fd = ::open(tmp_path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (fd < 0) {
+        return false;
+    }
+    
+    const char* ptr = buffer_.data();
+    size_t remaining = buffer_.size();
+    while (remaining > 0) {
+        ssize_t written = ::write(fd, ptr, remaining);
+        if (written < 0) {
+            if (errno == EINTR) continue;
+            ::close(fd);
+            ::unlink(tmp_path.c_str());
+            return false;
+        }
+        ptr += written;
+        remaining -= static_cast<size_t>(written);
+    }
+    
+    // A crash leaves either the old snapshot or the complete new one
+    bool ok = fsync(fd) == 0;
+    ok = ::close(fd) == 0 && ok;
+    if (!ok || std::rename(tmp_path.c_str(), path.c_str()) != 0) {
+        ::unlink(tmp_path.c_str());
+        return false;
+    }
+    return true;
+}
+
+const SnapshotHeader& SnapshotWriter::header() const {
+    return *reinterpret_cast<const SnapshotHeader*>(buffer_.data());
+}
+
+size_t SnapshotWriter::size_bytes() const {
+    return buffer_.size();
+}
+
+// SnapshotReader
+SnapshotReader::SnapshotReader(const std::string& path) {
+    int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        return;
+    }
+    
+    struct stat st;
+    if (fstat(fd, &st) != 0 || static_cast<size_t>(st.st_size) < sizeof(SnapshotHeader)) {
+        ::close(fd);
+        return;
+    }
+    
+    size_ = static_cast<size_t>(st.st_size);
+    void* mapping = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (mapping == MAP_FAILED) {
+        size_ = 0;
+        return;
+    }
+    mapping_ = mapping;
+
+#ifdef MADV_SEQUENTIAL
+    madvise(mapping_, size_, MADV_SEQUENTIAL);  // Restore reads it front to back once
+#endif
+    
+    const SnapshotHeader& hdr = header();
+    const char* payload = static_cast<const char*>(mapping_) + sizeof(SnapshotHeader);
+    valid_ = std::memcmp(hdr.magic, SnapshotHeader::MAGIC, sizeof(hdr.magic)) == 0 &&
+             hdr.version == SnapshotHeader::VERSION &&
+             hdr.payload_bytes == size_ - sizeof(SnapshotHeader) &&
+             hdr.risk_bytes <= hdr.payload_bytes &&
+             hdr.checksum == snapshot_checksum(payload, hdr.payload_bytes);
+}
+
+SnapshotReader::~SnapshotReader() {
+    if (mapping_) {
+        munmap(mapping_, size_);
+    }
+}
+
+bool SnapshotReader::is_open() const {
+    return valid_;
+}
+
+const SnapshotHeader& SnapshotReader::header() const {
+    return *static_cast<const SnapshotHeader*>(mapping_);
+}
+
+bool SnapshotReader::restore(MatchingEngine& engine) const {
+    if (!valid_) {
+        return false;
+    }
+    
+    const char* ptr = static_cast<const char*>(mapping_) + sizeof(SnapshotHeader);
+    const char* end = static_cast<const char*>(mapping_) + size_ - header().risk_bytes;
+    
+    for (uint32_t b = 0; b < header().book_count; ++b) {
+        if (static_cast<size_t>(end - ptr) < sizeof(SnapshotBook)) {
+            return false;
+        }
+        SnapshotBook entry;
+        std::memcpy(&entry, ptr, sizeof(entry));
+        ptr += sizeof(entry);
+        
+        BookConfig config;
+        config.backend = static_cast<BookConfig::Backend>(entry.backend);
+        config.tick_size = entry.tick_size;
+        config.ladder_width = entry.ladder_width;
+        config.max_ladder_width = entry.max_ladder_width;
+        config.bitmap_width = entry.bitmap_width;
+        config.level_reserve = entry.level_reserve;
+        config.order_reserve = entry.order_reserve;
+        if (!engine.register_symbol(entry.symbol, config)) {
+            return false;
+        }
+        
+        if (static_cast<size_t>(end - ptr) / sizeof(SnapshotOrder) < entry.order_count) {
+            return false;
+        }
+        
+        for (uint64_t i = 0; i < entry.order_count; ++i) {
+            SnapshotOrder saved;
+            std::memcpy(&saved, ptr, sizeof(saved));
+            ptr += sizeof(saved);
+            
+            Order order(saved.id, entry.symbol, Price(saved.price), saved.quantity, 
+                        static_cast<Side>(saved.side), static_cast<OrderType>(saved.type), saved.timestamp);
+            order.remaining_quantity = saved.remaining_quantity;
+            if (!engine.restore_order(order)) {
+                return false;
+            }
+        }
+    }
+    
+    if (ptr != end) {
+        return false;
+    }
+    
+    // A stage that wasn't attached when the snapshot was taken starts empty
+    RiskStage* risk = engine.get_risk();
+    return !risk || header().risk_bytes == 0 || risk->load_state(end, header().risk_bytes);
+}
+
+RecoveryResult recover(MatchingEngine& engine, const std::string& snapshot_path, 
+                       const std::string& journal_path) {
+    RecoveryResult result;
+    
+    if (!snapshot_path.empty()) {
+        SnapshotReader snapshot(snapshot_path);
+        if (snapshot.is_open()) {
+            if (!snapshot.restore(engine)) {
+                return result;  // Partially restored books are unusable
+            }
+            result.from_snapshot = true;
+            result.snapshot_sequence = snapshot.header().journal_sequence;
+            result.last_sequence = result.snapshot_sequence;
+        }
+    }
+    
+    JournalReader journal(journal_path);
+    if (journal.is_open() && journal.seek_after(result.snapshot_sequence)) {
+        JournalRecord record;
+        while (journal.next(record)) {
+            engine.replay(record.to_request());
+            result.last_sequence = record.sequence;
+            ++result.replayed;
+        }
+    }
+    
+    // Records the snapshot reflects but the journal lost would be numbered again
+    if (journal.last_sequence() < result.snapshot_sequence) {
+        return result;
+    }
+    
+    result.ok = true;
+    return result;
+}
+
+} // namespace nanotrader
\ No newline at end of file
@@ -0,0 +1,201 @@
+#include "nanotrader/risk/risk_accounts.hpp"
+#include "nanotrader/risk/risk_stage.hpp"
+#include <bit>
+
+namespace nanotrader {
+
+namespace {
+
+// Max load factor 3/4, as in OrderIndex
+size_t capacity_for(size_t max_size) {
+    size_t needed = max_size + max_size / 3 + 1;
+    size_t capacity = 16;
+    while (capacity < needed) {
+        capacity <<= 1;
+    }
+    return capacity;
+}
+
+void add_signed(int64_t& position, Side side, Quantity quantity) noexcept {
+    position += side == Side::Buy ? static_cast<int64_t>(quantity) : -static_cast<int64_t>(quantity);
+}
+
+Quantity& open_quantity(AccountState& state, Side side) noexcept {
+    return side == Side::Buy ? state.open_buy : state.open_sell;
+}
+
+} // namespace
+
+RiskAccounts::RiskAccounts(size_t max_accounts, size_t max_open_orders)
+    : accounts_(max_accounts)
+    , orders_(capacity_for(max_open_orders), OpenOrder{0, 0, 0, Side::Buy})
+    , mask_(orders_.size() - 1)
+    , shift_(64 - static_cast<unsigned>(std::countr_zero(orders_.size())))
+    , max_size_(max_open_orders) {
+}
+
+bool RiskAccounts::set_limits(AccountId account, const AccountLimits& limits) noexcept {
+    AccountState* state = find(account);
+    if (!state) {
+        return false;
+    }
+    state->limits = limits;
+    return true;
+}
+
+void RiskAccounts::set_default_limits(const AccountLimits& limits) noexcept {
+    for (AccountState& state : accounts_) {
+        state.limits = limits;
+    }
+}
+
+bool RiskAccounts::open(OrderId id, AccountId account, Side side, Quantity remaining) noexcept {
+    AccountState* state = find(account);
+    if (!state || remaining == 0 || full()) {
+        return false;
+    }
+    
+    size_t i = home(id);
+    while (orders_[i].remaining != 0) {
+        if (orders_[i].id == id) {
+            return false;
+        }
+        i = (i + 1) & mask_;
+    }
+    
+    orders_[i] = OpenOrder{id, remaining, account, side};
+    ++size_;
+    open_quantity(*state, side) += remaining;
+    ++state->open_orders;
+    return true;
+}
+
+void RiskAccounts::fill_resting(OrderId id, Quantity quantity) noexcept {
+    OpenOrder* order = find_order(id);
+    if (!order) {
+        return;
+    }
+    
+    AccountState& state = accounts_[order->account];
+    add_signed(state.position, order->side, quantity);
+    open_quantity(state, order->side) -= quantity;
+    order->remaining -= quantity;
+    if (order->remaining == 0) {
+        --state.open_orders;
+        erase_order(*order);
+    }
+}
+
+void RiskAccounts::fill_incoming(AccountId account, Side side, Quantity quantity) noexcept {
+    AccountState* state = find(account);
+    if (state) {
+        add_signed(state->position, side, quantity);
+    }
+}
+
+void RiskAccounts::resize(OrderId id, Quantity remaining) noexcept {
+    OpenOrder* order = find_order(id);
+    if (!order) {
+        return;
+    }
+    if (remaining == 0) {
+        close(id);
+        return;
+    }
+    
+    Quantity& open = open_quantity(accounts_[order->account], order->side);
+    open = open - order->remaining + remaining;
+    order->remaining = remaining;
+}
+
+void RiskAccounts::close(OrderId id) noexcept {
+    OpenOrder* order = find_order(id);
+    if (!order) {
+        return;
+    }
+    
+    AccountState& state = accounts_[order->account];
+    open_quantity(state, order->side) -= order->remaining;
+    --state.open_orders;
+    erase_order(*order);
+}
+
+void RiskAccounts::erase_order(OpenOrder& order) noexcept {
+    // Backward-shift: pull later members of the probe run into the hole
+    size_t hole = static_cast<size_t>(&order - orders_.data());
+    for (size_t i = (hole + 1) & mask_; orders_[i].remaining != 0; i = (i + 1) & mask_) {
+        size_t ideal = home(orders_[i].id);
+        if (((i - ideal) & mask_) >= ((i - hole) & mask_)) {
+            orders_[hole] = orders_[i];
+            hole = i;
+        }
+    }
+    
+    orders_[hole].remaining = 0;
+    --size_;
+}
+
+void RiskAccounts::clear_open_orders() noexcept {
+    for (OpenOrder& order : orders_) {
+        order.remaining = 0;
+    }
+    for (AccountState& state : accounts_) {
+        state.open_buy = 0;
+        state.open_sell = 0;
+        state.open_orders = 0;
+    }
+    size_ = 0;
+}
+
+void RiskAccounts::save(std::vector<char>& out) const {
+    put_state(out, static_cast<uint64_t>(accounts_.size()));
+    for (const AccountState& state : accounts_) {
+        put_state(out, state.position);
+    }
+    put_state(out, static_cast<uint64_t>(size_));
+    for (const OpenOrder& order : orders_) {
+        if (order.remaining != 0) {
+            put_state(out, order.id);
+            put_state(out, order.remaining);
+            put_state(out, order.account);
+            put_state(out, static_cast<uint8_t>(order.side));
+        }
+    }
+}
+
+bool RiskAccounts::load(const char*& data, const char* end) noexcept {
+    uint64_t account_count = 0;
+    if (!take_state(data, end, account_count) || account_count > accounts_.size()) {
+        return false;
+    }
+    
+    // Open quantities and counts are rebuilt from the orders as they are reopened
+    clear_open_orders();
+    for (AccountState& state : accounts_) {
+        state.position = 0;
+    }
+    for (uint64_t i = 0; i < account_count; ++i) {
+        if (!take_state(data, end, accounts_[i].position)) {
+            return false;
+        }
+    }
+    
+    uint64_t order_count = 0;
+    if (!take_state(data, end, order_count) || order_count > max_size_) {
+        return false;
+    }
+    for (uint64_t i = 0; i < order_count; ++i) {
+        OrderId id = 0;
+        Quantity remaining = 0;
+        AccountId account = 0;
+        uint8_t side = 0;
+        if (!take_state(data, end, id) || !take_state(data, end, remaining) ||
+            !take_state(data, end, account) || !take_state(data, end, side) ||
+            side > static_cast<uint8_t>(Side::Sell) || !open(id, account, static_cast<Side>(side), remaining)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace nanotrader
\ No newline at end of file
@@ -0,0 +1,59 @@
+#include "nanotrader/telemetry/latency_histogram.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace nanotrader {
+namespace telemetry {
+
+void HistogramSnapshot::merge(const HistogramSnapshot& other) noexcept {
+    for (size_t i = 0; i < counts_.size(); ++i) {
+        counts_[i] += other.counts_[i];
+    }
+    count_ += other.count_;
+    sum_ += other.sum_;
+    max_ = std::max(max_, other.max_);
+}
+
+uint64_t HistogramSnapshot::value_at_quantile(double q) const noexcept {
+    // Buckets are the source of truth; count_ may trail them by a sample
+    uint64_t total = 0;
+    for (uint64_t count : counts_) {
+        total += count;
+    }
+    if (total == 0) {
+        return 0;
+    }
+    
+    uint64_t rank = static_cast<uint64_t>(std::ceil(std::clamp(q, 0.0, 1.0) * static_cast<double>(total)));
+    rank = std::max<uint64_t>(rank, 1);
+    uint64_t seen = 0;
+    for (size_t i = 0; i < counts_.size(); ++i) {
+        seen += counts_[i];
+        if (seen >= rank) {
+            uint64_t bound = HistogramLayout::upper_bound(i);
+            return max_ != 0 && max_ < bound ? max_ : bound;  // The top bucket reports the exact max
+        }
+    }
+    return max_;
+}
+
+void LatencyHistogram::snapshot(HistogramSnapshot& out) const noexcept {
+    for (size_t i = 0; i < counts_.size(); ++i) {
+        out.counts_[i] = counts_[i].load(std::memory_order_relaxed);
+    }
+    out.count_ = count_.load(std::memory_order_relaxed);
+    out.sum_ = sum_.load(std::memory_order_relaxed);
+    out.max_ = max_.load(std::memory_order_relaxed);
+}
+
+void LatencyHistogram::reset() noexcept {
+    for (auto& count : counts_) {
+        count.store(0, std::memory_order_relaxed);
+    }
+    count_.store(0, std::memory_order_relaxed);
+    sum_.store(0, std::memory_order_relaxed);
+    max_.store(0, std::memory_order_relaxed);
+}
+
+} // namespace telemetry
+} // namespace nanotrader
\ No newline at end of file
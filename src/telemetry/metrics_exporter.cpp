@@ -0,0 +1,169 @@
+#include "nanotrader/telemetry/metrics_exporter.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <cstdarg>
+#include <cstdio>
+#include <fcntl.h>
+#include <memory>
+#include <unistd.h>
+#include <utility>
+
+namespace nanotrader {
+namespace telemetry {
+
+namespace {
+
+constexpr double QUANTILES[] = {0.5, 0.9, 0.99, 0.999};
+
+void append_line(std::string& out, const char* format, ...) __attribute__((format(printf, 2, 3)));
+
+void append_line(std::string& out, const char* format, ...) {
+    char line[256];
+    va_list args;
+    va_start(args, format);
+    int length = std::vsnprintf(line, sizeof(line), format, args);
+    va_end(args);
+    if (length > 0) {
+        out.append(line, std::min<size_t>(static_cast<size_t>(length), sizeof(line) - 1));
+    }
+}
+
+void render_summary(std::string& out, const std::string& prefix, const char* name, const char* help,
+                    const LatencyHistogram& histogram, const TscClock& clock) {
+    auto snapshot = std::make_unique<HistogramSnapshot>();  // ~15 KiB, keep it off the stack
+    histogram.snapshot(*snapshot);
+    
+    const char* p = prefix.c_str();
+    append_line(out, "# HELP %s_%s_ns %s\n", p, name, help);
+    append_line(out, "# TYPE %s_%s_ns summary\n", p, name);
+    for (double q : QUANTILES) {
+        append_line(out, "%s_%s_ns{quantile=\"%g\"} %llu\n", p, name, q,
+                    static_cast<unsigned long long>(clock.cycles_to_ns(snapshot->value_at_quantile(q))));
+    }
+    append_line(out, "%s_%s_ns_sum %llu\n", p, name,
+                static_cast<unsigned long long>(clock.cycles_to_ns(snapshot->sum())));
+    append_line(out, "%s_%s_ns_count %llu\n", p, name, static_cast<unsigned long long>(snapshot->count()));
+    append_line(out, "# TYPE %s_%s_max_ns gauge\n", p, name);
+    append_line(out, "%s_%s_max_ns %llu\n", p, name,
+                static_cast<unsigned long long>(clock.cycles_to_ns(snapshot->max())));
+}
+
+void render_value(std::string& out, const std::string& prefix, const char* name, const char* type,
+                  const Counter& counter) {
+    append_line(out, "# TYPE %s_%s %s\n", prefix.c_str(), name, type);
+    append_line(out, "%s_%s %llu\n", prefix.c_str(), name, static_cast<unsigned long long>(counter.get()));
+}
+
+bool write_file(const std::string& path, const std::string& contents) {
+    int fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (fd < 0) {
+        return false;
+    }
+    
+    const char* data = contents.data();
+    size_t size = contents.size();
+    while (size > 0) {
+        ssize_t written = ::write(fd, data, size);
+        if (written < 0) {
+            if (errno == EINTR) continue;
+            ::close(fd);
+            return false;
+        }
+        data += written;
+        size -= static_cast<size_t>(written);
+    }
+    return ::close(fd) == 0;
+}
+
+} // namespace
+
+MetricsExporter::MetricsExporter(const EngineMetrics& metrics, const TscClock& clock, ExporterConfig config)
+    : metrics_(metrics)
+    , clock_(clock)
+    , config_(std::move(config)) {
+}
+
+MetricsExporter::~MetricsExporter() {
+    stop();
+}
+
+bool MetricsExporter::start() {
+    if (is_running() || config_.path.empty()) {
+        return false;
+    }
+    
+    stopping_ = false;
+    running_.store(true);
+    thread_ = std::thread(&MetricsExporter::run, this);
+    return true;
+}
+
+void MetricsExporter::stop() {
+    if (!thread_.joinable()) {
+        return;
+    }
+    
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    wake_.notify_one();
+    thread_.join();
+    running_.store(false);
+}
+
+bool MetricsExporter::is_running() const {
+    return running_.load();
+}
+
+void MetricsExporter::run() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (!stopping_) {
+        wake_.wait_for(lock, config_.interval, [this] { return stopping_; });
+        lock.unlock();
+        export_now();
+        lock.lock();
+    }
+}
+
+bool MetricsExporter::export_now() {
+    std::string text;
+    render(metrics_, clock_, config_.prefix, text);
+    
+    // Write-then-rename, so a scraper never reads a half-written file
+    std::string tmp_path = config_.path + ".tmp";
+    if (!write_file(tmp_path, text) || std::rename(tmp_path.c_str(), config_.path.c_str()) != 0) {
+        failures_.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    exports_.fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
+
+void MetricsExporter::render(const EngineMetrics& metrics, const TscClock& clock,
+                             const std::string& prefix, std::string& out) {
+    out.clear();
+    render_summary(out, prefix, "queue_latency", "Submit to matching-thread pickup",
+                   metrics.queue_latency, clock);
+    render_summary(out, prefix, "match_latency", "Matching-thread pickup to result ready",
+                   metrics.match_latency, clock);
+    render_summary(out, prefix, "result_latency", "Result ready to get_result()",
+                   metrics.result_latency, clock);
+    render_value(out, prefix, "requests_total", "counter", metrics.requests);
+    render_value(out, prefix, "fills_total", "counter", metrics.fills);
+    render_value(out, prefix, "rejects_total", "counter", metrics.rejects);
+    render_value(out, prefix, "levels_swept_total", "counter", metrics.levels_swept);
+    render_value(out, prefix, "order_pool_in_use", "gauge", metrics.pool_in_use);
+    render_value(out, prefix, "order_pool_capacity", "gauge", metrics.pool_capacity);
+}
+
+uint64_t MetricsExporter::export_count() const {
+    return exports_.load(std::memory_order_relaxed);
+}
+
+uint64_t MetricsExporter::failure_count() const {
+    return failures_.load(std::memory_order_relaxed);
+}
+
+} // namespace telemetry
+} // namespace nanotrader
\ No newline at end of file
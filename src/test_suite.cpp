@@ -1,7 +1,37 @@
 #include "nanotrader/core/order_book.hpp"
+#include "nanotrader/core/depth_kernels.hpp"
+#include "nanotrader/core/matching_engine.hpp"
+#include "nanotrader/core/engine_runner.hpp"
+#include "nanotrader/core/market_data.hpp"
+#include "nanotrader/core/sharded_engine.hpp"
+#include "nanotrader/core/top_of_book.hpp"
 #include "nanotrader/memory/ring_buffer.hpp"
+#include "nanotrader/memory/thread_cached_pool.hpp"
+#include "nanotrader/network/gateway.hpp"
+#include "nanotrader/network/shm_gateway.hpp"
+#include "nanotrader/persistence/journal.hpp"
+#include "nanotrader/persistence/snapshot.hpp"
+#include "nanotrader/risk/pre_trade_risk.hpp"
+#include "nanotrader/telemetry/metrics_exporter.hpp"
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
 #include <iostream>
 #include <cassert>
+#include <memory>
+#include <random>
+#include <thread>
+#include <unordered_map>
+
+#if defined(__linux__)
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
 
 using namespace nanotrader;
 
@@ -145,7 +175,7 @@ void test_order_book_price_levels() {
     const PriceLevel* level = book.get_buy_level(Price(100.50));
     assert(level != nullptr);
     assert(level->total_quantity == 1500);
-    assert(level->head == &buy1);  // FIFO order
+    assert(book.front(*level).order == &buy1);  // FIFO order
     
     auto bid_levels = book.get_bid_levels(5);
     assert(bid_levels.size() == 2);
@@ -157,6 +187,2015 @@ void test_order_book_price_levels() {
     std::cout << "✓ PASSED\n";
 }
 
+void test_order_book_ladder() {
+    std::cout << "Testing OrderBook ladder backend... ";
+    
+    BookConfig config;
+    config.backend = BookConfig::Backend::Ladder;
+    config.tick_size = 10000;  // 0.01
+    config.ladder_width = 64;
+    OrderBook book(1, config);
+    
+    Order buy1(1, 1, Price(100.50), 1000, Side::Buy, OrderType::Limit, now());
+    Order buy2(2, 1, Price(100.50), 500, Side::Buy, OrderType::Limit, now());
+    Order buy3(3, 1, Price(100.40), 300, Side::Buy, OrderType::Limit, now());
+    Order sell1(4, 1, Price(100.60), 200, Side::Sell, OrderType::Limit, now());
+    Order off_tick(5, 1, Price(100.605), 100, Side::Sell, OrderType::Limit, now());
+    
+    assert(book.add_order(&buy1));
+    assert(book.add_order(&buy2));
+    assert(book.add_order(&buy3));
+    assert(book.add_order(&sell1));
+    assert(!book.add_order(&off_tick));
+    
+    assert(book.get_best_bid() == Price(100.50));
+    assert(book.get_best_ask() == Price(100.60));
+    assert(book.get_buy_level(Price(100.50))->total_quantity == 1500);
+    
+    auto bid_levels = book.get_bid_levels(5);
+    assert(bid_levels.size() == 2);
+    assert(bid_levels[0].first == Price(100.50));
+    assert(bid_levels[1].first == Price(100.40));
+    
+    // Far price forces the band to move while keeping live levels in place
+    Order far_buy(6, 1, Price(99.00), 100, Side::Buy, OrderType::Limit, now());
+    assert(book.add_order(&far_buy));
+    bid_levels = book.get_bid_levels(5);
+    assert(bid_levels.size() == 3);
+    assert(bid_levels[2].first == Price(99.00));
+    assert(book.get_buy_level(Price(100.50))->total_quantity == 1500);
+    
+    // Emptying the best level walks down to the next one
+    assert(book.remove_order(1));
+    assert(book.remove_order(2));
+    assert(book.get_best_bid() == Price(100.40));
+    assert(book.remove_order(3));
+    assert(book.get_best_bid() == Price(99.00));
+    assert(book.remove_order(6));
+    assert(!book.has_best_bid());
+    
+    // The band grows up to its cap and no further; the ladder is left as it was
+    config.max_ladder_width = 1024;
+    OrderBook capped(2, config);
+    Order low(7, 2, Price(100.00), 100, Side::Buy, OrderType::Limit, now());
+    Order edge(8, 2, Price(110.23), 100, Side::Buy, OrderType::Limit, now());     // 1024 ticks with low
+    Order beyond(9, 2, Price(110.24), 100, Side::Buy, OrderType::Limit, now());
+    Order far(10, 2, Price(1000000.00), 100, Side::Buy, OrderType::Limit, now());
+    assert(capped.add_order(&low));
+    assert(capped.accepts_price(Side::Buy, edge.price) && !capped.accepts_price(Side::Buy, beyond.price));
+    assert(!capped.accepts_price(Side::Buy, far.price) && capped.accepts_price(Side::Sell, far.price));
+    assert(!capped.add_order(&far) && !capped.add_order(&beyond));
+    assert(capped.add_order(&edge));
+    assert(capped.get_bid_levels(5).size() == 2 && capped.get_order_count() == 2);
+    
+    std::cout << "✓ PASSED\n";
+}
+
+void test_level_bitmap() {
+    std::cout << "Testing LevelBitmap... ";
+    
+    LevelBitmap bits(20000);
+    assert(bits.lowest() == LevelBitmap::npos);
+    assert(bits.highest() == LevelBitmap::npos);
+    
+    bits.set(3);
+    bits.set(64);
+    bits.set(9000);   // Different summary word
+    bits.set(19999);
+    
+    assert(bits.lowest() == 3);
+    assert(bits.highest() == 19999);
+    assert(bits.find_prev(63) == 3);
+    assert(bits.find_prev(64) == 64);
+    assert(bits.find_prev(8999) == 64);
+    assert(bits.find_next(65) == 9000);
+    assert(bits.find_next(9001) == 19999);
+    assert(bits.find_prev(2) == LevelBitmap::npos);
+    
+    bits.clear(9000);
+    assert(bits.find_next(65) == 19999);
+    assert(bits.find_prev(19998) == 64);
+    
+    // Hash book: best price search survives levels outside the bitmap window
+    BookConfig config;
+    config.bitmap_width = 128;
+    OrderBook book(1, config);
+    
+    Order near_bid(1, 1, Price(100.00), 100, Side::Buy, OrderType::Limit, now());
+    Order mid_bid(2, 1, Price(99.50), 100, Side::Buy, OrderType::Limit, now());
+    Order far_bid(3, 1, Price(90.00), 100, Side::Buy, OrderType::Limit, now());
+    book.add_order(&near_bid);
+    book.add_order(&mid_bid);
+    book.add_order(&far_bid);
+    
+    assert(book.remove_order(1));
+    assert(book.get_best_bid() == Price(99.50));
+    assert(book.remove_order(2));
+    assert(book.get_best_bid() == Price(90.00));
+    assert(book.remove_order(3));
+    assert(!book.has_best_bid());
+    
+    std::cout << "✓ PASSED\n";
+}
+
+void test_book_sizing() {
+    std::cout << "Testing per-class book sizing... ";
+    
+    constexpr BookConfig thin = book_config<ThinBook>();
+    static_assert(thin.backend == BookConfig::Backend::HashMap && thin.order_reserve == 1024);
+    static_assert(book_config<HotBook>().backend == BookConfig::Backend::Ladder);
+    static_assert(BookConfig{}.order_reserve == HotBook::order_reserve);
+    
+    // A thin and a hot book in one engine trade the same way
+    auto engine = std::make_unique<MatchingEngine>();
+    assert(engine->register_symbol(1, thin));
+    assert(engine->register_symbol(2, book_config<HotBook>()));
+    assert(engine->get_order_book(1)->get_config().level_reserve == ThinBook::level_reserve);
+    
+    OrderId next_id = 1;
+    for (Symbol symbol : {Symbol{1}, Symbol{2}}) {
+        // Past the thin book's reserves, so its tables grow on the way
+        for (int i = 0; i < 2000; ++i) {
+            Price price(static_cast<int64_t>(100000000 + (i % 100 + 1) * 10000));
+            engine->apply(OrderRequest(OrderRequest::Type::Add,
+                Order(next_id++, symbol, price, 10, Side::Sell, OrderType::Limit, 0)));
+        }
+        assert(engine->get_order_book(symbol)->get_order_count() == 2000);
+        
+        MatchResult result = engine->apply(OrderRequest(OrderRequest::Type::Add,
+            Order(next_id++, symbol, Price(100.50), 1000, Side::Buy, OrderType::Limit, 0)));
+        assert(result.status == MatchResult::Status::Matched);
+        assert(engine->get_order_book(symbol)->get_order_count() == 1900);
+        assert(engine->get_order_book(symbol)->get_best_ask() == Price(100.06));
+    }
+    
+    // Growing past a node slab leaves the nodes already resting where they are
+    const OrderBook* book = engine->get_order_book(1);
+    const QueueNode* resting = &book->front(*book->get_sell_level(Price(100.06)));
+    for (uint32_t i = 0; i < QueueNodeSlabs::SLAB_SIZE; ++i) {
+        engine->apply(OrderRequest(OrderRequest::Type::Add,
+            Order(next_id++, 1, Price(101.00), 10, Side::Sell, OrderType::Limit, 0)));
+    }
+    assert(book->get_order_count() == 1900 + QueueNodeSlabs::SLAB_SIZE);
+    assert(&book->front(*book->get_sell_level(Price(100.06))) == resting && resting->remaining == 10);
+    
+    std::cout << "✓ PASSED\n";
+}
+
+void test_depth_queries() {
+    std::cout << "Testing depth kernels (" << depth_kernels::isa() << ") and queries... ";
+    
+    std::mt19937 gen(11);
+    
+    // Every length around the vector widths, against a scalar reference
+    for (size_t n = 0; n < 70; ++n) {
+        std::vector<uint64_t> in(n), out(n);
+        for (uint64_t& value : in) {
+            value = gen() % 1000;
+        }
+        uint64_t total = depth_kernels::prefix_sum(in.data(), out.data(), n, 5);
+        uint64_t running = 5;
+        for (size_t i = 0; i < n; ++i) {
+            running += in[i];
+            assert(out[i] == running);
+        }
+        assert(total == running);
+        
+        for (uint64_t target : {uint64_t{0}, uint64_t{6}, running / 2, running, running + 1}) {
+            size_t expected = static_cast<size_t>(std::lower_bound(out.begin(), out.end(), target) - out.begin());
+            assert(depth_kernels::first_at_least(out.data(), n, target) == expected);
+        }
+    }
+    
+    BookConfig ladder;
+    ladder.backend = BookConfig::Backend::Ladder;
+    BookConfig narrow;
+    narrow.bitmap_width = 16;  // Most levels outside the window: the inexact fallback
+    for (const BookConfig& config : {BookConfig{}, ladder, narrow}) {
+        OrderBook book(1, config);
+        std::vector<Order> orders;
+        orders.reserve(600);
+        for (OrderId id = 1; id <= 600; ++id) {
+            Side side = id % 2 ? Side::Buy : Side::Sell;
+            int64_t ticks = 1 + static_cast<int64_t>(gen() % 150);
+            Price price(100000000 + (side == Side::Buy ? -ticks : ticks) * 10000);
+            orders.emplace_back(id, 1, price, 1 + gen() % 100, side, OrderType::Limit, 0);
+            book.add_order(&orders.back());
+        }
+        
+        auto asks = book.get_ask_levels(1000);
+        Quantity cumulative[200];
+        size_t written = book.get_cumulative_depth(Side::Sell, 100, cumulative);
+        assert(written == std::min<size_t>(100, asks.size()));
+        Quantity running = 0;
+        __int128 notional = 0;
+        for (size_t i = 0; i < written; ++i) {
+            running += asks[i].second;
+            notional += static_cast<__int128>(asks[i].first.raw_value()) * asks[i].second;
+            assert(cumulative[i] == running);
+        }
+        
+        DepthSummary summary = book.get_depth_summary(Side::Sell, 100);
+        assert(summary.levels == written && summary.quantity == running);
+        assert(summary.vwap.raw_value() == static_cast<int64_t>(notional / running));
+        
+        // Best-first visits match the sorted levels, across scan batches
+        auto bids = book.get_bid_levels(1000);
+        for (size_t depth : {size_t{1}, OrderBook::SCAN_BATCH, OrderBook::SCAN_BATCH + 1, size_t{1000}}) {
+            size_t visited = 0;
+            book.for_each_best_level(Side::Buy, depth, [&](Price price, Quantity quantity) {
+                assert(visited < bids.size() && bids[visited].first == price && bids[visited].second == quantity);
+                ++visited;
+            });
+            assert(visited == std::min(depth, bids.size()));
+        }
+        
+        // Available at or better than a limit, stopping at the level that reaches needed
+        Price limit(99.40);
+        for (Quantity needed : {Quantity{1}, Quantity{500}, Quantity{5000}, UINT64_MAX}) {
+            Quantity expected = 0;
+            for (const auto& [price, quantity] : bids) {
+                if (price < limit || expected >= needed) {
+                    break;
+                }
+                expected += quantity;
+            }
+            assert(book.get_available_quantity(Side::Buy, limit, needed) == expected);
+        }
+        assert(book.get_available_quantity(Side::Sell, Price(99.00), 1) == 0);
+    }
+    
+    std::cout << "✓ PASSED\n";
+}
+
+void test_matching_engine_sweep() {
+    std::cout << "Testing MatchingEngine sweep... ";
+    
+    auto engine = std::make_unique<MatchingEngine>();
+    assert(engine->register_symbol(1));
+    assert(engine->register_symbol(1) == engine->get_order_book(1));
+    assert(!engine->register_symbol(SymbolTable::DEFAULT_MAX_SYMBOL + 1));
+    
+    Order sell1(1, 1, Price(100.10), 300, Side::Sell, OrderType::Limit, now());
+    Order sell2(2, 1, Price(100.10), 200, Side::Sell, OrderType::Limit, now());
+    Order sell3(3, 1, Price(100.20), 400, Side::Sell, OrderType::Limit, now());
+    Order buy(4, 1, Price(100.20), 700, Side::Buy, OrderType::Limit, now());
+    
+    assert(engine->submit_order(OrderRequest(OrderRequest::Type::Add, sell1)));
+    assert(engine->submit_order(OrderRequest(OrderRequest::Type::Add, sell2)));
+    assert(engine->submit_order(OrderRequest(OrderRequest::Type::Add, sell3)));
+    assert(engine->submit_order(OrderRequest(OrderRequest::Type::Add, buy)));
+    engine->process_orders();
+    
+    MatchResult result;
+    for (int i = 0; i < 3; ++i) {
+        assert(engine->get_result(result));
+        assert(result.status == MatchResult::Status::Added);
+    }
+    
+    // Takes both orders at 100.10 in FIFO order, then part of 100.20
+    assert(engine->get_result(result));
+    assert(result.status == MatchResult::Status::Matched);
+    assert(result.trades.size() == 3);
+    assert(result.trades[0].maker_order_id == 1 && result.trades[0].quantity == 300);
+    assert(result.trades[1].maker_order_id == 2 && result.trades[1].quantity == 200);
+    assert(result.trades[2].maker_order_id == 3 && result.trades[2].quantity == 200);
+    assert(result.trades[2].price == Price(100.20));
+    
+    // One timestamp per matching event
+    assert(result.trades[0].timestamp == result.trades[1].timestamp);
+    assert(result.trades[1].timestamp == result.trades[2].timestamp);
+    
+    const OrderBook* book = engine->get_order_book(1);
+    assert(book->get_order_count() == 1);
+    assert(book->get_best_ask() == Price(100.20));
+    assert(book->get_sell_level(Price(100.20))->total_quantity == 200);
+    assert(!book->has_best_bid());
+    
+    // The partial fill reached the cold Order as well as its queue node
+    assert(book->get_order(3)->remaining_quantity == 200);
+    assert(book->front(*book->get_sell_level(Price(100.20))).remaining == 200);
+    
+    // Cancel the partially filled remainder
+    Order cancel(3, 1, Price(100.20), 0, Side::Sell, OrderType::Limit, now());
+    assert(engine->submit_order(OrderRequest(OrderRequest::Type::Cancel, cancel)));
+    engine->process_orders();
+    assert(engine->get_result(result));
+    assert(result.status == MatchResult::Status::Cancelled);
+    assert(book->get_order_count() == 0);
+    assert(!book->has_best_ask());
+    
+    // Unregistered symbols are rejected and never get a book
+    Order stray(4, 9, Price(100.00), 100, Side::Buy, OrderType::Limit, now());
+    assert(engine->submit_order(OrderRequest(OrderRequest::Type::Cancel, stray)));
+    assert(engine->submit_order(OrderRequest(OrderRequest::Type::Add, stray)));
+    engine->process_orders();
+    assert(engine->get_result(result) && result.status == MatchResult::Status::Rejected);
+    assert(engine->get_result(result) && result.status == MatchResult::Status::Rejected);
+    assert(!engine->get_order_book(9) && !engine->is_registered(9));
+    assert(engine->get_order_book_count() == 1);
+    
+    std::cout << "✓ PASSED\n";
+}
+
+void test_fill_or_kill() {
+    std::cout << "Testing fill-or-kill pre-check... ";
+    
+    auto engine = std::make_unique<MatchingEngine>();
+    engine->register_symbol(1);
+    const OrderBook* book = engine->get_order_book(1);
+    
+    // 300 @ 100.10, 300 @ 100.20, 300 @ 100.30
+    OrderId next_id = 1;
+    for (double price : {100.10, 100.20, 100.30}) {
+        for (int i = 0; i < 3; ++i) {
+            engine->apply(OrderRequest(OrderRequest::Type::Add,
+                Order(next_id++, 1, Price(price), 100, Side::Sell, OrderType::Limit, now())));
+        }
+    }
+    auto asks = book->get_ask_levels(10);
+    
+    // More than rests within the limit: rejected with the book untouched
+    MatchResult result = engine->apply(OrderRequest(OrderRequest::Type::Add,
+        Order(next_id++, 1, Price(100.20), 601, Side::Buy, OrderType::FOK, now())));
+    assert(result.status == MatchResult::Status::Rejected && result.trades.empty());
+    assert(book->get_order_count() == 9 && book->get_ask_levels(10) == asks);
+    
+    // Larger than the whole side
+    result = engine->apply(OrderRequest(OrderRequest::Type::Add,
+        Order(next_id++, 1, Price(100.30), 901, Side::Buy, OrderType::FOK, now())));
+    assert(result.status == MatchResult::Status::Rejected);
+    assert(book->get_order_count() == 9 && book->get_ask_levels(10) == asks);
+    
+    // Exactly what the limit allows fills in full and never rests
+    result = engine->apply(OrderRequest(OrderRequest::Type::Add,
+        Order(next_id++, 1, Price(100.20), 600, Side::Buy, OrderType::FOK, now())));
+    assert(result.status == MatchResult::Status::Matched && result.trades.size() == 6);
+    assert(book->get_order_count() == 3 && !book->has_best_bid());
+    assert(book->get_best_ask() == Price(100.30));
+    
+    result = engine->apply(OrderRequest(OrderRequest::Type::Add,
+        Order(next_id++, 1, Price(100.30), 250, Side::Buy, OrderType::FOK, now())));
+    assert(result.status == MatchResult::Status::Matched && result.trades.size() == 3);
+    assert(book->get_order_count() == 1);
+    assert(book->get_sell_level(Price(100.30))->total_quantity == 50);
+    
+    std::cout << "✓ PASSED\n";
+}
+
+void test_order_amend() {
+    std::cout << "Testing order amend priority... ";
+    
+    auto engine = std::make_unique<MatchingEngine>();
+    engine->register_symbol(1);
+    engine->register_symbol(2, book_config<HotBook>());
+    const OrderBook* book = engine->get_order_book(1);
+    using Status = MatchResult::Status;
+    
+    for (OrderId id = 1; id <= 3; ++id) {
+        engine->apply(OrderRequest(OrderRequest::Type::Add,
+            Order(id, 1, Price(100.00), 100, Side::Buy, OrderType::Limit, now())));
+    }
+    engine->apply(OrderRequest(OrderRequest::Type::Add,
+        Order(4, 1, Price(100.10), 50, Side::Sell, OrderType::Limit, now())));
+    auto queue = [&book](Price price) {
+        std::vector<OrderId> ids;
+        book->for_each_order(*book->get_buy_level(price), [&ids](const Order& order) { ids.push_back(order.id); });
+        return ids;
+    };
+    auto amend = [&engine](OrderRequest::Type type, OrderId id, Price price, Quantity quantity) {
+        OrderRequest request(type, Order(id, 1, price, 0, Side::Buy, OrderType::Limit, now()));
+        request.new_quantity = quantity;
+        return engine->apply(request);
+    };
+    
+    // Shrinking keeps the place in the queue, growing goes to the back
+    assert(amend(OrderRequest::Type::Modify, 1, Price{}, 60).status == Status::Modified);
+    assert((queue(Price(100.00)) == std::vector<OrderId>{1, 2, 3}));
+    assert(amend(OrderRequest::Type::Modify, 2, Price{}, 150).status == Status::Modified);
+    assert((queue(Price(100.00)) == std::vector<OrderId>{1, 3, 2}));
+    assert(book->get_buy_level(Price(100.00))->total_quantity == 310);
+    
+    // A new price moves the same Order to the back of the new level
+    const Order* third = book->get_order(3);
+    assert(amend(OrderRequest::Type::Replace, 3, Price(99.90), 80).status == Status::Modified);
+    assert(book->get_order(3) == third && third->price == Price(99.90) && third->remaining_quantity == 80);
+    assert(book->get_buy_level(Price(100.00))->total_quantity == 210);
+    assert((queue(Price(99.90)) == std::vector<OrderId>{3}));
+    
+    // A crossing price trades first and the rest stays resting
+    const Order* first = book->get_order(1);
+    MatchResult result = amend(OrderRequest::Type::Replace, 1, Price(100.10), 70);
+    assert(result.status == Status::Matched && result.trades.size() == 1);
+    assert(result.trades[0].maker_order_id == 4 && result.trades[0].taker_order_id == 1);
+    assert(result.trades[0].price == Price(100.10) && result.trades[0].quantity == 50);
+    assert(book->get_order(1) == first && first->remaining_quantity == 20);
+    assert(book->get_best_bid() == Price(100.10) && !book->has_best_ask());
+    
+    // Filled in full on the way, the order is gone
+    engine->apply(OrderRequest(OrderRequest::Type::Add,
+        Order(5, 1, Price(100.20), 30, Side::Sell, OrderType::Limit, now())));
+    result = amend(OrderRequest::Type::Replace, 2, Price(100.30), 30);
+    assert(result.status == Status::Matched && result.trades.size() == 1);
+    assert(!book->get_order(2) && !book->has_best_ask() && book->get_order_count() == 2);
+    
+    // Unknown orders and prices the book can't rest are rejected; zero cancels
+    assert(amend(OrderRequest::Type::Replace, 99, Price(100.00), 10).status == Status::Rejected);
+    assert(amend(OrderRequest::Type::Replace, 3, Price{}, 0).status == Status::Cancelled);
+    assert(book->get_order_count() == 1);
+    
+    engine->apply(OrderRequest(OrderRequest::Type::Add,
+        Order(6, 2, Price(100.00), 10, Side::Sell, OrderType::Limit, now())));
+    OrderRequest off_tick(OrderRequest::Type::Replace, Order(6, 2, Price(100.005), 0, Side::Sell, OrderType::Limit, now()));
+    off_tick.new_quantity = 20;
+    assert(engine->apply(off_tick).status == Status::Rejected);
+    const Order* resting = engine->get_order_book(2)->get_order(6);
+    assert(resting && resting->price == Price(100.00) && resting->remaining_quantity == 10);
+    
+    // So is a new order too far from its side's levels for the ladder to cover
+    OrderRequest far(OrderRequest::Type::Add, Order(7, 2, Price(1000000.00), 10, Side::Sell, OrderType::Limit, now()));
+    assert(engine->apply(far).status == Status::Rejected);
+    assert(!engine->get_order_book(2)->get_order(7) && engine->get_order_book(2)->get_order_count() == 1);
+    
+    std::cout << "✓ PASSED\n";
+}
+
+void test_order_index() {
+    std::cout << "Testing OrderIndex... ";
+    
+    OrderIndex index(8);
+    std::unordered_map<OrderId, uint32_t> reference;
+    std::mt19937 gen(7);
+    
+    // Random inserts/erases across several rehashes, checked against unordered_map
+    for (int step = 0; step < 50000; ++step) {
+        OrderId id = gen() % 2048;
+        uint32_t node = static_cast<uint32_t>(gen() % 100000);
+        
+        if (gen() % 3 == 0) {
+            assert(index.erase(id) == (reference.erase(id) == 1));
+        } else {
+            bool inserted = reference.emplace(id, node).second;
+            assert(index.insert(id, node) == inserted);
+        }
+        
+        OrderId probe = gen() % 2048;
+        auto it = reference.find(probe);
+        assert(index.find(probe) == (it != reference.end() ? it->second : OrderIndex::npos));
+    }
+    
+    assert(index.size() == reference.size());
+    for (const auto& [id, node] : reference) {
+        assert(index.extract(id) == node);
+    }
+    assert(index.empty());
+    
+    std::cout << "✓ PASSED\n";
+}
+
+void test_matching_engine_batch() {
+    std::cout << "Testing MatchingEngine batch processing... ";
+    
+    auto engine = std::make_unique<MatchingEngine>();
+    engine->register_symbol(1);
+    engine->register_symbol(2);
+    engine->set_batch_size(4);
+    assert(engine->get_batch_size() == 4);
+    
+    // Interleaved symbols: results must still come back in submission order
+    Order sell_a(1, 1, Price(50.00), 100, Side::Sell, OrderType::Limit, now());
+    Order sell_b(2, 2, Price(70.00), 100, Side::Sell, OrderType::Limit, now());
+    Order buy_a(3, 1, Price(50.00), 100, Side::Buy, OrderType::Limit, now());
+    Order buy_b(4, 2, Price(69.00), 100, Side::Buy, OrderType::Limit, now());
+    Order buy_a2(5, 1, Price(49.00), 100, Side::Buy, OrderType::Limit, now());
+    
+    for (const Order* order : {&sell_a, &sell_b, &buy_a, &buy_b, &buy_a2}) {
+        assert(engine->submit_order(OrderRequest(OrderRequest::Type::Add, *order)));
+    }
+    
+    assert(engine->process_batch() == 4);
+    assert(engine->process_batch() == 1);
+    assert(engine->process_batch() == 0);
+    assert(engine->get_processed_orders() == 5);
+    
+    MatchResult result;
+    OrderId expected_ids[] = {1, 2, 3, 4, 5};
+    for (OrderId id : expected_ids) {
+        assert(engine->get_result(result));
+        assert(result.order_id == id);
+        assert(result.status == (id == 3 ? MatchResult::Status::Matched : MatchResult::Status::Added));
+    }
+    assert(!engine->get_result(result));
+    
+    assert(engine->get_order_book(1)->get_best_bid() == Price(49.00));
+    assert(engine->get_order_book(2)->get_best_bid() == Price(69.00));
+    
+    std::cout << "✓ PASSED\n";
+}
+
+void test_trade_buffer() {
+    std::cout << "Testing TradeBuffer spill path... ";
+    
+    TradeBuffer::Arena arena(2);
+    size_t free_blocks = arena.available_count();
+    
+    {
+        TradeBuffer trades(&arena);
+        for (size_t i = 0; i < TradeBuffer::INLINE_CAPACITY; ++i) {
+            trades.emplace_back(i, 100, 1, Price(10.00), 1, 0);
+        }
+        assert(!trades.spilled());
+        
+        // Next trade moves everything into an arena block
+        trades.emplace_back(TradeBuffer::INLINE_CAPACITY, 100, 1, Price(10.00), 1, 0);
+        assert(trades.spilled());
+        assert(arena.available_count() == free_blocks - 1);
+        
+        // Moving keeps the block; the moved-from buffer owns nothing
+        TradeBuffer moved(std::move(trades));
+        assert(trades.empty() && !trades.spilled());
+        
+        // Past the block capacity, heap takes over and the block is returned
+        for (size_t i = moved.size(); i < TradeBuffer::SPILL_CAPACITY + 10; ++i) {
+            moved.emplace_back(i, 100, 1, Price(10.00), 1, 0);
+        }
+        assert(arena.available_count() == free_blocks);
+        
+        for (size_t i = 0; i < moved.size(); ++i) {
+            assert(moved[i].maker_order_id == i);
+        }
+    }
+    
+    {
+        TradeBuffer trades(&arena);
+        for (size_t i = 0; i < 20; ++i) {
+            trades.emplace_back(i, 100, 1, Price(10.00), 1, 0);
+        }
+        assert(arena.available_count() == free_blocks - 1);
+    }
+    assert(arena.available_count() == free_blocks);
+    
+    std::cout << "✓ PASSED\n";
+}
+
+void test_tsc_clock() {
+    std::cout << "Testing TscClock calibration... ";
+    
+    TscClock clock;
+    clock.calibrate();
+    
+    Timestamp reference = now();
+    Timestamp converted = clock.now();
+    Timestamp diff = converted > reference ? converted - reference : reference - converted;
+    assert(diff < 1000000);  // Within 1ms of now()
+    
+    uint64_t start = TscClock::cycles();
+    uint64_t end = TscClock::cycles();
+    assert(end >= start);
+    assert(clock.cycles_to_ns(clock.cycles_per_us() * 1000) > 900000);
+    
+    // Re-anchoring is a no-op until the interval passes, then lands back on now()
+    clock.set_reanchor_interval(std::chrono::milliseconds(5));
+    clock.calibrate(std::chrono::microseconds(200));
+    assert(!clock.reanchor_if_due());
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    assert(clock.reanchor_if_due());
+    assert(!clock.reanchor_if_due());
+    reference = now();
+    converted = clock.now();
+    diff = converted > reference ? converted - reference : reference - converted;
+    assert(diff < 100000);
+    assert(clock.cycles_to_ns(clock.cycles_per_us() * 1000) > 990000);
+    
+    std::cout << "✓ PASSED\n";
+}
+
+void test_pool_policies() {
+    std::cout << "Testing PoolAllocator policies... ";
+    
+    PoolAllocator<Order, SingleThreaded> pool(4);
+    Order* a = pool.construct(1, 1, Price(10.00), 100, Side::Buy, OrderType::Limit, now());
+    Order* b = pool.allocate();
+    assert(a && b && a != b);
+    assert(a->id == 1);
+    pool.destroy(a);
+    assert(pool.allocate() == a);  // LIFO reuse keeps the hot object in cache
+    pool.deallocate(b);
+    
+    // Counters are maintained, slabs are rounded to a hugepage, and exhaustion maps a new slab
+    PoolOptions options;
+    options.growth_size = 4;
+    PoolAllocator<Order, SingleThreaded> growable(4, options);
+    size_t first_slab = growable.capacity();
+    assert(first_slab >= 4 && growable.available_count() == first_slab);
+    std::vector<Order*> drained;
+    for (size_t i = 0; i < first_slab; ++i) {
+        drained.push_back(growable.construct(i, 1, Price(1.00), 1, Side::Buy, OrderType::Limit, 0));
+    }
+    assert(growable.available_count() == 0 && growable.slab_count() == 1);
+    Order* extra = growable.allocate();
+    assert(extra && growable.slab_count() == 2 && growable.capacity() > first_slab);
+    assert(drained.front()->id == 0 && drained.back()->id == first_slab - 1);  // Nothing moved
+    growable.deallocate(extra);
+    for (Order* order : drained) growable.destroy(order);
+    assert(growable.available_count() == growable.capacity());
+    
+    PoolOptions capped;
+    capped.growable = false;
+    PoolAllocator<Order, SingleThreaded> fixed(4, capped);
+    for (size_t i = fixed.capacity(); i > 0; --i) fixed.allocate();
+    assert(fixed.allocate() == nullptr && fixed.slab_count() == 1);
+    
+    // Per-thread caches over a shared depot: every object is owned by one thread at a time
+    constexpr size_t POOL_SIZE = 4096;
+    ThreadCachedPool<Order, 32> shared(POOL_SIZE);
+    std::vector<std::thread> threads;
+    std::atomic<bool> failed{false};
+    
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([&shared, &failed, t] {
+            ThreadCachedPool<Order, 32>::Cache cache(shared);
+            std::vector<Order*> held;
+            std::mt19937 gen(t);
+            
+            for (int step = 0; step < 100000; ++step) {
+                if (held.empty() || (gen() % 2 && held.size() < 512)) {
+                    Order* order = cache.construct(static_cast<OrderId>(t), 1, Price(1.00), 1, 
+                                                   Side::Buy, OrderType::Limit, 0);
+                    if (order) held.push_back(order);
+                } else {
+                    Order* order = held.back();
+                    held.pop_back();
+                    if (order->id != static_cast<OrderId>(t)) failed = true;
+                    cache.destroy(order);
+                }
+            }
+            
+            for (Order* order : held) {
+                if (order->id != static_cast<OrderId>(t)) failed = true;
+                cache.destroy(order);
+            }
+        });
+    }
+    
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    assert(!failed);
+    
+    // All objects are back in the depot after the caches flushed
+    ThreadCachedPool<Order, 32>::Cache cache(shared);
+    std::vector<Order*> all;
+    while (Order* order = cache.allocate()) {
+        all.push_back(order);
+    }
+    assert(all.size() == POOL_SIZE);
+    for (Order* order : all) {
+        cache.deallocate(order);
+    }
+    
+    std::cout << "✓ PASSED\n";
+}
+
+void test_backpressure() {
+    std::cout << "Testing output backpressure policies... ";
+    
+    // Cancels of unknown orders make cheap results numbered by order id
+    OrderId next_id = 1;
+    auto submit = [&next_id](MatchingEngine& engine) {
+        return engine.submit_order(OrderRequest(OrderRequest::Type::Cancel, 
+            Order(next_id, 1, Price{}, 0, Side::Buy, OrderType::Limit, 0))) && ++next_id;
+    };
+    auto fill_output = [&](MatchingEngine& engine) {
+        size_t count = 0;
+        while (submit(engine)) ++count;  // Input and output rings are the same size
+        engine.process_orders();
+        assert(engine.get_processed_orders() == count);
+        return count;
+    };
+    OrderId expected = 1;
+    auto expect_results = [&expected](MatchingEngine& engine, size_t count) {
+        MatchResult result;
+        for (size_t i = 0; i < count; ++i) {
+            assert(engine.get_result(result) && result.order_id == expected++);
+        }
+    };
+    
+    // Throttle (default): requests wait in the input ring, none is applied without room
+    {
+        auto engine = std::make_unique<MatchingEngine>();
+        engine->register_symbol(1);
+        assert(engine->get_backpressure_policy() == BackpressurePolicy::Throttle);
+        size_t capacity = fill_output(*engine);
+        for (int i = 0; i < 10; ++i) assert(submit(*engine));
+        
+        engine->process_orders();
+        assert(engine->process_batch() == 0);
+        assert(engine->get_processed_orders() == capacity);
+        assert(engine->get_throttle_count() == 2);
+        
+        expect_results(*engine, 4);
+        engine->process_orders();
+        assert(engine->get_processed_orders() == capacity + 4);
+        assert(engine->get_throttle_count() == 3);
+        expect_results(*engine, capacity);
+        assert(engine->process_batch() == 6);
+        expect_results(*engine, 6);
+        assert(engine->get_spill_count() == 0 && engine->get_spin_wait_count() == 0);
+    }
+    
+    // Spill: results park in the overflow ring and come out in order behind the rest
+    {
+        auto engine = std::make_unique<MatchingEngine>();
+        engine->register_symbol(1);
+        assert(engine->set_backpressure_policy(BackpressurePolicy::Spill));
+        size_t capacity = fill_output(*engine);
+        for (int i = 0; i < 100; ++i) assert(submit(*engine));
+        while (engine->process_batch() > 0) {
+        }
+        assert(engine->get_processed_orders() == capacity + 100);
+        assert(engine->get_spill_count() == 100 && engine->get_spilled_results() == 100);
+        assert(!engine->set_backpressure_policy(BackpressurePolicy::Throttle));
+        
+        expect_results(*engine, capacity);
+        MatchResult result;
+        assert(!engine->get_result(result));
+        assert(engine->process_batch() == 0);  // Idle call still republishes
+        assert(engine->get_spilled_results() == 0);
+        expect_results(*engine, 100);
+        assert(engine->set_backpressure_policy(BackpressurePolicy::Throttle));
+    }
+    
+    // Spin: the matching thread waits for a consumer on another thread
+    {
+        auto engine = std::make_unique<MatchingEngine>();
+        engine->register_symbol(1);
+        assert(engine->set_backpressure_policy(BackpressurePolicy::Spin));
+        size_t capacity = fill_output(*engine);
+        for (int i = 0; i < 100; ++i) assert(submit(*engine));
+        
+        std::thread consumer([&] {
+            std::this_thread::sleep_for(std::chrono::milliseconds(20));
+            MatchResult result;
+            for (size_t received = 0; received < capacity + 100;) {
+                if (engine->get_result(result)) {
+                    assert(result.order_id == expected++);
+                    ++received;
+                }
+            }
+        });
+        engine->process_orders();
+        consumer.join();
+        assert(engine->get_processed_orders() == capacity + 100);
+        assert(engine->get_spin_wait_count() >= 1 && engine->get_throttle_count() == 0);
+    }
+    
+    std::cout << "✓ PASSED\n";
+}
+
+void test_sharded_engine() {
+    std::cout << "Testing ShardedEngine... ";
+    
+    ShardedEngine engine(4);
+    assert(engine.get_shard_count() == 4);
+    
+    // Router is deterministic and spreads symbols over every shard
+    std::vector<size_t> per_shard(4, 0);
+    for (Symbol symbol = 1; symbol <= 5000; ++symbol) {
+        size_t shard = engine.shard_for(symbol);
+        assert(shard < 4 && shard == engine.shard_for(symbol));
+        ++per_shard[shard];
+    }
+    for (size_t count : per_shard) assert(count > 1000);
+    
+    // Each symbol trades against itself on its own shard
+    constexpr Symbol SYMBOLS = 64;
+    for (Symbol symbol = 1; symbol <= SYMBOLS; ++symbol) {
+        assert(engine.register_symbol(symbol));
+    }
+    engine.start();
+    
+    OrderId id = 1;
+    size_t expected = 0;
+    size_t received = 0;
+    size_t matched = 0;
+    MatchResult result;
+    
+    auto submit = [&](const OrderRequest& request) {
+        while (!engine.submit_order(request)) {
+            if (engine.get_result(result)) {
+                ++received;
+                matched += result.status == MatchResult::Status::Matched;
+            }
+        }
+        ++expected;
+    };
+    
+    for (Symbol symbol = 1; symbol <= SYMBOLS; ++symbol) {
+        submit(OrderRequest(OrderRequest::Type::Add, 
+                            Order(id++, symbol, Price(10.00), 100, Side::Sell, OrderType::Limit, now())));
+        submit(OrderRequest(OrderRequest::Type::Add, 
+                            Order(id++, symbol, Price(10.00), 100, Side::Buy, OrderType::Limit, now())));
+    }
+    
+    while (received < expected) {
+        if (engine.get_result(result)) {
+            ++received;
+            matched += result.status == MatchResult::Status::Matched;
+        }
+    }
+    
+    engine.stop();
+    assert(matched == SYMBOLS);
+    assert(engine.get_processed_orders() == expected);
+    assert(engine.get_order_book_count() == SYMBOLS);
+    assert(engine.get_total_orders() == 0);
+    
+    OrderBook* book = engine.get_order_book(7);
+    assert(book && book->get_symbol() == 7);
+    assert(engine.get_shard(engine.shard_for(7)).get_order_book(7) == book);
+    
+    std::cout << "✓ PASSED\n";
+}
+
+void test_engine_runner() {
+    std::cout << "Testing EngineRunner idle strategies... ";
+    
+    for (IdleStrategy strategy : {IdleStrategy::Spin, IdleStrategy::SpinYield, IdleStrategy::SpinPark}) {
+        auto engine = std::make_unique<MatchingEngine>();
+        engine->register_symbol(1);
+        
+        RunnerConfig config;
+        config.cpu = 0;
+        config.idle = strategy;
+        config.spin_iterations = 16;
+        config.park_timeout = std::chrono::microseconds(200);
+        EngineRunner runner(*engine, config);
+        assert(runner.start() && runner.is_running() && !runner.start());
+        assert(runner.get_numa_node() == -1 || runner.is_pinned());
+        
+        // A parked runner is woken by notify() on every submit
+        OrderId id = 1;
+        size_t received = 0;
+        MatchResult result;
+        for (int round = 0; round < 50; ++round) {
+            for (Side side : {Side::Sell, Side::Buy}) {
+                while (!engine->submit_order(OrderRequest(OrderRequest::Type::Add,
+                           Order(id++, 1, Price(10.00), 100, side, OrderType::Limit, 0)))) {
+                    std::this_thread::yield();
+                }
+                runner.notify();
+            }
+            while (received < id - 1) {
+                if (engine->get_result(result)) {
+                    assert(result.status == (received % 2 ? MatchResult::Status::Matched 
+                                                          : MatchResult::Status::Added));
+                    ++received;
+                }
+            }
+            if (strategy == IdleStrategy::SpinPark && round % 10 == 0) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));  // Let it park
+            }
+        }
+        
+        // Requests accepted before stop() are drained, not dropped
+        assert(engine->submit_order(OrderRequest(OrderRequest::Type::Add,
+            Order(id++, 1, Price(9.00), 100, Side::Buy, OrderType::Limit, 0))));
+        runner.stop();
+        assert(!runner.is_running() && !engine->is_running());
+        assert(engine->get_processed_orders() == id - 1);
+        assert(engine->get_total_orders() == 1);
+        assert((runner.get_park_count() > 0) == (strategy == IdleStrategy::SpinPark));
+    }
+    
+    std::cout << "✓ PASSED\n";
+}
+
+void test_journal() {
+    std::cout << "Testing Journal... ";
+    
+    std::string path = (std::filesystem::temp_directory_path() / "nanotrader_test_journal.wal").string();
+    std::string results_path = path + ".results";
+    std::filesystem::remove(path);
+    std::filesystem::remove(results_path);
+    
+    JournalConfig config;
+    config.path = path;
+    config.results_path = results_path;
+    config.durability = JournalConfig::Durability::EveryBatch;
+    
+    {
+        auto journal = std::make_unique<Journal>(config);
+        assert(journal->open());
+        
+        auto engine = std::make_unique<MatchingEngine>();
+        engine->register_symbol(1);
+        engine->attach_journal(journal.get());
+        
+        // Rejected requests are journaled too: replay must see exactly what the engine saw
+        for (OrderId id = 1; id <= 10; ++id) {
+            Order order(id, id == 10 ? 99 : 1, Price(100.00), 10 * id, 
+                        id % 2 ? Side::Buy : Side::Sell, OrderType::Limit, id);
+            assert(engine->submit_order(OrderRequest(OrderRequest::Type::Add, order)));
+        }
+        engine->process_batch();
+        OrderRequest modify(OrderRequest::Type::Modify, Order(1, 1, Price(100.00), 0, Side::Buy, OrderType::Limit, 11));
+        modify.new_quantity = 5;
+        assert(engine->submit_order(modify));
+        engine->process_orders();
+        
+        journal->flush();
+        assert(journal->appended_sequence() == 11 && journal->durable_sequence() == 11);
+        assert(journal->healthy());
+    }
+    
+    {
+        JournalReader reader(path);
+        assert(reader.is_open());
+        JournalRecord record;
+        for (uint64_t seq = 1; seq <= 10; ++seq) {
+            assert(reader.next(record) && record.sequence == seq);
+            OrderRequest request = record.to_request();
+            assert(request.type == OrderRequest::Type::Add && request.order.id == seq);
+            assert(request.order.quantity == 10 * seq && request.order.price == Price(100.00));
+        }
+        assert(reader.next(record) && record.to_request().new_quantity == 5);
+        assert(!reader.next(record) && !reader.corrupt());
+    }
+    
+    // The sidecar holds what the live engine produced for each record, so a replay
+    // is checked against production output, not against another replay
+    {
+        std::vector<ResultDigest> live;
+        assert(read_result_digests(results_path, live) && live.size() == 11);
+        
+        auto engine = std::make_unique<MatchingEngine>();
+        engine->register_symbol(1);
+        JournalReader reader(path);
+        JournalRecord record;
+        for (const ResultDigest& digest : live) {
+            assert(reader.next(record) && record.sequence == digest.sequence);
+            assert(result_digest(engine->replay(record.to_request())) == digest.digest);
+        }
+        
+        MatchResult rejected(MatchResult::Status::Rejected, 10);
+        assert(result_digest(rejected) == live[9].digest);
+        assert(result_digest(MatchResult(MatchResult::Status::Added, 10)) != live[9].digest);
+    }
+    
+    // A torn final write is truncated and the sequence continues after the last good record
+    {
+        std::ofstream torn(path, std::ios::binary | std::ios::app);
+        torn.write("garbage", 7);
+    }
+    {
+        Journal journal(config);
+        assert(journal.open());
+        assert(journal.appended_sequence() == 11);
+        assert(journal.append(OrderRequest(OrderRequest::Type::Cancel, Order())) == 12);
+        journal.flush();
+    }
+    {
+        JournalReader reader(path);
+        JournalRecord record;
+        while (reader.next(record)) {
+        }
+        assert(reader.records_read() == 12 && !reader.corrupt());
+        assert(record.sequence == 12 && record.to_request().type == OrderRequest::Type::Cancel);
+    }
+    
+    // Results for records the journal lost in a crash are dropped on reopen
+    {
+        ResultDigest orphan{13, 0};
+        std::ofstream ahead(results_path, std::ios::binary | std::ios::app);
+        ahead.write(reinterpret_cast<const char*>(&orphan), sizeof(orphan));
+    }
+    {
+        Journal journal(config);
+        assert(journal.open() && journal.appended_sequence() == 12);
+        journal.close();
+        std::vector<ResultDigest> live;
+        assert(read_result_digests(results_path, live) && live.size() == 11);
+    }
+    
+    std::filesystem::remove(path);
+    std::filesystem::remove(results_path);
+    std::cout << "✓ PASSED\n";
+}
+
+void test_snapshot_recovery() {
+    std::cout << "Testing snapshot recovery... ";
+    
+    auto dir = std::filesystem::temp_directory_path();
+    std::string journal_path = (dir / "nanotrader_test_recovery.wal").string();
+    std::string snapshot_path = (dir / "nanotrader_test_recovery.snap").string();
+    std::filesystem::remove(journal_path);
+    std::filesystem::remove(snapshot_path);
+    
+    BookConfig ladder;
+    ladder.backend = BookConfig::Backend::Ladder;
+    
+    auto live = std::make_unique<MatchingEngine>();
+    live->register_symbol(1, book_config<ThinBook>());
+    live->register_symbol(2, ladder);
+    
+    std::mt19937 gen(7);
+    OrderId next_id = 1;
+    auto random_request = [&]() {
+        Symbol symbol = 1 + gen() % 2;
+        Side side = gen() % 2 ? Side::Buy : Side::Sell;
+        Price price(static_cast<int64_t>(99000000 + (gen() % 200) * 10000));
+        OrderId id = next_id++;
+        return OrderRequest(OrderRequest::Type::Add, 
+                            Order(id, symbol, price, 1 + gen() % 500, side, OrderType::Limit, id));
+    };
+    
+    {
+        // Nothing is synced until close(), so the snapshot has to wait for the journal
+        JournalConfig config;
+        config.path = journal_path;
+        config.group_commit_interval = std::chrono::hours(1);
+        Journal journal(config);
+        assert(journal.open());
+        live->attach_journal(&journal);
+        
+        MatchResult result;
+        auto run = [&](size_t count) {
+            for (size_t i = 0; i < count; ++i) {
+                assert(live->submit_order(random_request()));
+                live->process_orders();
+                assert(live->get_result(result));
+            }
+        };
+        
+        run(2000);
+        SnapshotWriter writer;
+        writer.capture(*live);
+        assert(writer.header().journal_sequence == 2000 && journal.durable_sequence() < 2000);
+        assert(writer.header().order_count == live->get_total_orders());
+        std::atomic<bool> written{false};
+        std::thread snapshotter([&] { written.store(writer.write(snapshot_path)); });
+        run(500);  // Journal tail past the snapshot
+        assert(!std::filesystem::exists(snapshot_path));
+        
+        live->attach_journal(nullptr);
+        journal.close();
+        snapshotter.join();
+        assert(written.load() && journal.durable_sequence() == 2500);
+    }
+    
+    auto restored = std::make_unique<MatchingEngine>();
+    RecoveryResult recovery = recover(*restored, snapshot_path, journal_path);
+    assert(recovery.ok && recovery.from_snapshot);
+    assert(recovery.snapshot_sequence == 2000 && recovery.replayed == 500);
+    assert(recovery.last_sequence == 2500);
+    assert(restored->get_order_book(2)->get_config().backend == BookConfig::Backend::Ladder);
+    assert(restored->get_order_book(1)->get_config().order_reserve == ThinBook::order_reserve);
+    
+    // Same levels, and the same FIFO queue at every level
+    for (Symbol symbol : {Symbol{1}, Symbol{2}}) {
+        const OrderBook* a = live->get_order_book(symbol);
+        const OrderBook* b = restored->get_order_book(symbol);
+        assert(a->get_order_count() == b->get_order_count());
+        assert(a->get_bid_levels(1000) == b->get_bid_levels(1000));
+        assert(a->get_ask_levels(1000) == b->get_ask_levels(1000));
+        
+        for (Side side : {Side::Buy, Side::Sell}) {
+            a->for_each_level(side, [a, b, side](const PriceLevel& level) {
+                const PriceLevel* other = side == Side::Buy ? b->get_buy_level(level.price)
+                                                            : b->get_sell_level(level.price);
+                assert(other);
+                std::vector<std::pair<OrderId, Quantity>> x, y;
+                a->for_each_order(level, [&x](const Order& order) { x.emplace_back(order.id, order.remaining_quantity); });
+                b->for_each_order(*other, [&y](const Order& order) { y.emplace_back(order.id, order.remaining_quantity); });
+                assert(x == y);
+            });
+        }
+    }
+    
+    // Without a snapshot the whole journal is replayed to the same state
+    auto replayed = std::make_unique<MatchingEngine>();
+    replayed->register_symbol(1);
+    replayed->register_symbol(2, ladder);
+    recovery = recover(*replayed, "", journal_path);
+    assert(recovery.ok && !recovery.from_snapshot && recovery.replayed == 2500);
+    assert(replayed->get_total_orders() == live->get_total_orders());
+    assert(replayed->get_order_book(1)->get_bid_levels(1000) == live->get_order_book(1)->get_bid_levels(1000));
+    
+    // A snapshot ahead of the journal on disk is refused, and a journal reopened
+    // after recovery numbers its records past the snapshot
+    {
+        SnapshotWriter ahead;
+        ahead.capture(*live, 2600);
+        assert(ahead.write(snapshot_path));
+        auto lost = std::make_unique<MatchingEngine>();
+        assert(!recover(*lost, snapshot_path, journal_path).ok);
+        
+        JournalConfig config;
+        config.path = journal_path;
+        config.resume_after = 2600;
+        auto journal = std::make_unique<Journal>(config);
+        assert(journal->open() && journal->appended_sequence() == 2600);
+        assert(journal->append(OrderRequest(OrderRequest::Type::Cancel, Order())) == 2601);
+        journal->close();
+        
+        auto resumed = std::make_unique<MatchingEngine>();
+        recovery = recover(*resumed, snapshot_path, journal_path);
+        assert(recovery.ok && recovery.replayed == 1 && recovery.last_sequence == 2601);
+    }
+    
+    // A corrupted snapshot is refused rather than half-applied
+    {
+        std::fstream corrupt(snapshot_path, std::ios::binary | std::ios::in | std::ios::out);
+        corrupt.seekp(sizeof(SnapshotHeader) + 8);
+        corrupt.put('\x7f');
+    }
+    assert(!SnapshotReader(snapshot_path).is_open());
+    
+    // With a risk stage, only admitted requests are journaled and the snapshot
+    // carries its account state, so recovery rebuilds the books and the stage
+    std::filesystem::remove(journal_path);
+    using AccountRisk = PreTradeRisk<PriceBandCheck, AccountLimitsCheck>;
+    auto make_risk = [] {
+        auto risk = std::make_unique<AccountRisk>(RiskLimits{}, 8, 1024, 8);
+        risk->get_accounts().set_default_limits(AccountLimits{400, 1000});
+        return risk;
+    };
+    auto live_risk = make_risk();
+    auto guarded = std::make_unique<MatchingEngine>();
+    guarded->register_symbol(1);
+    guarded->register_symbol(2);
+    guarded->attach_risk(live_risk.get());
+    {
+        JournalConfig config;
+        config.path = journal_path;
+        Journal journal(config);
+        assert(journal.open());
+        guarded->attach_journal(&journal);
+        
+        MatchResult result;
+        auto run = [&](size_t count) {
+            for (size_t i = 0; i < count; ++i) {
+                OrderRequest request = random_request();
+                request.account = static_cast<AccountId>(gen() % 4);
+                assert(guarded->submit_order(request));
+                guarded->process_batch();
+                assert(guarded->get_result(result));
+            }
+        };
+        
+        run(1000);
+        SnapshotWriter writer;
+        writer.capture(*guarded);
+        assert(writer.header().risk_bytes > 0 && writer.write(snapshot_path));
+        run(500);
+        
+        journal.flush();
+        assert(live_risk->get_total_rejects() > 0 && journal.appended_sequence() < 1500);
+        guarded->attach_journal(nullptr);
+    }
+    
+    auto same_state = [&](const MatchingEngine& engine, const AccountRisk* risk) {
+        for (Symbol symbol : {Symbol{1}, Symbol{2}}) {
+            assert(engine.get_order_book(symbol)->get_bid_levels(1000) == guarded->get_order_book(symbol)->get_bid_levels(1000));
+            assert(engine.get_order_book(symbol)->get_ask_levels(1000) == guarded->get_order_book(symbol)->get_ask_levels(1000));
+        }
+        for (AccountId account = 0; risk && account < 8; ++account) {
+            const AccountState* a = risk->get_accounts().find(account);
+            const AccountState* b = live_risk->get_accounts().find(account);
+            assert(a->position == b->position && a->open_buy == b->open_buy && a->open_sell == b->open_sell);
+            assert(a->open_orders == b->open_orders);
+        }
+    };
+    
+    auto recovered_risk = make_risk();
+    auto recovered = std::make_unique<MatchingEngine>();
+    recovered->attach_risk(recovered_risk.get());
+    recovery = recover(*recovered, snapshot_path, journal_path);
+    assert(recovery.ok && recovery.from_snapshot && recovered_risk->get_total_rejects() == 0);
+    same_state(*recovered, recovered_risk.get());
+    
+    // The journal alone, replayed with no stage at all, still gives the live books
+    auto unguarded = std::make_unique<MatchingEngine>();
+    unguarded->register_symbol(1);
+    unguarded->register_symbol(2);
+    assert(recover(*unguarded, "", journal_path).ok);
+    same_state(*unguarded, nullptr);
+    
+    std::filesystem::remove(journal_path);
+    std::filesystem::remove(snapshot_path);
+    std::cout << "✓ PASSED\n";
+}
+
+void test_wire_gateway() {
+    std::cout << "Testing wire protocol gateway... ";
+    
+    // Codec round trip, and per-message validation
+    char wire_buffer[64];
+    OrderRequest modify(OrderRequest::Type::Modify, Order(7, 3, Price(0.0), 0, Side::Buy, OrderType::Limit, 0));
+    modify.new_quantity = 250;
+    size_t length = wire::encode(modify, wire_buffer);
+    OrderRequest decoded;
+    size_t consumed = 0;
+    assert(wire::decode(wire_buffer, length - 1, decoded, consumed, 0) == wire::DecodeStatus::Incomplete);
+    assert(wire::decode(wire_buffer, length, decoded, consumed, 0) == wire::DecodeStatus::Ok);
+    assert(consumed == wire::modify::SIZE && decoded.type == OrderRequest::Type::Modify);
+    assert(decoded.order.id == 7 && decoded.order.symbol == 3 && decoded.new_quantity == 250);
+    OrderRequest replace(OrderRequest::Type::Replace, Order(8, 3, Price(101.25), 0, Side::Buy, OrderType::Limit, 0));
+    replace.new_quantity = 40;
+    length = wire::encode(replace, wire_buffer);
+    assert(wire::decode(wire_buffer, length, decoded, consumed, 0) == wire::DecodeStatus::Ok);
+    assert(consumed == wire::replace::SIZE && decoded.type == OrderRequest::Type::Replace);
+    assert(decoded.order.id == 8 && decoded.order.price == Price(101.25) && decoded.new_quantity == 40);
+
+#if defined(__linux__)
+    for (GatewayConfig::Backend backend : {GatewayConfig::Backend::Socket, GatewayConfig::Backend::IoUring}) {
+        PreTradeRisk<AccountLimitsCheck> risk(RiskLimits{}, 8, 1024, 8);
+        auto engine = std::make_unique<MatchingEngine>();
+        engine->register_symbol(1);
+        engine->attach_risk(&risk);
+        
+        // TCP: one stream split mid-message, with a bad side in the middle. Every
+        // message claims account 3; the gateway trades them for the bound account 5.
+        std::string stream;
+        for (OrderId id = 1; id <= 100; ++id) {
+            Order order(id, 1, Price(100.00 + static_cast<double>(id % 5) * 0.01), 10, 
+                        id % 2 ? Side::Buy : Side::Sell, OrderType::Limit, 0);
+            OrderRequest request(OrderRequest::Type::Add, order);
+            request.account = 3;
+            length = wire::encode(request, wire_buffer);
+            if (id == 50) wire_buffer[wire::enter::SIDE] = 'Z';
+            stream.append(wire_buffer, length);
+        }
+        
+        GatewayConfig tcp_config;
+        tcp_config.backend = backend;
+        tcp_config.bind_address = "127.0.0.1";
+        tcp_config.port = 0;
+        tcp_config.peer_accounts = {PeerAccount{0x7f000001, 5}};
+        Gateway tcp(*engine, tcp_config);
+        if (!tcp.open()) {
+            assert(backend == GatewayConfig::Backend::IoUring);  // Kernel without io_uring support
+            continue;
+        }
+        assert(tcp.local_port() != 0);
+        
+        int client = ::socket(AF_INET, SOCK_STREAM, 0);
+        sockaddr_in addr{};
+        addr.sin_family = AF_INET;
+        addr.sin_port = htons(tcp.local_port());
+        inet_pton(AF_INET, "127.0.0.1", &addr.sin_addr);
+        assert(::connect(client, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) == 0);
+        
+        for (size_t offset = 0; offset < stream.size(); offset += 77) {
+            size_t chunk = std::min<size_t>(77, stream.size() - offset);
+            assert(::send(client, stream.data() + offset, chunk, 0) == static_cast<ssize_t>(chunk));
+            tcp.poll();
+        }
+        for (int spin = 0; spin < 100000 && tcp.get_message_count() < 99; ++spin) {
+            tcp.poll();
+        }
+        assert(tcp.get_message_count() == 99 && tcp.get_invalid_message_count() == 1);
+        assert(tcp.get_connection_count() == 1);
+        
+        engine->process_orders();
+        MatchResult result;
+        OrderId expected_id = 1;
+        size_t results = 0;
+        while (engine->get_result(result)) {
+            if (expected_id == 50) ++expected_id;
+            assert(result.order_id == expected_id++);
+            ++results;
+        }
+        assert(results == 99);
+        assert(risk.get_accounts().find(5)->open_orders == engine->get_order_book(1)->get_order_count());
+        assert(risk.get_accounts().find(3)->open_orders == 0 && risk.get_accounts().find(3)->position == 0);
+        
+        // A broken length field drops the client rather than guessing a boundary
+        char garbage[3] = {1, 0, 'O'};
+        ::send(client, garbage, sizeof(garbage), 0);
+        for (int spin = 0; spin < 100000 && tcp.get_connection_count() == 1; ++spin) {
+            tcp.poll();
+        }
+        assert(tcp.get_protocol_error_count() == 1 && tcp.get_connection_count() == 0);
+        ::close(client);
+        tcp.close();
+        
+        // UDP: several whole messages per datagram
+        GatewayConfig udp_config = tcp_config;
+        udp_config.transport = GatewayConfig::Transport::Udp;
+        Gateway udp(*engine, udp_config);
+        assert(udp.open());
+        addr.sin_port = htons(udp.local_port());
+        
+        int sender = ::socket(AF_INET, SOCK_DGRAM, 0);
+        for (OrderId base = 1000; base < 1010; ++base) {
+            std::string datagram;
+            for (OrderId id = base * 10; id < base * 10 + 3; ++id) {
+                Order cancel(id, 1, Price(0.0), 0, Side::Buy, OrderType::Limit, 0);
+                length = wire::encode(OrderRequest(OrderRequest::Type::Cancel, cancel), wire_buffer);
+                datagram.append(wire_buffer, length);
+            }
+            ::sendto(sender, datagram.data(), datagram.size(), 0, reinterpret_cast<sockaddr*>(&addr), sizeof(addr));
+        }
+        
+        // Each datagram trades for its own sender: 127.0.0.1 is bound to account 5,
+        // 127.0.0.2 to nothing
+        int stranger = ::socket(AF_INET, SOCK_DGRAM, 0);
+        sockaddr_in stranger_addr{};
+        stranger_addr.sin_family = AF_INET;
+        inet_pton(AF_INET, "127.0.0.2", &stranger_addr.sin_addr);
+        assert(::bind(stranger, reinterpret_cast<sockaddr*>(&stranger_addr), sizeof(stranger_addr)) == 0);
+        for (int from : {sender, stranger}) {
+            OrderRequest add(OrderRequest::Type::Add, Order(from == sender ? 20000 : 20001, 1, Price(90.00), 1,
+                                                            Side::Buy, OrderType::Limit, 0));
+            add.account = 3;
+            length = wire::encode(add, wire_buffer);
+            ::sendto(from, wire_buffer, length, 0, reinterpret_cast<sockaddr*>(&addr), sizeof(addr));
+            for (int spin = 0; spin < 100000 && udp.get_message_count() < (from == sender ? 31u : 32u); ++spin) {
+                udp.poll();
+            }
+        }
+        assert(udp.get_message_count() == 32 && udp.get_protocol_error_count() == 0);
+        
+        size_t open_before = risk.get_accounts().find(5)->open_orders;
+        engine->process_orders();
+        results = 0;
+        while (engine->get_result(result)) {
+            // Cancels of unknown order IDs, and the stranger's unbound add
+            assert(result.status == (result.order_id == 20000 ? MatchResult::Status::Added
+                                                              : MatchResult::Status::Rejected));
+            ++results;
+        }
+        assert(results == 32);
+        assert(risk.get_accounts().find(5)->open_orders == open_before + 1);
+        assert(risk.get_reject_count(RiskReject::UnknownAccount) == 1);
+        assert(risk.get_accounts().find(3)->open_orders == 0);
+        ::close(stranger);
+        ::close(sender);
+    }
+#endif
+    
+    std::cout << "✓ PASSED\n";
+}
+
+void test_shm_gateway() {
+    std::cout << "Testing shared-memory order lanes... ";
+
+#if defined(__linux__)
+    using Status = MatchResult::Status;
+    PreTradeRisk<AccountLimitsCheck> risk(RiskLimits{}, 16, 4096, 8);
+    auto engine = std::make_unique<MatchingEngine>();
+    engine->register_symbol(1);
+    engine->attach_risk(&risk);
+    ShmConfig config;
+    config.name = "/nanotrader_test_" + std::to_string(getpid());
+    config.lanes = 2;
+    config.lane_accounts = {7, 8};
+    ShmGateway gateway(*engine, config);
+    assert(gateway.open());
+    auto pump = [&] {
+        // Lanes get max_requests_per_lane per poll
+        for (int i = 0; i < 4; ++i) {
+            gateway.poll();
+            engine->process_orders();
+        }
+        gateway.poll();
+    };
+    
+    // Missing segments and other layouts are refused
+    ShmClient probe;
+    assert(!probe.connect(config.name + "_missing"));
+    int fd = shm_open(config.name.c_str(), O_RDWR, 0);
+    auto* header = static_cast<shm::SegmentHeader*>(
+        mmap(nullptr, sizeof(shm::SegmentHeader), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0));
+    ::close(fd);
+    ++header->version;
+    assert(!probe.connect(config.name));
+    --header->version;
+    munmap(header, sizeof(shm::SegmentHeader));
+    
+    ShmClient maker;
+    assert(maker.connect(config.name) && maker.lane_index() == 0);
+    for (OrderId id = 1; id <= 100; ++id) {
+        OrderRequest request(OrderRequest::Type::Add,
+            Order(id, 1, Price(100.00 + static_cast<double>(id % 10) * 0.01), 10, Side::Sell, OrderType::Limit, 0));
+        request.account = 3;  // Not carried; lane 0 trades for account 7
+        assert(maker.submit(request));
+    }
+    OrderRequest garbage(static_cast<OrderRequest::Type>(9), Order(101, 1, Price(100.0), 1, Side::Buy, OrderType::Limit, 0));
+    assert(maker.submit(garbage));
+    pump();
+    assert(gateway.get_invalid_request_count() == 1 && engine->get_order_book(1)->get_order_count() == 100);
+    MatchResult result;
+    for (OrderId id = 1; id <= 100; ++id) {
+        assert(maker.get_result(result) && result.order_id == id && result.status == Status::Added);
+    }
+    assert(!maker.get_result(result));
+    
+    // Another process sweeps the book through its own lane, and gets every trade back
+    pid_t child = fork();
+    if (child == 0) {
+        ShmClient taker;
+        if (!taker.connect(config.name) || taker.lane_index() != 1) {
+            _exit(1);
+        }
+        if (!taker.submit(OrderRequest(OrderRequest::Type::Add,
+                Order(1000, 1, Price(100.09), 1000, Side::Buy, OrderType::Limit, 0)))) {
+            _exit(2);
+        }
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+        while (!taker.get_result(result)) {
+            if (std::chrono::steady_clock::now() > deadline) {
+                _exit(3);
+            }
+        }
+        bool ok = result.status == Status::Matched && result.trades.size() == 100 &&
+                  result.trades[0].maker_order_id == 10 && result.trades[0].price == Price(100.00) &&
+                  result.trades[99].taker_order_id == 1000;
+        taker.disconnect();
+        _exit(ok ? 0 : 4);
+    }
+    int status = -1;
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    while (waitpid(child, &status, WNOHANG) == 0 && std::chrono::steady_clock::now() < deadline) {
+        pump();
+    }
+    assert(WIFEXITED(status) && WEXITSTATUS(status) == 0);
+    assert(engine->get_order_book(1)->get_order_count() == 0);
+    assert(risk.get_accounts().find(7)->position == -1000 && risk.get_accounts().find(8)->position == 1000);
+    assert(risk.get_accounts().find(3)->open_orders == 0);
+    
+    // The released lane is reset and reusable; a client leaving with a result owed loses it
+    pump();
+    ShmClient second;
+    assert(second.connect(config.name) && second.lane_index() == 1);
+    assert(!probe.connect(config.name));  // Both lanes taken
+    assert(!probe.connect(config.name, 0));
+    assert(second.submit(OrderRequest(OrderRequest::Type::Cancel,
+        Order(5, 1, Price{}, 0, Side::Buy, OrderType::Limit, 0))));
+    gateway.poll();
+    second.disconnect();
+    pump();
+    pump();
+    assert(gateway.get_discarded_result_count() == 1 && gateway.get_client_count() == 1);
+    assert(probe.connect(config.name, 1) && probe.lane_index() == 1);
+    
+    // A client that stops reading only gets what its report ring can hold; nothing is lost
+    size_t submitted = 0;
+    for (int round = 0; round < 8; ++round) {
+        while (maker.submit(OrderRequest(OrderRequest::Type::Cancel,
+                   Order(10000 + submitted, 1, Price{}, 0, Side::Buy, OrderType::Limit, 0)))) {
+            ++submitted;
+        }
+        while (gateway.poll() > 0) {
+            engine->process_orders();
+        }
+    }
+    assert(submitted == (shm::REPORT_SLOTS - 1) + (shm::REQUEST_SLOTS - 1));
+    assert(gateway.get_report_stall_count() == 0);
+    size_t received = 0;
+    for (int spin = 0; spin < 1000 && received < submitted; ++spin) {
+        while (maker.get_result(result)) {
+            assert(result.status == Status::Rejected && result.order_id == 10000 + received);
+            ++received;
+        }
+        pump();
+    }
+    assert(received == submitted);
+    
+    // Sweeps report more records than they were admitted against; a lane that
+    // stops reading them has them held on the host while the other lane moves on
+    OrderId sweep_id = 20000;
+    OrderId swept_until = sweep_id;  // End of the last complete round
+    bool ring_full = false;
+    for (int round = 0; round < 600 && !ring_full; ++round) {
+        for (int i = 0; i <= 8 && !ring_full; ++i) {
+            bool buy = i == 8;
+            ring_full = !maker.submit(OrderRequest(OrderRequest::Type::Add, Order(sweep_id, 1, Price(200.00),
+                buy ? 8 : 1, buy ? Side::Buy : Side::Sell, OrderType::Limit, 0)));
+            sweep_id += !ring_full;
+        }
+        if (!ring_full) {
+            swept_until = sweep_id;
+        }
+        pump();
+    }
+    assert(gateway.get_report_stall_count() > 0);
+    assert(probe.submit(OrderRequest(OrderRequest::Type::Cancel,
+        Order(30000, 1, Price{}, 0, Side::Buy, OrderType::Limit, 0))));
+    pump();
+    assert(probe.get_result(result) && result.order_id == 30000 && result.status == Status::Rejected);
+    
+    // Once the stalled client reads again, its results come through in order
+    OrderId expected = 20000;
+    for (int spin = 0; spin < 10000 && expected < sweep_id; ++spin) {
+        while (maker.get_result(result)) {
+            assert(result.order_id == expected);
+            assert(expected >= swept_until || result.trades.size() == ((expected - 20000) % 9 == 8 ? 8u : 0u));
+            ++expected;
+        }
+        pump();
+    }
+    assert(expected == sweep_id);
+    
+    // A client process that exits without disconnecting has its lane reclaimed
+    probe.disconnect();
+    pump();
+    child = fork();
+    if (child == 0) {
+        ShmClient orphan;
+        if (!orphan.connect(config.name) || orphan.lane_index() != 1) {
+            _exit(1);
+        }
+        orphan.submit(OrderRequest(OrderRequest::Type::Cancel,
+            Order(30001, 1, Price{}, 0, Side::Buy, OrderType::Limit, 0)));
+        _exit(0);
+    }
+    assert(waitpid(child, &status, 0) == child && WIFEXITED(status) && WEXITSTATUS(status) == 0);
+    for (size_t i = 0; i < config.liveness_check_polls && gateway.get_abandoned_lane_count() == 0; ++i) {
+        gateway.poll();
+        engine->process_orders();
+    }
+    pump();
+    assert(gateway.get_abandoned_lane_count() == 1 && gateway.get_client_count() == 1);
+    assert(probe.connect(config.name) && probe.lane_index() == 1);
+    
+    gateway.close();
+    ShmClient late;
+    assert(!late.connect(config.name));
+#endif
+    
+    std::cout << "✓ PASSED\n";
+}
+
+void test_market_data() {
+    std::cout << "Testing market data feed... ";
+    
+    auto engine = std::make_unique<MatchingEngine>();
+    auto feed = std::make_unique<MarketDataPublisher>(512);
+    BookConfig ladder;
+    ladder.backend = BookConfig::Backend::Ladder;
+    engine->register_symbol(1);
+    engine->attach_market_data(feed.get());
+    engine->register_symbol(2, ladder);  // Registered after attaching
+    
+    MarketDepth depth;
+    auto drain = [&] {
+        MarketDataMessage message;
+        while (feed->poll(message)) {
+            depth.apply(message);
+        }
+    };
+    auto matches_book = [&](Symbol symbol) {
+        const OrderBook* book = engine->get_order_book(symbol);
+        return depth.get_levels(symbol, Side::Buy, 1000) == book->get_bid_levels(1000) &&
+               depth.get_levels(symbol, Side::Sell, 1000) == book->get_ask_levels(1000);
+    };
+    
+    // Adds, crosses, cancels and modifies: depth rebuilt from the feed tracks both books
+    std::mt19937_64 rng(18);
+    OrderId next_id = 1;
+    MatchResult result;
+    for (int round = 0; round < 200; ++round) {
+        for (int i = 0; i < 32; ++i) {
+            Symbol symbol = static_cast<Symbol>(1 + rng() % 2);
+            Side side = rng() % 2 ? Side::Buy : Side::Sell;
+            uint64_t action = rng() % 10;
+            OrderRequest request;
+            if (action < 6 || next_id < 10) {
+                Price price{static_cast<int64_t>(99'800'000 + (rng() % 41) * 10'000)};
+                request = OrderRequest(OrderRequest::Type::Add, 
+                                       Order(next_id++, symbol, price, 1 + rng() % 100, side, OrderType::Limit, 0));
+            } else {
+                OrderId id = 1 + rng() % (next_id - 1);
+                request = OrderRequest(action < 8 ? OrderRequest::Type::Cancel : OrderRequest::Type::Modify, 
+                                       Order(id, symbol, Price{}, 0, side, OrderType::Limit, 0));
+                request.new_quantity = 1 + rng() % 50;
+            }
+            assert(engine->submit_order(request));
+        }
+        engine->process_orders();
+        while (engine->get_result(result)) {}
+        drain();
+    }
+    assert(feed->get_dropped_count() == 0 && depth.get_gap_count() == 0);
+    assert(feed->get_snapshot_count() > 2);  // Initial resync plus periodic ones
+    assert(depth.is_synced(1) && depth.is_synced(2));
+    assert(matches_book(1) && matches_book(2));
+    
+    // A consumer that falls behind loses messages, sees the gap, and is resynced
+    for (int i = 0; i < 70000; ++i) {
+        Price price{static_cast<int64_t>(98'000'000 + (i % 150) * 10'000)};
+        engine->apply(OrderRequest(OrderRequest::Type::Add, 
+                                   Order(next_id++, 1, price, 1, Side::Buy, OrderType::Limit, 0)));
+    }
+    assert(feed->get_dropped_count() > 0);
+    for (int i = 0; i < 4; ++i) {
+        drain();
+        engine->process_orders();  // Idle calls still flush owed snapshots
+    }
+    drain();
+    assert(depth.get_gap_count() == 1);
+    assert(depth.is_synced(1) && depth.is_synced(2));
+    assert(matches_book(1) && matches_book(2));
+    
+    // A book deeper than the whole channel is skipped and counted, and the resync
+    // still reaches the books after it
+    engine->register_symbol(3);
+    for (size_t i = 0; i < MarketDataPublisher::CHANNEL_SIZE; ++i) {
+        Price price{static_cast<int64_t>(1'000'000 + i * 10'000)};
+        engine->apply(OrderRequest(OrderRequest::Type::Add, 
+                                   Order(next_id++, 3, price, 1, Side::Sell, OrderType::Limit, 0)));
+    }
+    feed->request_resync();
+    for (int i = 0; i < 8; ++i) {
+        drain();
+        engine->process_orders();
+    }
+    drain();
+    assert(feed->get_oversized_count() > 0);
+    assert(depth.is_synced(1) && depth.is_synced(2) && !depth.is_synced(3));
+    assert(matches_book(1) && matches_book(2));
+    
+    engine->clear_all_books();
+    drain();
+    assert(depth.is_synced(1) && depth.get_levels(1, Side::Buy, 10).empty());
+    assert(feed->get_last_sequence() == feed->get_published_count() + feed->get_dropped_count());
+    
+    std::cout << "✓ PASSED\n";
+}
+
+void test_top_of_book() {
+    std::cout << "Testing top-of-book feed... ";
+    
+    auto engine = std::make_unique<MatchingEngine>();
+    auto feed = std::make_unique<TopOfBookFeed>(4, 16);
+    BookConfig ladder;
+    ladder.backend = BookConfig::Backend::Ladder;
+    engine->register_symbol(1);
+    engine->attach_top_of_book(feed.get());
+    engine->register_symbol(2, ladder);  // Registered after attaching
+    
+    TopOfBook top;
+    assert(feed->read(1, top) && feed->read(2, top) && !feed->read(3, top) && !feed->read(99, top));
+    assert(top.bid_count == 0 && top.ask_count == 0);
+    
+    auto matches_book = [&](Symbol symbol) {
+        TopOfBook snapshot;
+        assert(feed->read(symbol, snapshot));
+        const OrderBook* book = engine->get_order_book(symbol);
+        for (Side side : {Side::Buy, Side::Sell}) {
+            auto levels = side == Side::Buy ? book->get_bid_levels(TopOfBook::DEPTH) 
+                                            : book->get_ask_levels(TopOfBook::DEPTH);
+            uint32_t count = side == Side::Buy ? snapshot.bid_count : snapshot.ask_count;
+            const auto& quoted = side == Side::Buy ? snapshot.bids : snapshot.asks;
+            if (count != levels.size()) {
+                return false;
+            }
+            for (size_t i = 0; i < levels.size(); ++i) {
+                if (quoted[i].price != levels[i].first || quoted[i].quantity != levels[i].second) {
+                    return false;
+                }
+            }
+        }
+        return true;
+    };
+    
+    // Readers spinning on the feed never see a torn or crossed snapshot
+    std::atomic<bool> done{false};
+    std::atomic<uint64_t> reads{0};
+    std::thread reader([&] {
+        uint64_t last_version = 0;
+        TopOfBook snapshot;
+        while (!done.load(std::memory_order_acquire)) {
+            bool ok = feed->read(1, snapshot);
+            assert(ok && snapshot.symbol == 1 && snapshot.version >= last_version);
+            assert(snapshot.bid_count <= TopOfBook::DEPTH && snapshot.ask_count <= TopOfBook::DEPTH);
+            for (uint32_t i = 1; i < snapshot.bid_count; ++i) {
+                assert(snapshot.bids[i].price < snapshot.bids[i - 1].price);
+            }
+            for (uint32_t i = 1; i < snapshot.ask_count; ++i) {
+                assert(snapshot.asks[i].price > snapshot.asks[i - 1].price);
+            }
+            assert(!snapshot.has_bid() || !snapshot.has_ask() || snapshot.best_bid() < snapshot.best_ask());
+            last_version = snapshot.version;
+            reads.fetch_add(1, std::memory_order_relaxed);
+        }
+    });
+    while (reads.load(std::memory_order_relaxed) == 0) {
+        std::this_thread::yield();
+    }
+    
+    std::mt19937_64 rng(19);
+    OrderId next_id = 1;
+    MatchResult result;
+    for (int round = 0; round < 300; ++round) {
+        for (int i = 0; i < 32; ++i) {
+            Symbol symbol = static_cast<Symbol>(1 + rng() % 2);
+            Side side = rng() % 2 ? Side::Buy : Side::Sell;
+            uint64_t action = rng() % 10;
+            OrderRequest request;
+            if (action < 6 || next_id < 10) {
+                Price price{static_cast<int64_t>(99'800'000 + (rng() % 41) * 10'000)};
+                request = OrderRequest(OrderRequest::Type::Add, 
+                                       Order(next_id++, symbol, price, 1 + rng() % 100, side, OrderType::Limit, 0));
+            } else {
+                OrderId id = 1 + rng() % (next_id - 1);
+                request = OrderRequest(action < 8 ? OrderRequest::Type::Cancel : OrderRequest::Type::Modify, 
+                                       Order(id, symbol, Price{}, 0, side, OrderType::Limit, 0));
+                request.new_quantity = 1 + rng() % 50;
+            }
+            assert(engine->submit_order(request));
+        }
+        engine->process_orders();
+        while (engine->get_result(result)) {}
+        assert(matches_book(1) && matches_book(2));
+    }
+    done.store(true, std::memory_order_release);
+    reader.join();
+    
+    // Changes below the published depth don't bump the version
+    TopOfBook before;
+    assert(feed->read(2, before) && before.bid_count == TopOfBook::DEPTH);
+    Price deep{before.bids[TopOfBook::DEPTH - 1].price.raw_value() - 10'000};
+    engine->apply(OrderRequest(OrderRequest::Type::Add, 
+                               Order(next_id++, 2, deep, 5, Side::Buy, OrderType::Limit, 0)));
+    assert(feed->get_version(2) == before.version);
+    
+    engine->clear_all_books();
+    assert(feed->read(1, top) && top.bid_count == 0 && top.ask_count == 0);
+    assert(feed->get_version(1) > 0 && feed->get_book_count() == 2);
+    
+    std::cout << "✓ PASSED\n";
+}
+
+void test_pre_trade_risk() {
+    std::cout << "Testing pre-trade risk checks... ";
+    
+    using FullRisk = PreTradeRisk<MaxOrderSizeCheck, PriceBandCheck, FatFingerCheck, AccountLimitsCheck>;
+    static_assert(FullRisk::USES_ACCOUNTS && FullRisk::USES_REFERENCE);
+    static_assert(!PreTradeRisk<MaxOrderSizeCheck, FatFingerCheck>::USES_ACCOUNTS);
+    static_assert(!PreTradeRisk<>::USES_REFERENCE);
+    
+    RiskLimits limits;
+    limits.max_order_quantity = 1000;
+    limits.max_order_notional = 200000.0;
+    limits.price_band_bps = 500;
+    limits.fat_finger_bps = 100;
+    limits.max_market_quantity = 500;
+    auto risk = std::make_unique<FullRisk>(limits, 16, 1024, 16);
+    assert(risk->get_accounts().set_limits(7, AccountLimits{300, 3}));
+    
+    auto engine = std::make_unique<MatchingEngine>();
+    engine->register_symbol(1);
+    engine->attach_risk(risk.get());
+    
+    OrderId next_id = 1;
+    auto add = [&](AccountId account, Side side, double price, Quantity quantity, 
+                   OrderType type = OrderType::Limit) {
+        OrderRequest request(OrderRequest::Type::Add, 
+                             Order(next_id++, 1, Price(price), quantity, side, type, 0));
+        request.account = account;
+        return engine->apply(request).status;
+    };
+    using Status = MatchResult::Status;
+    
+    // Size and notional
+    assert(add(1, Side::Buy, 100.0, 1001) == Status::Rejected);
+    assert(add(1, Side::Buy, 300.0, 900) == Status::Rejected);
+    assert(risk->get_reject_count(RiskReject::OrderQuantity) == 1);
+    assert(risk->get_reject_count(RiskReject::OrderNotional) == 1);
+    
+    // Bands around the mid until something trades, and the fat-finger collar
+    assert(add(1, Side::Sell, 100.0, 100) == Status::Added);
+    assert(add(2, Side::Buy, 99.0, 100) == Status::Added);
+    assert(add(3, Side::Buy, 110.0, 10) == Status::Rejected);
+    assert(risk->get_reject_count(RiskReject::PriceBand) == 1);
+    assert(add(3, Side::Buy, 102.0, 10) == Status::Rejected);
+    assert(add(3, Side::Buy, 1.0, 600, OrderType::Market) == Status::Rejected);
+    assert(risk->get_reject_count(RiskReject::FatFinger) == 2);
+    assert(add(99, Side::Buy, 99.0, 1) == Status::Rejected);
+    assert(risk->get_reject_count(RiskReject::UnknownAccount) == 1);
+    
+    // Worst-case position counts resting quantity; open orders are capped
+    OrderId first = next_id;
+    assert(add(7, Side::Buy, 99.5, 100) == Status::Added);
+    OrderId second = next_id;
+    assert(add(7, Side::Buy, 99.4, 150) == Status::Added);
+    assert(add(7, Side::Buy, 99.3, 60) == Status::Rejected);
+    OrderId third = next_id;
+    assert(add(7, Side::Buy, 99.3, 50) == Status::Added);
+    assert(add(7, Side::Sell, 99.9, 1) == Status::Rejected);
+    assert(risk->get_reject_count(RiskReject::Position) == 1);
+    assert(risk->get_reject_count(RiskReject::OpenOrders) == 1);
+    
+    // Fills move both sides' positions and free open-order slots
+    assert(add(8, Side::Sell, 99.5, 100) == Status::Matched);
+    const AccountState* state = risk->get_accounts().find(7);
+    assert(state->position == 100 && state->open_buy == 200 && state->open_orders == 2);
+    assert(risk->get_accounts().find(8)->position == -100);
+    assert(risk->get_accounts().find(8)->open_orders == 0);
+    assert(!engine->get_order_book(1)->get_order(first));
+    
+    // Cancels and modifies, with growth checked against the limit
+    OrderRequest cancel(OrderRequest::Type::Cancel, Order(second, 1, Price{}, 0, Side::Buy, OrderType::Limit, 0));
+    cancel.account = 7;
+    assert(engine->apply(cancel).status == Status::Cancelled);
+    assert(state->open_buy == 50 && state->open_orders == 1);
+    OrderRequest modify(OrderRequest::Type::Modify, Order(third, 1, Price{}, 0, Side::Buy, OrderType::Limit, 0));
+    modify.account = 7;
+    modify.new_quantity = 400;
+    assert(engine->apply(modify).status == Status::Rejected);
+    modify.new_quantity = 150;
+    assert(engine->apply(modify).status == Status::Modified);
+    assert(state->open_buy == 150 && state->open_orders == 1);
+    
+    // A replace has its new price checked like an add
+    OrderRequest replace(OrderRequest::Type::Replace, Order(third, 1, Price(101.5), 0, Side::Buy, OrderType::Limit, 0));
+    replace.account = 7;
+    replace.new_quantity = 150;
+    assert(engine->apply(replace).status == Status::Rejected);
+    assert(risk->get_reject_count(RiskReject::FatFinger) == 3);
+    replace.order.price = Price(99.2);
+    assert(engine->apply(replace).status == Status::Modified);
+    assert(state->open_buy == 150 && state->open_orders == 1);
+    
+    // Another account can't cancel or amend the order, whatever it knows of the ID
+    cancel.order.id = third;
+    for (OrderRequest request : {cancel, modify, replace}) {
+        request.account = 8;
+        assert(engine->apply(request).status == Status::Rejected);
+    }
+    assert(risk->get_reject_count(RiskReject::NotOwner) == 3);
+    const Order* kept = engine->get_order_book(1)->get_order(third);
+    assert(kept && kept->price == Price(99.2) && kept->remaining_quantity == 150);
+    assert(state->open_buy == 150 && state->open_orders == 1);
+    
+    // The band now centres on the last trade (99.5)
+    assert(add(3, Side::Sell, 94.0, 1) == Status::Rejected);
+    assert(risk->get_reject_count(RiskReject::PriceBand) == 2);
+    assert(add(3, Side::Sell, 99.4, 1) == Status::Added);
+    assert(risk->get_total_rejects() == 14);
+    
+    engine->clear_all_books();
+    assert(state->open_orders == 0 && state->open_buy == 0 && state->position == 100);
+    assert(risk->get_accounts().open_order_count() == 0);
+    
+    // Account limits span symbols, so a batch is judged in submission order, as apply() does
+    std::unique_ptr<MatchingEngine> engines[2];
+    std::unique_ptr<PreTradeRisk<AccountLimitsCheck>> stages[2];
+    for (size_t i = 0; i < 2; ++i) {
+        engines[i] = std::make_unique<MatchingEngine>();
+        engines[i]->register_symbol(1);
+        engines[i]->register_symbol(2);
+        stages[i] = std::make_unique<PreTradeRisk<AccountLimitsCheck>>(RiskLimits{}, 16, 64, 16);
+        stages[i]->get_accounts().set_limits(1, AccountLimits{100, 10});
+        engines[i]->attach_risk(stages[i].get());
+    }
+    OrderRequest spanning[2] = {
+        OrderRequest(OrderRequest::Type::Add, Order(1, 2, Price(10.0), 100, Side::Buy, OrderType::Limit, 0)),
+        OrderRequest(OrderRequest::Type::Add, Order(2, 1, Price(10.0), 50, Side::Buy, OrderType::Limit, 0))};
+    for (OrderRequest& request : spanning) {
+        request.account = 1;
+        engines[0]->apply(request);
+        assert(engines[1]->submit_order(request));
+    }
+    assert(engines[1]->process_batch() == 2);
+    for (auto& batched : engines) {
+        assert(batched->get_order_book(2)->get_order(1) && !batched->get_order_book(1)->get_order(2));
+    }
+    
+    // The account makes it through the journal and the wire
+    OrderRequest owned(OrderRequest::Type::Add, Order(5, 1, Price(10.0), 3, Side::Sell, OrderType::Limit, 0));
+    owned.account = 42;
+    assert(JournalRecord::from_request(owned, 1).to_request().account == 42);
+    char wire_buffer[wire::enter::SIZE];
+    OrderRequest decoded;
+    size_t consumed = 0;
+    assert(wire::decode(wire_buffer, wire::encode(owned, wire_buffer), decoded, consumed, 0) == wire::DecodeStatus::Ok);
+    assert(decoded.account == 42 && consumed == wire::enter::SIZE);
+    
+    std::cout << "✓ PASSED\n";
+}
+
+void test_telemetry() {
+    std::cout << "Testing latency histograms and metrics export... ";
+    
+    using telemetry::HistogramLayout;
+    
+    // Exact below 64, then every bucket is within 1/32 of the values it holds
+    for (uint64_t v = 0; v < 64; ++v) {
+        assert(HistogramLayout::index_of(v) == v && HistogramLayout::upper_bound(v) == v);
+    }
+    size_t previous = 0;
+    for (uint64_t v = 64; v < (uint64_t{1} << 20); v += v / 17 + 1) {
+        size_t index = HistogramLayout::index_of(v);
+        assert(index >= previous && index < HistogramLayout::BUCKET_COUNT);
+        uint64_t bound = HistogramLayout::upper_bound(index);
+        assert(bound >= v && bound - v <= v / 32);
+        previous = index;
+    }
+    assert(HistogramLayout::index_of(UINT64_MAX) == HistogramLayout::BUCKET_COUNT - 1);
+    assert(HistogramLayout::upper_bound(HistogramLayout::BUCKET_COUNT - 1) == UINT64_MAX);
+    
+    // Quantiles over 1..1000, and merging a second histogram
+    auto metrics = std::make_unique<telemetry::EngineMetrics>();
+    for (uint64_t v = 1; v <= 1000; ++v) {
+        metrics->match_latency.record(v);
+    }
+    auto snapshot = std::make_unique<telemetry::HistogramSnapshot>();
+    metrics->match_latency.snapshot(*snapshot);
+    assert(snapshot->count() == 1000 && snapshot->sum() == 500500 && snapshot->max() == 1000);
+    uint64_t p50 = snapshot->value_at_quantile(0.5);
+    uint64_t p99 = snapshot->value_at_quantile(0.99);
+    assert(p50 >= 500 && p50 <= 500 + 500 / 32);
+    assert(p99 >= 990 && p99 <= 1000);
+    assert(snapshot->value_at_quantile(1.0) == 1000);
+    
+    metrics->queue_latency.record(5000);
+    auto other = std::make_unique<telemetry::HistogramSnapshot>();
+    metrics->queue_latency.snapshot(*other);
+    snapshot->merge(*other);
+    assert(snapshot->count() == 1001 && snapshot->max() == 5000);
+    assert(snapshot->value_at_quantile(1.0) == 5000);
+    
+    // Prometheus text; an uncalibrated clock converts one cycle to one ns
+    metrics->fills.add(3);
+    metrics->pool_in_use.set(42);
+    TscClock clock;
+    std::string text;
+    telemetry::MetricsExporter::render(*metrics, clock, "nt", text);
+    assert(text.find("# TYPE nt_match_latency_ns summary\n") != std::string::npos);
+    assert(text.find("nt_match_latency_ns{quantile=\"0.999\"} 1000\n") != std::string::npos);
+    assert(text.find("nt_match_latency_ns_count 1000\n") != std::string::npos);
+    assert(text.find("nt_queue_latency_max_ns 5000\n") != std::string::npos);
+    assert(text.find("nt_result_latency_ns_count 0\n") != std::string::npos);
+    assert(text.find("nt_fills_total 3\n") != std::string::npos);
+    assert(text.find("nt_order_pool_in_use 42\n") != std::string::npos);
+    
+    // The exporter replaces its file on every interval and once more on stop()
+    std::string path = (std::filesystem::temp_directory_path() / "nanotrader_test_metrics.prom").string();
+    std::filesystem::remove(path);
+    {
+        telemetry::MetricsExporter exporter(*metrics, clock, {path, std::chrono::milliseconds(1), "nt"});
+        assert(exporter.start() && exporter.is_running() && !exporter.start());
+        while (exporter.export_count() < 2) {
+            std::this_thread::yield();
+        }
+        metrics->fills.add(1);
+        exporter.stop();
+        assert(!exporter.is_running() && exporter.failure_count() == 0);
+    }
+    std::ifstream exported(path);
+    std::string contents((std::istreambuf_iterator<char>(exported)), std::istreambuf_iterator<char>());
+    assert(contents.find("nt_fills_total 4\n") != std::string::npos);
+    assert(!std::filesystem::exists(path + ".tmp"));
+    std::filesystem::remove(path);
+    
+    // Engine hooks exist only in profiling builds
+    auto engine = std::make_unique<MatchingEngine>();
+    engine->register_symbol(1);
+    if constexpr (telemetry::ENABLED) {
+        const telemetry::EngineMetrics* engine_metrics = engine->get_metrics();
+        assert(engine_metrics && engine_metrics->pool_in_use.get() == 0);
+        
+        // Two asks at different prices, a buy sweeping both, and a cancel of nothing
+        assert(engine->submit_order(OrderRequest(OrderRequest::Type::Add,
+            Order(1, 1, Price(100.0), 10, Side::Sell, OrderType::Limit, 0))));
+        assert(engine->submit_order(OrderRequest(OrderRequest::Type::Add,
+            Order(2, 1, Price(101.0), 10, Side::Sell, OrderType::Limit, 0))));
+        engine->process_orders();
+        assert(engine_metrics->pool_in_use.get() == 2);
+        
+        assert(engine->submit_order(OrderRequest(OrderRequest::Type::Add,
+            Order(3, 1, Price(101.0), 15, Side::Buy, OrderType::Limit, 0))));
+        assert(engine->submit_order(OrderRequest(OrderRequest::Type::Cancel,
+            Order(99, 1, Price(100.0), 0, Side::Buy, OrderType::Limit, 0))));
+        assert(engine->process_batch() == 2);
+        
+        MatchResult result;
+        size_t results = 0;
+        while (engine->get_result(result)) {
+            assert(result.ready_cycles != 0);
+            ++results;
+        }
+        assert(results == 4);
+        assert(engine_metrics->requests.get() == 4);
+        assert(engine_metrics->fills.get() == 2);
+        assert(engine_metrics->rejects.get() == 1);
+        assert(engine_metrics->levels_swept.get() == 2);
+        assert(engine_metrics->pool_in_use.get() == 1);
+        assert(engine_metrics->queue_latency.count() == 4);
+        assert(engine_metrics->match_latency.count() == 4);
+        assert(engine_metrics->result_latency.count() == 4);
+    } else {
+        assert(engine->get_metrics() == nullptr);
+    }
+    
+    std::cout << "✓ PASSED\n";
+}
+
 void test_ring_buffer() {
     std::cout << "Testing SPSC Ring Buffer... ";
     
@@ -198,6 +2237,56 @@ void test_ring_buffer() {
     assert(buffer.empty());
     assert(!buffer.try_pop(item));
     
+    // Batch push stops at capacity
+    int values[10] = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+    assert(buffer.try_push_batch(values, 10) == 7);
+    assert(buffer.full());
+    for (int i = 0; i < 7; ++i) {
+        assert(buffer.try_pop(item));
+        assert(item == i);
+    }
+    
+    std::cout << "✓ PASSED\n";
+}
+
+void test_mpsc_queue() {
+    std::cout << "Testing MPSC queue node recycling... ";
+    
+    // Fixed pool: producers must be fed by nodes the consumer recycles
+    PoolOptions options;
+    options.growable = false;
+    MPSCRingBuffer<uint64_t> queue(256, options);
+    size_t nodes = queue.available_nodes();
+    
+    constexpr uint64_t PRODUCERS = 4;
+    constexpr uint64_t PER_PRODUCER = 200000;
+    std::vector<std::thread> producers;
+    for (uint64_t p = 0; p < PRODUCERS; ++p) {
+        producers.emplace_back([&queue, p] {
+            for (uint64_t i = 0; i < PER_PRODUCER; ++i) {
+                while (!queue.push((p << 32) | i)) {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+    
+    // Each producer's messages arrive in the order it pushed them
+    std::vector<uint64_t> next(PRODUCERS, 0);
+    uint64_t value;
+    for (uint64_t received = 0; received < PRODUCERS * PER_PRODUCER;) {
+        if (queue.try_pop(value)) {
+            uint64_t p = value >> 32;
+            assert(p < PRODUCERS && (value & 0xFFFFFFFF) == next[p]);
+            ++next[p];
+            ++received;
+        }
+    }
+    
+    for (auto& producer : producers) producer.join();
+    assert(queue.empty() && !queue.try_pop(value));
+    assert(queue.available_nodes() == nodes);
+    
     std::cout << "✓ PASSED\n";
 }
 
@@ -211,10 +2300,34 @@ int main() {
         test_order_book_basic();
         test_order_book_removal();
         test_order_book_price_levels();
+        test_order_book_ladder();
+        test_level_bitmap();
+        test_order_index();
+        test_trade_buffer();
+        test_tsc_clock();
+        test_pool_policies();
+        test_book_sizing();
+        test_depth_queries();
+        test_matching_engine_sweep();
+        test_fill_or_kill();
+        test_order_amend();
+        test_matching_engine_batch();
+        test_backpressure();
+        test_sharded_engine();
+        test_engine_runner();
+        test_journal();
+        test_snapshot_recovery();
+        test_wire_gateway();
+        test_shm_gateway();
+        test_market_data();
+        test_top_of_book();
+        test_pre_trade_risk();
+        test_telemetry();
         test_ring_buffer();
+        test_mpsc_queue();
         
         std::cout << "\n🎉 All tests PASSED!\n";
-        
+    
     } catch (const std::exception& e) {
         std::cerr << "\n❌ Test FAILED: " << e.what() << "\n";
         return 1;
@@ -0,0 +1,216 @@
+// Replays a recorded journal through a MatchingEngine as fast as possible.
+// Reports throughput and per-message latency percentiles, and checks each
+// result's digest against the results sidecar the live engine wrote next to the
+// journal (JournalConfig::results_path), so output regressions on real order
+// flow are caught, not just slowdowns. --record writes the replay's own digests
+// in the same format, for comparing two builds.
+//
+//   journal_replay <journal> [--snapshot <file>] [--symbols <max>]
+//                  [--record <results>] [--verify <results>]
+
+#include "nanotrader/core/matching_engine.hpp"
+#include "nanotrader/core/tsc_clock.hpp"
+#include "nanotrader/persistence/journal.hpp"
+#include "nanotrader/persistence/snapshot.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace nanotrader;
+
+namespace {
+
+struct Options {
+    std::string journal_path;
+    std::string snapshot_path;
+    std::string record_path;
+    std::string verify_path;
+    Symbol max_symbol{0};  // 0 = register every symbol seen in the journal
+};
+
+// Same layout as the live results sidecar, so either can be passed to --verify
+bool write_digests(const std::string& path, const std::vector<ResultDigest>& digests) {
+    ResultDigestHeader header{};
+    std::memcpy(header.magic, ResultDigestHeader::MAGIC, sizeof(header.magic));
+    header.version = ResultDigestHeader::VERSION;
+    header.record_size = sizeof(ResultDigest);
+    
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    out.write(reinterpret_cast<const char*>(digests.data()), 
+              static_cast<std::streamsize>(digests.size() * sizeof(ResultDigest)));
+    return static_cast<bool>(out);
+}
+
+bool parse_args(int argc, char** argv, Options& options) {
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool has_value = i + 1 < argc;
+        
+        if (arg == "--snapshot" && has_value) {
+            options.snapshot_path = argv[++i];
+        } else if (arg == "--record" && has_value) {
+            options.record_path = argv[++i];
+        } else if (arg == "--verify" && has_value) {
+            options.verify_path = argv[++i];
+        } else if (arg == "--symbols" && has_value) {
+            options.max_symbol = static_cast<Symbol>(std::stoul(argv[++i]));
+        } else if (arg[0] != '-' && options.journal_path.empty()) {
+            options.journal_path = arg;
+        } else {
+            return false;
+        }
+    }
+    return !options.journal_path.empty();
+}
+
+double percentile(const std::vector<uint64_t>& sorted, double p) {
+    if (sorted.empty()) return 0.0;
+    size_t index = static_cast<size_t>(p / 100.0 * static_cast<double>(sorted.size() - 1));
+    return static_cast<double>(sorted[index]);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Options options;
+    if (!parse_args(argc, argv, options)) {
+        std::cerr << "usage: journal_replay <journal> [--snapshot <file>] [--symbols <max>]\n"
+                  << "                      [--record <results>] [--verify <results>]\n";
+        return 2;
+    }
+    
+    std::cout << "NanoTrader Journal Replay\n";
+    std::cout << "=========================\n";
+    
+    auto engine = std::make_unique<MatchingEngine>();
+    uint64_t start_after = 0;
+    
+    if (!options.snapshot_path.empty()) {
+        SnapshotReader snapshot(options.snapshot_path);
+        if (!snapshot.is_open() || !snapshot.restore(*engine)) {
+            std::cerr << "Cannot restore snapshot " << options.snapshot_path << "\n";
+            return 1;
+        }
+        start_after = snapshot.header().journal_sequence;
+        std::cout << "Snapshot: " << snapshot.header().book_count << " books, " 
+                  << snapshot.header().order_count << " orders, sequence " << start_after << "\n";
+    }
+    
+    // Load the tail up front so file I/O is not part of the measurement
+    JournalReader reader(options.journal_path);
+    if (!reader.is_open() || !reader.seek_after(start_after)) {
+        std::cerr << "Cannot read journal " << options.journal_path << "\n";
+        return 1;
+    }
+    
+    std::vector<JournalRecord> records;
+    JournalRecord record;
+    while (reader.next(record)) {
+        records.push_back(record);
+    }
+    if (reader.corrupt()) {
+        std::cout << "Warning: journal ends in a torn or corrupt record\n";
+    }
+    
+    if (options.max_symbol > 0) {
+        for (Symbol symbol = 1; symbol <= options.max_symbol; ++symbol) {
+            engine->register_symbol(symbol);
+        }
+    } else {
+        for (const JournalRecord& r : records) {
+            engine->register_symbol(r.symbol);
+        }
+    }
+    
+    std::cout << "Messages: " << records.size() << " (after sequence " << start_after << ")\n";
+    std::cout << "Books: " << engine->get_order_book_count() << "\n";
+    
+    const TscClock& clock = engine->get_clock();
+    std::vector<uint64_t> latencies(records.size());
+    std::vector<ResultDigest> digests(records.size());
+    uint64_t trades = 0;
+    
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < records.size(); ++i) {
+        OrderRequest request = records[i].to_request();
+        
+        uint64_t begin = TscClock::cycles();
+        MatchResult result = engine->replay(request);
+        latencies[i] = TscClock::cycles() - begin;
+        
+        digests[i] = ResultDigest{records[i].sequence, result_digest(result)};
+        trades += result.trades.size();
+    }
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    double seconds = std::chrono::duration<double>(elapsed).count();
+    
+    std::sort(latencies.begin(), latencies.end());
+    auto ns = [&clock](double cycles) {
+        return clock.cycles_to_ns(static_cast<uint64_t>(cycles));
+    };
+    
+    std::cout << "\nResults:\n";
+    std::cout << "Trades: " << trades << "\n";
+    std::cout << "Resting orders: " << engine->get_total_orders() << "\n";
+    std::cout << "Total time: " << seconds * 1e3 << " ms\n";
+    std::cout << "Throughput: " << static_cast<uint64_t>(records.size() / std::max(seconds, 1e-9)) 
+              << " msgs/sec\n";
+    std::cout << "Latency (ns): p50=" << ns(percentile(latencies, 50)) 
+              << " p90=" << ns(percentile(latencies, 90))
+              << " p99=" << ns(percentile(latencies, 99))
+              << " p99.9=" << ns(percentile(latencies, 99.9))
+              << " max=" << ns(latencies.empty() ? 0 : latencies.back()) << "\n";
+    
+    if (!options.record_path.empty()) {
+        if (!write_digests(options.record_path, digests)) {
+            std::cerr << "Cannot write digests to " << options.record_path << "\n";
+            return 1;
+        }
+        std::cout << "Recorded " << digests.size() << " result digests\n";
+    }
+    
+    if (!options.verify_path.empty()) {
+        std::vector<ResultDigest> expected;
+        if (!read_result_digests(options.verify_path, expected)) {
+            std::cerr << "Cannot read result digests from " << options.verify_path << "\n";
+            return 1;
+        }
+        
+        // Both are in sequence order. The live sidecar may start before a snapshot
+        // or stop short of the journal after a crash; only the overlap is compared.
+        size_t compared = 0;
+        auto live = expected.begin();
+        for (const ResultDigest& replayed : digests) {
+            while (live != expected.end() && live->sequence < replayed.sequence) {
+                ++live;
+            }
+            if (live == expected.end()) {
+                break;
+            }
+            if (live->sequence != replayed.sequence) {
+                continue;
+            }
+            if (live->digest != replayed.digest) {
+                std::cout << "VERIFY FAILED at sequence " << replayed.sequence << "\n";
+                return 1;
+            }
+            ++compared;
+        }
+        
+        if (compared == 0 && !digests.empty()) {
+            std::cout << "VERIFY FAILED: no recorded results for sequences " << digests.front().sequence 
+                      << ".." << digests.back().sequence << "\n";
+            return 1;
+        }
+        std::cout << "Verified " << compared << " of " << digests.size() << " results against " 
+                  << options.verify_path << "\n";
+    }
+    
+    return 0;
+}
\ No newline at end of file